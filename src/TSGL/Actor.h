@@ -0,0 +1,264 @@
+/*
+ * Actor.h provides coroutine actors, which are resumed in batches on a TaskPool at every frame.
+ */
+
+#ifndef ACTOR_H_
+#define ACTOR_H_
+
+// Actors need C++20 coroutines; TSGL itself is C++11, so all of this is inline, and is only compiled into
+// programs built with -std=c++20 or later
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define TSGL_HAS_ACTORS 1
+
+#include "Canvas.h"           // For running the actors at every frame
+#include "TaskPool.h"         // For resuming the actors in parallel
+#include <chrono>             // For the time actors wait on
+#include <coroutine>          // For suspending and resuming actors
+#include <exception>          // For std::terminate
+#include <functional>         // For the conditions actors wait on
+#include <mutex>              // For spawning actors while others run
+#include <vector>             // For the actors
+
+namespace tsgl {
+
+class ActorScheduler;
+
+/*! \class Actor
+ *  \brief A coroutine that animates one entity, a frame at a time.
+ *  \details Any function that returns an Actor and uses <code>co_await</code> is an actor. It runs until it
+ *    awaits nextFrame(), delay() or until(), and is resumed by its ActorScheduler when what it waits for has
+ *    happened:
+ *  \code
+ *    Actor blinker(Circle * c) {
+ *        while (true) {
+ *            c->setColor(RED);
+ *            co_await delay(0.5);
+ *            c->setColor(BLUE);
+ *            co_await delay(0.5);
+ *        }
+ *    }
+ *    ...
+ *    scheduler.spawn(blinker(circle));
+ *  \endcode
+ *  \details An actor does not run until it is given to ActorScheduler::spawn(). Its state lives in a
+ *    coroutine frame of a few hundred bytes on the heap instead of on a thread's stack, so a program can run
+ *    hundreds of thousands of them.
+ *  \warning Actors are resumed on several threads at once, so ones that share data must lock it.
+ */
+class Actor {
+ public:
+    struct promise_type {
+        ActorScheduler * scheduler = nullptr;
+        double wakeTime = 0;                      // Time to resume at, on the scheduler's clock
+        std::function<bool()> condition;          // Must be true to resume, if set
+
+        Actor get_return_object() { return Actor(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+    typedef std::coroutine_handle<promise_type> Handle;
+
+    /*!
+     * \brief Takes over a coroutine; made by the compiler when an actor function is called.
+     */
+    explicit Actor(Handle h) : myHandle(h) {}
+
+    Actor(Actor&& other) noexcept : myHandle(other.myHandle) { other.myHandle = nullptr; }
+
+    Actor& operator=(Actor&& other) noexcept {
+        if (this != &other) {
+            if (myHandle) myHandle.destroy();
+            myHandle = other.myHandle;
+            other.myHandle = nullptr;
+        }
+        return *this;
+    }
+
+    /*!
+     * \brief Destroys an actor that was never spawned.
+     */
+    ~Actor() { if (myHandle) myHandle.destroy(); }
+
+    Actor(const Actor&) = delete;
+    Actor& operator=(const Actor&) = delete;
+ private:
+    friend class ActorScheduler;
+    Handle myHandle;
+
+    // Gives up the coroutine to a scheduler
+    Handle release() { Handle h = myHandle; myHandle = nullptr; return h; }
+};
+
+/*! \class ActorScheduler
+ *  \brief Runs Actors, resuming them in batches at frame boundaries.
+ *  \details Each tick() resumes every Actor whose wait is over, split up over TaskPool::global() with
+ *    parallelFor(), so a few threads run any number of actors. Once attached to a Canvas, the scheduler ticks
+ *    in the Canvas' frame step (see Canvas::setFrameStep()): everything the actors change in a tick shows up
+ *    together in the next frame, while the previous frame is swapped.
+ *  \details An actor waiting for a delay or a condition is checked once per tick, which costs a few
+ *    nanoseconds; waits are measured on a steady clock, and end on the first tick after they are over.
+ *  \note The scheduler owns the actors spawned on it, and destroys those that have not finished when it is
+ *    destroyed. It must be detached from its Canvas, or destroyed, before the Canvas is.
+ */
+class ActorScheduler {
+ private:
+    typedef std::chrono::steady_clock clock;
+
+    std::vector<Actor::Handle> myActors;
+    std::vector<Actor::Handle> mySpawned;         // Spawned since the last tick started
+    std::mutex mySpawnMutex;
+    clock::time_point myStart = clock::now();
+    double myTime = 0;                            // Seconds since construction, at the last tick
+    Canvas * myCanvas = nullptr;
+
+    // Resumes the actors whose wait is over; see tick()
+    void runTick() {
+        myTime = std::chrono::duration<double>(clock::now() - myStart).count();
+        {
+            std::lock_guard<std::mutex> lock(mySpawnMutex);
+            myActors.insert(myActors.end(), mySpawned.begin(), mySpawned.end());
+            mySpawned.clear();
+        }
+        double now = myTime;
+        Actor::Handle * actors = myActors.data();
+        TaskPool::global().parallelFor(0, myActors.size(), [actors, now](int first, int last) {
+            for (int i = first; i < last; i++) {
+                Actor::promise_type& p = actors[i].promise();
+                if (p.wakeTime > now || (p.condition && !p.condition()))
+                    continue;
+                p.condition = nullptr;
+                actors[i].resume();
+            }
+        }, TICK_GRAIN);
+        unsigned live = 0;
+        for (unsigned i = 0; i < myActors.size(); i++) {
+            if (myActors[i].done())
+                myActors[i].destroy();
+            else
+                myActors[live++] = myActors[i];
+        }
+        myActors.resize(live);
+    }
+ public:
+    // Actors resumed per task in tick()
+    static const int TICK_GRAIN = 256;
+
+    ActorScheduler() = default;
+
+    /*!
+     * \brief Detaches the scheduler and destroys the actors it still runs.
+     * \warning Must not be called from an actor; see detach().
+     */
+    ~ActorScheduler() {
+        detach();
+        for (Actor::Handle h : myActors) h.destroy();
+        for (Actor::Handle h : mySpawned) h.destroy();
+    }
+
+    ActorScheduler(const ActorScheduler&) = delete;
+    ActorScheduler& operator=(const ActorScheduler&) = delete;
+
+    /**
+     * \brief Runs the scheduler in a Canvas' frame step, so it ticks once per frame.
+     * \details Replaces the Canvas' frame step, if any.
+     * \param can The Canvas to tick with.
+     */
+    void attach(Canvas& can) {
+        detach();
+        myCanvas = &can;
+        can.setFrameStep([this](int) { runTick(); }, this);
+    }
+
+    /**
+     * \brief Stops ticking with the Canvas given to attach(), if any.
+     * \details Removes the Canvas' frame step only if it is still this scheduler's, so a step set on the
+     *   Canvas since attach() is left alone. Returns once the tick running, if any, is over.
+     * \warning Must not be called from an actor: it waits for the tick running that actor, which never ends.
+     */
+    void detach() {
+        if (myCanvas) myCanvas->clearFrameStep(this);
+        myCanvas = nullptr;
+    }
+
+    /**
+     * \brief Starts running an actor from the next tick on.
+     * \details May be called from any thread, including from within an actor.
+     * \param actor The Actor returned by calling an actor function.
+     */
+    void spawn(Actor actor) {
+        Actor::Handle h = actor.release();
+        if (!h) return;
+        h.promise().scheduler = this;
+        std::lock_guard<std::mutex> lock(mySpawnMutex);
+        mySpawned.push_back(h);
+    }
+
+    /**
+     * \brief Resumes every actor whose wait is over, and destroys those that finish.
+     * \details Call it yourself only while the scheduler is not attached; an attached scheduler already
+     *   ticks in its Canvas' frame step, and a second tick at the same time would resume actors twice.
+     */
+    void tick() {
+        if (myCanvas) {
+            TsglDebug("Cannot tick an ActorScheduler attached to a Canvas by hand.");
+            return;
+        }
+        runTick();
+    }
+
+    /*!
+     * \brief Accessor for the number of actors running, including those spawned since the last tick.
+     */
+    unsigned getSize() {
+        std::lock_guard<std::mutex> lock(mySpawnMutex);
+        return myActors.size() + mySpawned.size();
+    }
+
+    /*!
+     * \brief Accessor for the time of the last tick, in seconds since the scheduler was made.
+     */
+    double getTime() const { return myTime; }
+};
+
+/*! \struct ActorWait
+ *  \brief What an actor awaits; made by nextFrame(), delay() and until().
+ */
+struct ActorWait {
+    double seconds;
+    std::function<bool()> condition;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Actor::Handle h) {
+        Actor::promise_type& p = h.promise();
+        p.wakeTime = p.scheduler->getTime() + seconds;
+        p.condition = std::move(condition);
+    }
+    void await_resume() const noexcept {}
+};
+
+/*!
+ * \brief Suspends an actor until the next tick.
+ */
+inline ActorWait nextFrame() { return ActorWait{0, nullptr}; }
+
+/*!
+ * \brief Suspends an actor for a number of seconds.
+ */
+inline ActorWait delay(double seconds) { return ActorWait{seconds, nullptr}; }
+
+/*!
+ * \brief Suspends an actor until a condition is true at a tick.
+ * \details The condition is checked on the scheduler's threads, once per tick, so it must be safe to call
+ *   from any thread.
+ */
+inline ActorWait until(std::function<bool()> condition) { return ActorWait{0, std::move(condition)}; }
+
+}
+
+#endif
+#endif
+
+#endif /* ACTOR_H_ */
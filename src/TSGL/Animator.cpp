@@ -0,0 +1,242 @@
+#include "Animator.h"
+
+namespace tsgl {
+
+/*!
+ * \brief Adds a track.
+ * \param target Handle of the Drawable the track drives.
+ * \param property The property the track drives.
+ * \param keys Array of count Keyframes, in order of time.
+ * \param count The number of Keyframes; at least one.
+ * \param start The time the track starts, on the clock later passed to evaluate().
+ * \param loop Whether the track starts over after its last Keyframe, rather than ending.
+ * \return A Handle to the track, or a null Handle if the Keyframes are empty or out of order.
+ */
+Handle Animator::add(Handle target, AnimatedProperty property, const Keyframe keys[], int count, double start, bool loop) {
+    if (count < 1 || property >= ANIMATED_PROPERTIES) {
+        TsglDebug("An animation track needs at least one keyframe and a valid property.");
+        return Handle();
+    }
+    for (int i = 1; i < count; i++) {
+        if (keys[i].time < keys[i-1].time) {
+            TsglDebug("The keyframes of an animation track must be in order of time.");
+            return Handle();
+        }
+    }
+    myMutex.lock();
+    Track t;
+    t.target = target;
+    t.property = property;
+    t.loop = loop;
+    t.start = start;
+    t.firstKey = myKeyTimes.size();
+    t.numKeys = count;
+    t.currentKey = 0;
+    for (int i = 0; i < count; i++) {
+        myKeyTimes.push_back(keys[i].time);
+        myKeyValues.push_back(keys[i].value);
+        myKeyEasings.push_back(keys[i].easing);
+        myKeyBeziers.insert(myKeyBeziers.end(), keys[i].bezier, keys[i].bezier + 4);
+    }
+    Handle h = myHandles.push();
+    myTracks.push_back(t);
+    myMutex.unlock();
+    return h;
+}
+
+/*!
+ * \brief Removes a track, leaving its property at its current value.
+ * \details Does nothing if the Handle is stale.
+ * \param track A Handle returned by add().
+ */
+void Animator::remove(Handle track) {
+    myMutex.lock();
+    uint32_t index = myHandles.indexOf(track);
+    if (index != UINT32_MAX)
+        removeAt(index);
+    myMutex.unlock();
+}
+
+/*!
+ * \brief Whether a track is still running.
+ * \param track A Handle returned by add().
+ * \return False once the track has been removed, or has ended.
+ */
+bool Animator::contains(Handle track) {
+    myMutex.lock();
+    bool found = myHandles.contains(track);
+    myMutex.unlock();
+    return found;
+}
+
+/*!
+ * \brief Removes every track.
+ */
+void Animator::clear() {
+    myMutex.lock();
+    myHandles.clear();
+    myTracks.clear();
+    myKeyTimes.clear();
+    myKeyValues.clear();
+    myKeyEasings.clear();
+    myKeyBeziers.clear();
+    myDeadKeys = 0;
+    myMutex.unlock();
+}
+
+// Removes the track at an index by moving the last track into its place; myMutex must be held
+void Animator::removeAt(unsigned index) {
+    myDeadKeys += myTracks[index].numKeys;
+    myHandles.swapRemove(myHandles.handleAt(index));
+    myTracks[index] = myTracks.back();
+    myTracks.pop_back();
+    if (myDeadKeys > myKeyTimes.size() / 2)
+        compactKeys();
+}
+
+// Drops the keyframes of removed tracks from the arrays; myMutex must be held
+void Animator::compactKeys() {
+    unsigned next = 0;
+    for (unsigned i = 0; i < myTracks.size(); i++) {
+        Track& t = myTracks[i];
+        for (unsigned k = 0; k < t.numKeys; k++) {
+            myKeyTimes[next + k] = myKeyTimes[t.firstKey + k];
+            myKeyValues[next + k] = myKeyValues[t.firstKey + k];
+            myKeyEasings[next + k] = myKeyEasings[t.firstKey + k];
+            for (int b = 0; b < 4; b++)
+                myKeyBeziers[(next + k) * 4 + b] = myKeyBeziers[(t.firstKey + k) * 4 + b];
+        }
+        t.firstKey = next;
+        next += t.numKeys;
+    }
+    myKeyTimes.resize(next);
+    myKeyValues.resize(next);
+    myKeyEasings.resize(next);
+    myKeyBeziers.resize(next * 4);
+    myDeadKeys = 0;
+}
+
+/*!
+ * \brief Maps the fraction of time elapsed between two keyframes to the fraction of the change in value.
+ * \param u The fraction of time, from 0 to 1.
+ * \param easing The curve.
+ * \param bezier The control points of the curve, for EASE_BEZIER.
+ */
+float Animator::ease(float u, Easing easing, const float bezier[4]) {
+    switch (easing) {
+        case EASE_IN:
+            return u * u;
+        case EASE_OUT:
+            return u * (2 - u);
+        case EASE_IN_OUT:
+            return u * u * (3 - 2 * u);
+        case EASE_STEP:
+            return (u >= 1) ? 1 : 0;
+        case EASE_BEZIER: {
+            // Solve x(s) = u for the curve's parameter s with Newton's method, falling back on bisection
+            float x1 = bezier[0], y1 = bezier[1], x2 = bezier[2], y2 = bezier[3];
+            float s = u;
+            for (int i = 0; i < 6; i++) {
+                float r = 1 - s;
+                float x = 3 * r * r * s * x1 + 3 * r * s * s * x2 + s * s * s - u;
+                float dx = 3 * r * r * x1 + 6 * r * s * (x2 - x1) + 3 * s * s * (1 - x2);
+                if (std::fabs(x) < 1e-5f)
+                    break;
+                if (std::fabs(dx) < 1e-6f) {
+                    float lo = 0, hi = 1;
+                    s = u;
+                    for (int j = 0; j < 20; j++) {
+                        float rs = 1 - s;
+                        if (3 * rs * rs * s * x1 + 3 * rs * s * s * x2 + s * s * s < u) lo = s; else hi = s;
+                        s = (lo + hi) / 2;
+                    }
+                    break;
+                }
+                s -= x / dx;
+                s = (s < 0) ? 0 : (s > 1) ? 1 : s;
+            }
+            float r = 1 - s;
+            return 3 * r * r * s * y1 + 3 * r * s * s * y2 + s * s * s;
+        }
+        default:
+            return u;
+    }
+}
+
+// The value of a track at a time; done is set if a track that does not loop has reached its last keyframe
+float Animator::evaluateTrack(Track& track, double now, bool& done) {
+    const float* times = &myKeyTimes[track.firstKey];
+    const float* values = &myKeyValues[track.firstKey];
+    unsigned last = track.numKeys - 1;
+    float duration = times[last];
+    double t = now - track.start;
+    done = false;
+    if (t >= duration) {
+        if (!track.loop || duration <= 0) {
+            done = !track.loop;
+            return values[last];
+        }
+        t = std::fmod(t, (double) duration);
+    }
+    if (t <= times[0])
+        return values[0];
+    unsigned k = track.currentKey;
+    if (k > last || times[k] > t)
+        k = 0;
+    while (k < last && times[k + 1] <= t)
+        k++;
+    track.currentKey = k;
+    if (k == last)
+        return values[last];
+    float span = times[k + 1] - times[k];
+    float u = (span > 0) ? (t - times[k]) / span : 1;
+    unsigned next = track.firstKey + k + 1;
+    float e = ease(u, (Easing) myKeyEasings[next], &myKeyBeziers[next * 4]);
+    return values[k] + (values[k + 1] - values[k]) * e;
+}
+
+/*!
+ * \brief Evaluates every track at a time.
+ * \details Tracks are evaluated in parallel with OpenMP once there are more than EVALUATE_CHUNK of them.
+ *   Tracks whose target is no longer in <code>targets</code> are removed without being evaluated, and tracks that
+ *   reached their end are removed after giving their final value.
+ * \param now The time, on the clock the tracks' start times were given on.
+ * \param targets The table the tracks' targets were issued by.
+ * \param out Array to fill with the value of every track, sorted by target, so that all of a Drawable's
+ *   properties can be applied at once.
+ */
+void Animator::evaluate(double now, const HandleTable& targets, std::vector<AnimatedValue>& out) {
+    out.clear();
+    myMutex.lock();
+    for (unsigned i = 0; i < myTracks.size(); ) {
+        if (!targets.contains(myTracks[i].target))
+            removeAt(i);
+        else
+            i++;
+    }
+    int n = myTracks.size();
+    myValues.resize(n);
+    myDone.resize(n);
+    #pragma omp parallel for schedule(static, EVALUATE_CHUNK) if (n > EVALUATE_CHUNK)
+    for (int i = 0; i < n; i++) {
+        bool done;
+        myValues[i] = evaluateTrack(myTracks[i], now, done);
+        myDone[i] = done;
+    }
+    out.resize(n);
+    for (int i = 0; i < n; i++) {
+        out[i].target = myTracks[i].target;
+        out[i].property = myTracks[i].property;
+        out[i].value = myValues[i];
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        if (myDone[i])
+            removeAt(i);
+    }
+    myMutex.unlock();
+    std::sort(out.begin(), out.end(), [](const AnimatedValue& a, const AnimatedValue& b) {
+        return a.target.slot < b.target.slot;
+    });
+}
+
+}
@@ -0,0 +1,121 @@
+/*
+ * Animator.h provides keyframe animation tracks that the render thread evaluates every frame.
+ */
+
+#ifndef ANIMATOR_H_
+#define ANIMATOR_H_
+
+#include "Drawable.h"         // For the properties that tracks drive
+#include "HandleTable.h"      // For stable handles to tracks, and for checking their targets
+#include "InstrumentedMutex.h" // For locking the tracks
+#include <algorithm>          // For sorting the evaluated values
+#include <cmath>              // For looping tracks with fmod()
+#include <vector>             // For the track and keyframe arrays
+
+namespace tsgl {
+
+/*! \enum Easing
+ *  \brief The curve an animation track follows from one keyframe to the next.
+ */
+enum Easing {
+    EASE_LINEAR,        // Constant speed
+    EASE_IN,            // Starts slow
+    EASE_OUT,           // Ends slow
+    EASE_IN_OUT,        // Starts and ends slow
+    EASE_BEZIER,        // A cubic Bezier timing curve, as in CSS's cubic-bezier()
+    EASE_STEP           // Holds the previous value, then jumps
+};
+
+/*! \struct Keyframe
+ *  \brief The value an animation track reaches at a time, and how it gets there from the previous Keyframe.
+ */
+struct Keyframe {
+    float time;          // Seconds after the track starts
+    float value;
+    Easing easing;       // Curve from the previous Keyframe to this one
+    float bezier[4];     // x1, y1, x2 and y2 of the curve, for EASE_BEZIER
+
+    /*!
+     * \brief Constructs a Keyframe reached with one of the fixed curves.
+     */
+    Keyframe(float t, float v, Easing e = EASE_LINEAR) : time(t), value(v), easing(e) {
+        bezier[0] = bezier[1] = 0; bezier[2] = bezier[3] = 1;
+    }
+
+    /*!
+     * \brief Constructs a Keyframe reached along a cubic Bezier timing curve from (0,0) to (1,1).
+     * \details x1 and x2 must be between 0 and 1.
+     */
+    Keyframe(float t, float v, float x1, float y1, float x2, float y2) : time(t), value(v), easing(EASE_BEZIER) {
+        bezier[0] = x1; bezier[1] = y1; bezier[2] = x2; bezier[3] = y2;
+    }
+};
+
+/*! \struct AnimatedValue
+ *  \brief The value of one property of one Drawable, as evaluated by an Animator.
+ */
+struct AnimatedValue {
+    Handle target;
+    unsigned property;   // An AnimatedProperty
+    float value;
+};
+
+/*! \class Animator
+ *  \brief Holds keyframe animation tracks, and evaluates all of them at once.
+ *  \details Each track drives one AnimatedProperty of one Drawable, referred to by its Handle in a Canvas.
+ *    The keyframes of every track are kept one after another in flat arrays of times, values and curves, and
+ *    evaluate() computes every track's value at a given time in one pass, in parallel when there are many.
+ *  \details Tracks that are not looped are removed once they reach their last keyframe, and tracks whose
+ *    Drawable is no longer on the Canvas are removed the next time they are evaluated.
+ *  \note Canvas owns an Animator, and evaluates it on the render thread at the start of every frame; see
+ *    Canvas::animate().
+ */
+class Animator {
+ private:
+    struct Track {
+        Handle target;
+        unsigned property;
+        bool loop;
+        double start;                // Time the track started, on the same clock as evaluate()
+        unsigned firstKey, numKeys;
+        unsigned currentKey;         // Keyframe the last evaluation was after, to start the next search from
+    };
+
+    InstrumentedMutex myMutex{"Animator::mutex"};
+    HandleTable myHandles;
+    std::vector<Track> myTracks;
+    std::vector<float> myKeyTimes;
+    std::vector<float> myKeyValues;
+    std::vector<unsigned char> myKeyEasings;
+    std::vector<float> myKeyBeziers;   // Four per keyframe
+    unsigned myDeadKeys = 0;           // Keyframes of removed tracks, still in the arrays
+    std::vector<float> myValues;       // Value of each track, from the last evaluation
+    std::vector<unsigned char> myDone; // Whether each track reached its end in the last evaluation
+
+    static float ease(float u, Easing easing, const float bezier[4]);
+    float evaluateTrack(Track& track, double now, bool& done);
+    void removeAt(unsigned index);
+    void compactKeys();
+ public:
+    // Tracks per OpenMP chunk in evaluate()
+    static const int EVALUATE_CHUNK = 1024;
+
+    Handle add(Handle target, AnimatedProperty property, const Keyframe keys[], int count, double start, bool loop);
+
+    void remove(Handle track);
+
+    bool contains(Handle track);
+
+    void clear();
+
+    /*!
+     * \brief Accessor for the number of tracks.
+     */
+    unsigned getSize() { return myHandles.size(); }
+
+    void evaluate(double now, const HandleTable& targets, std::vector<AnimatedValue>& out);
+};
+
+}
+
+#endif /* ANIMATOR_H_ */
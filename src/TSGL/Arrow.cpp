@@ -601,7 +601,9 @@ void Arrow::setColor(ColorFloat c[]) {
             vertices[i*7 + 6] = c[1].A;
         }
     }
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -663,7 +665,10 @@ void Arrow::recalculateVertices() {
         outlineVertices[35] = e2.x + cross.x * -0.2; outlineVertices[36] = e2.y + cross.y * -0.2; outlineVertices[37] = e2.z + cross.z * -0.2;
         outlineVertices[42] = e2.x + cross.x *  0.2; outlineVertices[43] = e2.y + cross.y *  0.2; outlineVertices[44] = e2.z + cross.z *  0.2;
     }
+    invalidateTriangles();
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 }
\ No newline at end of file
@@ -23,6 +23,8 @@ Background::Background(GLint width, GLint height, const ColorFloat &clearColor)
     toClear = false;
     complete = false;
     newPixelsDrawn = true;
+    myRenderSignal = nullptr;
+    myProfiler = nullptr;
 
     pixelTextureBuffer = new uint8_t[myWidth * myHeight * 4];
     for (int i = 0; i < myWidth * myHeight * 4; ++i) {
@@ -146,6 +148,8 @@ void Background::draw() {
 
     glViewport(0,0,myWidth,myHeight);
 
+    {
+    TSGL_PROFILE_PHASE(myProfiler, PHASE_BACKGROUND_DRAWABLES);
     drawableMutex.lock();
     for (unsigned int i = 0; i < myDrawables->size(); i++)
     {
@@ -163,6 +167,7 @@ void Background::draw() {
     }
     myDrawables->clear();
     drawableMutex.unlock();
+    }
 
     // setting up texture shaders for both pixel drawing and post-blit render
     selectShaders(TEXTURE_SHADER_TYPE);
@@ -179,6 +184,8 @@ void Background::draw() {
     glClear(GL_DEPTH_BUFFER_BIT);
 
     // check for new pixels being drawn
+    {
+    TSGL_PROFILE_PHASE(myProfiler, PHASE_PIXEL_UPLOAD);
     pixelBufferMutex.lock();
     if (newPixelsDrawn) {
         glBindTexture(GL_TEXTURE_2D, pixelTexture);
@@ -198,11 +205,15 @@ void Background::draw() {
         newPixelsDrawn = false;
     }
     pixelBufferMutex.unlock();
+    }
     
     // blit MSAA framebuffer to non-MSAA framebuffer's texture
+    {
+    TSGL_PROFILE_PHASE(myProfiler, PHASE_MSAA_RESOLVE);
     glBindFramebuffer(GL_READ_FRAMEBUFFER, multisampledFBO);
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, intermediateFBO);
     glBlitFramebuffer(0, 0, myWidth, myHeight, 0, 0, myWidth, myHeight, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
@@ -213,11 +224,14 @@ void Background::draw() {
     glBindTexture(GL_TEXTURE_2D,intermediateTexture);
 
     // read pixels into buffer for Background::getPixel()
+    {
+    TSGL_PROFILE_PHASE(myProfiler, PHASE_READBACK);
     readPixelMutex.lock();
     glPixelStorei(GL_PACK_ALIGNMENT, 1);
     glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, readPixelBuffer);
     // glPixelStorei(GL_PACK_ALIGNMENT, 4);
     readPixelMutex.unlock();
+    }
 
     // render non-MSAA framebuffer's texture to default framebuffer
     glPixelStorei(GL_UNPACK_ALIGNMENT,4);
@@ -254,11 +268,10 @@ void Background::selectShaders(unsigned int sType) {
         // position attribute
         GLint posAttrib = glGetAttribLocation(shapeShader->ID, "aPos");
         glEnableVertexAttribArray(posAttrib);
-        glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)0);
-        // texture coord attribute
+        // color attribute
         GLint colAttrib = glGetAttribLocation(shapeShader->ID, "aColor");
         glEnableVertexAttribArray(colAttrib);
-        glVertexAttribPointer(colAttrib, 4, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(3 * sizeof(float)));
+        VertexFormat::setLayout(posAttrib, colAttrib);
         program->use();
     } else if (sType == TEXTURE_SHADER_TYPE) {
         program = textureShader;
@@ -300,6 +313,7 @@ void Background::drawArrow(float x, float y, float z, float length, float width,
     drawableMutex.lock();
     myDrawables->push(a);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws an Arrow to the Background.
@@ -321,6 +335,7 @@ void Background::drawArrow(float x, float y, float z, float length, float width,
     drawableMutex.lock();
     myDrawables->push(a);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a Circle to the Background.
@@ -341,6 +356,7 @@ void Background::drawCircle(float x, float y, float z, float radius, float yaw,
     drawableMutex.lock();
     myDrawables->push(c);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a Circle to the Background.
@@ -361,6 +377,7 @@ void Background::drawCircle(float x, float y, float z, float radius, float yaw,
     drawableMutex.lock();
     myDrawables->push(c);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a ConcavePolygon to the Background.
@@ -384,6 +401,7 @@ void Background::drawConcavePolygon(float centerX, float centerY, float centerZ,
     drawableMutex.lock();
     myDrawables->push(c);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a ConcavePolygon to the Background.
@@ -407,6 +425,7 @@ void Background::drawConcavePolygon(float centerX, float centerY, float centerZ,
     drawableMutex.lock();
     myDrawables->push(c);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a ConvexPolygon to the Background.
@@ -429,6 +448,7 @@ void Background::drawConvexPolygon(float centerX, float centerY, float centerZ,
     drawableMutex.lock();
     myDrawables->push(c);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a ConvexPolygon to the Background.
@@ -451,6 +471,7 @@ void Background::drawConvexPolygon(float centerX, float centerY, float centerZ,
     drawableMutex.lock();
     myDrawables->push(c);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws an Ellipse to the Background.
@@ -472,6 +493,7 @@ void Background::drawEllipse(float x, float y, float z, float xRadius, float yRa
     drawableMutex.lock();
     myDrawables->push(e);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws an Ellipse to the Background.
@@ -493,6 +515,7 @@ void Background::drawEllipse(float x, float y, float z, float xRadius, float yRa
     drawableMutex.lock();
     myDrawables->push(e);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws an Image to the Background.
@@ -511,6 +534,7 @@ void Background::drawImage(float x, float y, float z, std::string filename, floa
     drawableMutex.lock();
     myDrawables->push(i);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!
@@ -532,6 +556,7 @@ void Background::drawLine(float x1, float y1, float z1, float x2, float y2, floa
     drawableMutex.lock();
     myDrawables->push(l);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!
@@ -553,6 +578,7 @@ void Background::drawLine(float x1, float y1, float z1, float x2, float y2, floa
     drawableMutex.lock();
     myDrawables->push(l);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a Line to the Background.
@@ -571,6 +597,7 @@ void Background::drawLine(float x, float y, float z, float length, float yaw, fl
     drawableMutex.lock();
     myDrawables->push(l);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a Line to the Background.
@@ -589,6 +616,7 @@ void Background::drawLine(float x, float y, float z, float length, float yaw, fl
     drawableMutex.lock();
     myDrawables->push(l);
     drawableMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -636,6 +664,7 @@ void Background::drawPixel(float x, float y, ColorInt c) {
 
     newPixelsDrawn = true;
     pixelBufferMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a Polyline to the Background.
@@ -655,6 +684,7 @@ void Background::drawPolyline(float x, float y, float z, int numVertices, float
     drawableMutex.lock();
     myDrawables->push(p);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a Polyline to the Background.
@@ -674,6 +704,7 @@ void Background::drawPolyline(float x, float y, float z, int numVertices, float
     drawableMutex.lock();
     myDrawables->push(p);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a Rectangle to the Background.
@@ -695,6 +726,7 @@ void Background::drawRectangle(float x, float y, float z, float width, float hei
     drawableMutex.lock();
     myDrawables->push(r);
     drawableMutex.unlock();
+    markDirty();
 }
 /*!\brief Procedurally draws a Rectangle to the Background.
  * \details Initializes a new Rectangle based on the parameter values, and then adds it to the Array of Drawables to be rendered.
@@ -715,6 +747,7 @@ void Background::drawRectangle(float x, float y, float z, float width, float hei
     drawableMutex.lock();
     myDrawables->push(r);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a RegularPolygon to the Background.
@@ -736,6 +769,7 @@ void Background::drawRegularPolygon(float x, float y, float z, float radius, int
     drawableMutex.lock();
     myDrawables->push(r);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a RegularPolygon to the Background.
@@ -757,6 +791,7 @@ void Background::drawRegularPolygon(float x, float y, float z, float radius, int
     drawableMutex.lock();
     myDrawables->push(r);
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a Square to the Background.
@@ -777,6 +812,7 @@ void Background::drawSquare(float x, float y, float z, float sidelength, float y
     drawableMutex.lock();
     myDrawables->push(s);  // Push it onto our drawing buffer
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a Square to the Background.
@@ -797,6 +833,7 @@ void Background::drawSquare(float x, float y, float z, float sidelength, float y
     drawableMutex.lock();
     myDrawables->push(s);  // Push it onto our drawing buffer
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a Star to the Background.
@@ -818,7 +855,8 @@ void Background::drawStar(float x, float y, float z, float radius, int points, f
     s->setIsOutlined(outlined);
     drawableMutex.lock();
     myDrawables->push(s);  // Push it onto our drawing buffer
-    drawableMutex.unlock();   
+    drawableMutex.unlock();
+    markDirty();   
 }
 
 /*!\brief Procedurally draws a Star to the Background.
@@ -840,7 +878,8 @@ void Background::drawStar(float x, float y, float z, float radius, int points, f
     s->setIsOutlined(outlined);
     drawableMutex.lock();
     myDrawables->push(s);  // Push it onto our drawing buffer
-    drawableMutex.unlock();   
+    drawableMutex.unlock();
+    markDirty();   
 }
 
 /*!\brief Procedurally draws Text to the Background.
@@ -880,6 +919,7 @@ void Background::drawText(float x, float y, float z, std::wstring text, std::str
     drawableMutex.lock();
     myDrawables->push(t);  // Push it onto our drawing buffer
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a Triangle to the Background.
@@ -905,6 +945,7 @@ void Background::drawTriangle(float x1, float y1, float z1, float x2, float y2,
     drawableMutex.lock();
     myDrawables->push(t);  // Push it onto our drawing buffer
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a Triangle to the Background.
@@ -930,6 +971,7 @@ void Background::drawTriangle(float x1, float y1, float z1, float x2, float y2,
     drawableMutex.lock();
     myDrawables->push(t);  // Push it onto our drawing buffer
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a TriangleStrip to the Background.
@@ -953,6 +995,7 @@ void Background::drawTriangleStrip(float centerX, float centerY, float centerZ,
     drawableMutex.lock();
     myDrawables->push(t);  // Push it onto our drawing buffer
     drawableMutex.unlock();
+    markDirty();
 }
 
 /*!\brief Procedurally draws a TriangleStrip to the Background.
@@ -976,6 +1019,7 @@ void Background::drawTriangleStrip(float centerX, float centerY, float centerZ,
     drawableMutex.lock();
     myDrawables->push(t);  // Push it onto our drawing buffer
     drawableMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -1008,6 +1052,7 @@ void Background::setClearColor(ColorFloat c) {
     baseColor = c;
     glClearColor(baseColor.R, baseColor.G, baseColor.B, baseColor.A);
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
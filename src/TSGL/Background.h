@@ -6,6 +6,9 @@
 #define BACKGROUND_H_
 
 #include "Camera.h"
+#include "FrameProfiler.h"  // For timing the phases of Background::draw()
+#include "InstrumentedMutex.h" // For reporting contention on the Background's mutexes
+#include "RenderSignal.h"   // For telling the Canvas that the Background changed
 
 #include "Array.h"          // Our own array for buffering drawing operations
 #include "Arrow.h"
@@ -52,21 +55,29 @@ protected:
     ColorFloat baseColor;
     bool toClear;
 
-    std::mutex readPixelMutex;
+    InstrumentedMutex readPixelMutex{"Background::readPixelMutex"};
     uint8_t* readPixelBuffer;
 
-    std::mutex pixelBufferMutex;
+    InstrumentedMutex pixelBufferMutex{"Background::pixelBufferMutex"};
     GLuint pixelTexture;
     uint8_t* pixelTextureBuffer;
     bool newPixelsDrawn;
 
     bool complete;
-    std::mutex attribMutex;
-    std::mutex drawableMutex;
+    InstrumentedMutex attribMutex{"Background::attribMutex"};
+    InstrumentedMutex drawableMutex{"Background::drawableMutex"};
   
     GLfloat * vertices;
 
+    RenderSignal * myRenderSignal;
+    FrameProfiler * myProfiler;
+
     virtual void selectShaders(unsigned int sType);
+
+    /*!
+     * \brief Tells the owning Canvas that the Background has changed and needs to be redrawn.
+     */
+    void markDirty() { if (myRenderSignal) myRenderSignal->markDirty(); }
 public:
     Background(GLint width, GLint height, const ColorFloat &c = WHITE);
 
@@ -74,7 +85,7 @@ public:
 
     virtual bool isInitialized() { return complete; }
 
-    virtual void clear() { attribMutex.lock(); toClear = true; attribMutex.unlock(); }
+    virtual void clear() { attribMutex.lock(); toClear = true; attribMutex.unlock(); markDirty(); }
 
     virtual void draw(); 
 
@@ -164,6 +175,20 @@ public:
 
     virtual void setClearColor(ColorFloat c);
 
+    /*!
+    * \brief Mutator for the RenderSignal notified when the Background changes.
+    * \details Called by the Canvas that draws this Background; there is no need to call this directly.
+    * \param signal Pointer to the RenderSignal of the owning Canvas, or nullptr.
+    */
+    virtual void setRenderSignal(RenderSignal * signal) { myRenderSignal = signal; }
+
+    /*!
+    * \brief Mutator for the FrameProfiler that times the phases of draw().
+    * \details Called by the Canvas that draws this Background; there is no need to call this directly.
+    * \param profiler Pointer to the FrameProfiler of the owning Canvas, or nullptr.
+    */
+    virtual void setProfiler(FrameProfiler * profiler) { myProfiler = profiler; }
+
     virtual ~Background();
 };
 
@@ -149,6 +149,7 @@ void Camera::changeXBy(float delta) {
     attribMutex.lock();
     myPosition += glm::vec3(delta,0.0f,0.0f);
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -160,6 +161,7 @@ void Camera::changeYBy(float delta) {
     attribMutex.lock();
     myPosition += glm::vec3(0.0f,delta,0.0f);
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -171,6 +173,7 @@ void Camera::changeZBy(float delta) {
     attribMutex.lock();
     myPosition += glm::vec3(0.0f,0.0f,delta);
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -182,6 +185,7 @@ void Camera::moveBackward(float delta) {
     attribMutex.lock();
     myPosition -= myFront * delta;
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -193,6 +197,7 @@ void Camera::moveForward(float delta) {
     attribMutex.lock();
     myPosition += myFront * delta;
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -204,6 +209,7 @@ void Camera::moveDown(float delta) {
     attribMutex.lock();
     myPosition -= myUp * delta;
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -215,6 +221,7 @@ void Camera::moveUp(float delta) {
     attribMutex.lock();
     myPosition += myUp * delta;
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -226,6 +233,7 @@ void Camera::moveLeft(float delta) {
     attribMutex.lock();
     myPosition -= myRight * delta;
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -237,6 +245,7 @@ void Camera::moveRight(float delta) {
     attribMutex.lock();
     myPosition += myRight * delta;
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -248,6 +257,7 @@ void Camera::setPosition(glm::vec3 pos) {
     attribMutex.lock();
     myPosition = pos;
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -261,6 +271,7 @@ void Camera::setPosition(float x, float y, float z) {
     attribMutex.lock();
     myPosition = glm::vec3(x,y,z);
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -272,6 +283,7 @@ void Camera::setPositionX(float x) {
     attribMutex.lock();
     myPosition.x = x;
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -283,6 +295,7 @@ void Camera::setPositionY(float y) {
     attribMutex.lock();
     myPosition.y = y;
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -294,6 +307,7 @@ void Camera::setPositionZ(float z) {
     attribMutex.lock();
     myPosition.z = z;
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -321,6 +335,7 @@ void Camera::lookAt(float x, float y, float z) {
         myYaw = -glm::degrees( acos(myFront.x / cos(glm::radians(myPitch))) );
     }
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
@@ -333,6 +348,7 @@ void Camera::changeYawBy(float delta) {
     myYaw += delta;
     updateCameraAngle();
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
@@ -350,6 +366,7 @@ void Camera::changePitchBy(float delta) {
         myPitch = -89.0f;
     updateCameraAngle();
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
@@ -9,6 +9,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <mutex>
+#include "RenderSignal.h"   // For telling the Canvas that the view changed
 #include "Util.h"           // Needed constants and has cmath for performing math operations
 
 namespace tsgl {
@@ -30,7 +31,14 @@ protected:
 
     std::mutex attribMutex;
 
+    RenderSignal * myRenderSignal = nullptr;
+
     void updateCameraAngle();
+
+    /*!
+     * \brief Tells the owning Canvas that the Camera has moved and the scene needs to be redrawn.
+     */
+    void markDirty() { if (myRenderSignal) myRenderSignal->markDirty(); }
 public:
     Camera(glm::vec3 position, glm::vec3 up, glm::vec3 target);
 
@@ -99,6 +107,13 @@ public:
     float getTargetY();
 
     float getTargetZ();
+
+    /*!
+     * \brief Mutator for the RenderSignal notified when the Camera moves.
+     * \details Called by the Canvas that owns this Camera; there is no need to call this directly.
+     * \param signal Pointer to the RenderSignal of the owning Canvas, or nullptr.
+     */
+    void setRenderSignal(RenderSignal * signal) { myRenderSignal = signal; }
 };
 
 }
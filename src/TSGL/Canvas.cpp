@@ -21,12 +21,14 @@ static const GLchar* shapeVertexShader =
   "#version 330 core\n"
   "layout (location = 0) in vec3 aPos;"
   "layout (location = 1) in vec4 aColor;"
+  "layout (location = 2) in float aSize;"   // Only read while GL_PROGRAM_POINT_SIZE is enabled (PointCloud)
   "out vec4 color;"
   "uniform mat4 projection;"
   "uniform mat4 view;"
   "uniform mat4 model;"
   "void main() {"
   "gl_Position = projection * view * model * vec4(aPos, 1.0);"
+  "gl_PointSize = aSize;"
 	"color = aColor;"
   "}";
 
@@ -38,6 +40,33 @@ static const GLchar* shapeFragmentShader =
 	"FragColor = color;"
   "}";
 
+static const GLchar* instanceVertexShader =
+  "#version 330 core\n"
+  "layout (location = 0) in vec3 aPos;"
+  "layout (location = 3) in float aX;"
+  "layout (location = 4) in float aY;"
+  "layout (location = 5) in float aZ;"
+  "layout (location = 6) in float aYaw;"
+  "layout (location = 7) in float aPitch;"
+  "layout (location = 8) in float aRoll;"
+  "layout (location = 9) in float aScale;"
+  "layout (location = 10) in vec4 aColor;"
+  "layout (location = 11) in float aVisible;"
+  "out vec4 color;"
+  "uniform mat4 projection;"
+  "uniform mat4 view;"
+  "uniform mat4 model;"
+  "void main() {"
+  "vec3 c = cos(radians(vec3(aYaw, aPitch, aRoll)));"
+  "vec3 s = sin(radians(vec3(aYaw, aPitch, aRoll)));"
+  "mat3 yaw = mat3(c.x, s.x, 0.0, -s.x, c.x, 0.0, 0.0, 0.0, 1.0);"
+  "mat3 pitch = mat3(c.y, 0.0, -s.y, 0.0, 1.0, 0.0, s.y, 0.0, c.y);"
+  "mat3 roll = mat3(1.0, 0.0, 0.0, 0.0, c.z, s.z, 0.0, -s.z, c.z);"
+  "vec3 p = vec3(aX, aY, aZ) + yaw * pitch * roll * (aPos * aScale);"
+  "gl_Position = aVisible > 0.5 ? projection * view * model * vec4(p, 1.0) : vec4(0.0, 0.0, 2.0, 1.0);"  // Hidden instances are clipped
+  "color = aColor;"
+  "}";
+
 static const GLchar* textVertexShader =
   "#version 330 core\n"
   "layout (location = 0) in vec3 aPos;"
@@ -86,6 +115,10 @@ static const GLchar* textureFragmentShader =
 	"FragColor = texture(texture1, TexCoords) * vec4(1.0,1.0,1.0,alpha);"
   "}";
 
+// Drawables per OpenMP chunk in setPoses() and changeCentersBy(); enough that each thread works on whole cache lines
+// of the caller's arrays, few enough that the chunks spread over every thread
+static const int BULK_UPDATE_CHUNK = 1024;
+
 bool Canvas::glfwIsReady = false;
 std::mutex Canvas::glfwMutex;
 GLFWvidmode const* Canvas::monInfo;
@@ -129,7 +162,12 @@ Canvas::~Canvas() {
     // Free our pointer memory
     delete drawTimer;
     delete camera;
+    delete profiler;
     delete [] screenBuffer;
+    for (unsigned i = 0; i < objectBuffer.size(); i++) {
+      if (objectSizes[i] > 0)
+        destroyPooled(objectBuffer[i], objectSizes[i]);
+    }
     if (defaultBackground) {
       delete myBackground;
     }
@@ -139,6 +177,24 @@ Canvas::~Canvas() {
     }
 }
 
+ /*!
+  * \brief Opens an update transaction.
+  * \details Every change made to the Canvas' Drawables between this call and the matching endFrameUpdate()
+  *   shows up in the same frame: the rendering thread does not start a frame while any transaction is open,
+  *   and this call waits for the frame being drawn, if any, to finish.
+  * \details Any number of threads may have transactions open at once, and transactions may be nested. Once the
+  *   rendering thread is waiting to draw, new transactions wait for that frame, except those nested in one the
+  *   calling thread already has open. Waiting is done on a condition variable, so threads blocked here or in the rendering thread use no CPU,
+  *   and this works with threads from any threading library.
+  * \warning Do not call this without later calling endFrameUpdate(), or the Canvas stops drawing; FrameUpdate
+  *   does so automatically. Do not wait for the next frame (e.g. with sleep()), or for another thread's
+  *   transaction, while a transaction is open.
+  * \see endFrameUpdate(), FrameUpdate
+  */
+void Canvas::beginFrameUpdate() {
+    frameGate.beginUpdate();
+}
+
  /*!
   * \brief Binds a key or button to a function.
   * \details This function binds a key or mouse button to a function pointer.
@@ -178,6 +234,7 @@ void Canvas::clearBackground() {
   backgroundMutex.lock();
   myBackground->clear();
   backgroundMutex.unlock();
+  renderSignal.markDirty();
 }
 
  /*!
@@ -199,42 +256,268 @@ void Canvas::close() {
 /**
  * \brief Adds a Drawable to the Canvas.
  * \details Adds the parameter drawable to objectBuffer.
+ * \details Adding a Drawable that is already on the Canvas does nothing.
  *    \param shapePtr Pointer to the Drawable to add to this Canvas.
+ * \return A Handle to the Drawable, for remove() and get(). The Handle becomes stale once the Drawable is removed.
  */
-void Canvas::add(Drawable * shapePtr) {
+Handle Canvas::add(Drawable * shapePtr) {
+  return addObject(shapePtr, 0);
+}
+
+Handle Canvas::addObject(Drawable * shapePtr, size_t pooledBytes) {
   objectMutex.lock();
-  objectBuffer.push_back(shapePtr);
+  Handle h = shapePtr->getCanvasHandle();
+  uint32_t index = objectHandles.indexOf(h);
+  if (index == UINT32_MAX || objectBuffer[index] != shapePtr) {
+    h = objectHandles.push();
+    objectBuffer.push_back(shapePtr);
+    objectSizes.push_back(pooledBytes);
+    drawOrderStale = true;
+    shapePtr->setCanvasHandle(h);
+    shapePtr->setRenderSignal(&renderSignal);
+  }
   objectMutex.unlock();
+  renderSignal.markDirty();
+  return h;
+}
+
+/**
+ * \brief Whether a Handle still refers to a Drawable on the Canvas.
+ *    \param h A Handle returned by add() or emplace().
+ * \return False if the Drawable has since been removed.
+ */
+bool Canvas::contains(Handle h) {
+  objectMutex.lock();
+  bool found = objectHandles.contains(h);
+  objectMutex.unlock();
+  return found;
+}
+
+/**
+ * \brief Accessor for a Drawable on the Canvas.
+ *    \param h A Handle returned by add() or emplace().
+ * \return A pointer to the Drawable, or NULL if the Handle is stale.
+ * \warning The pointer is only valid until the Drawable is removed.
+ */
+Drawable * Canvas::get(Handle h) {
+  objectMutex.lock();
+  uint32_t index = objectHandles.indexOf(h);
+  Drawable * d = (index == UINT32_MAX) ? NULL : objectBuffer[index];
+  objectMutex.unlock();
+  return d;
 }
 
 /**
  * \brief Removes a Drawable from the Canvas.
- * \details Removes shapePtr from the Canvas's drawing buffer.
+ * \details Removes shapePtr from the Canvas's drawing buffer in constant time, by moving the last object into its place.
+ * \details Removing a Drawable that is not on the Canvas does nothing.
  *    \param shapePtr Pointer to the Drawable to remove from this Canvas.
  * \warning The Drawable being deleted or going out of scope before remove() is called will cause a segmentation fault.
- * \warning If shapePtr is not in the drawing buffer, behavior is undefined.
+ * \warning Drawables made with emplace() are destroyed by remove().
  */
 void Canvas::remove(Drawable * shapePtr) {
   objectMutex.lock();
-  objectBuffer.erase(std::remove(objectBuffer.begin(), objectBuffer.end(), shapePtr), objectBuffer.end());
+  uint32_t index = objectHandles.indexOf(shapePtr->getCanvasHandle());
+  if (index == UINT32_MAX || objectBuffer[index] != shapePtr) {
+    // The Drawable was added to another Canvas since it was added to this one, so its Handle is not ours
+    index = std::find(objectBuffer.begin(), objectBuffer.end(), shapePtr) - objectBuffer.begin();
+  }
+  if (index < objectBuffer.size())
+    removeObjectAt(index);
   objectMutex.unlock();
+  renderSignal.markDirty();
+}
+
+/**
+ * \brief Removes a Drawable from the Canvas by its Handle.
+ * \details Takes constant time. Removing with a stale Handle does nothing.
+ *    \param h A Handle returned by add() or emplace().
+ * \warning Drawables made with emplace() are destroyed by remove().
+ */
+void Canvas::remove(Handle h) {
+  objectMutex.lock();
+  uint32_t index = objectHandles.indexOf(h);
+  if (index != UINT32_MAX)
+    removeObjectAt(index);
+  objectMutex.unlock();
+  renderSignal.markDirty();
+}
+
+void Canvas::removeObjectAt(uint32_t index) {
+  Drawable * d = objectBuffer[index];
+  size_t pooledBytes = objectSizes[index];
+  Handle h = objectHandles.handleAt(index);
+  if (d->getCanvasHandle() == h)
+    d->setCanvasHandle(Handle());
+  objectHandles.swapRemove(h);
+  objectBuffer[index] = objectBuffer.back();
+  objectSizes[index] = objectSizes.back();
+  objectBuffer.pop_back();
+  objectSizes.pop_back();
+  drawOrderStale = true;
+  d->setRenderSignal(nullptr);
+  if (pooledBytes > 0)
+    destroyPooled(d, pooledBytes);
+}
+
+void Canvas::destroyPooled(Drawable * shapePtr, size_t pooledBytes) {
+  shapePtr->~Drawable();
+  objectPool.deallocate(shapePtr, pooledBytes);
 }
 
 /**
  * \brief Removes all Drawables from the Canvas.
- * \details Clears all Drawables from the drawing buffer.
+ * \details Clears all Drawables from the drawing buffer. Every Handle to them becomes stale.
+ * \details Drawables made with emplace() are always destroyed.
  *    \param shouldFreeMemory Whether the pointers will be deleted as well as removed and free their memory. (Defaults to false.)
  * \warning Setting shouldFreeMemory to true will cause a segmentation fault if the user continues to access the pointer to a
  *  Drawable that has been added to the Canvas.
  * \warning Setting shouldFreeMemory to false will leak memory from any objects created in Canvas draw methods.
  */
 void Canvas::clearObjectBuffer(bool shouldFreeMemory) {
-  if( shouldFreeMemory ) {
-    for(unsigned i = 0; i < objectBuffer.size(); i++) {
-      delete objectBuffer[i]; //TODO fix this, causes to crash
+  objectMutex.lock();
+  for (unsigned i = 0; i < objectBuffer.size(); i++) {
+    if (objectSizes[i] > 0) {
+      destroyPooled(objectBuffer[i], objectSizes[i]);
+    } else if (shouldFreeMemory) {
+      delete objectBuffer[i];
+    } else {
+      objectBuffer[i]->setRenderSignal(nullptr);
+      objectBuffer[i]->setCanvasHandle(Handle());
     }
   }
+  objectHandles.clear();
   objectBuffer.clear();
+  objectSizes.clear();
+  drawOrder.clear();
+  drawOrderStale = false;
+  objectMutex.unlock();
+  renderSignal.markDirty();
+}
+
+/**
+ * \brief Animates a property of a Drawable on the Canvas along keyframes.
+ * \details The render thread evaluates every track at the start of each frame and sets the property itself, so
+ *   motion follows the frame clock exactly and needs no thread of its own. Keyframe times are in seconds from now.
+ *   Before the first keyframe the property holds the first keyframe's value.
+ * \details A track that does not loop ends after its last keyframe, leaving the property at that value. Every
+ *   track of a Drawable ends when the Drawable is removed.
+ *    \param target A Handle returned by add() or emplace().
+ *    \param property The property to animate.
+ *    \param keys Array of count Keyframes, in order of time.
+ *    \param count The number of Keyframes; at least one.
+ *    \param loop Whether to start over after the last keyframe, forever. (Defaults to false.)
+ * \return A Handle to the track, for stopAnimation() and isAnimating(), or a null Handle if the target is not on
+ *   the Canvas or the keyframes are invalid.
+ * \note Color properties only apply to Shapes.
+ */
+Handle Canvas::animate(Handle target, AnimatedProperty property, const Keyframe keys[], int count, bool loop) {
+  if (!contains(target)) {
+    TsglDebug("Only Drawables on the Canvas can be animated.");
+    return Handle();
+  }
+  Handle track = animator.add(target, property, keys, count, drawTimer->getTime(), loop);
+  Drawable * d = get(target);
+  if (!track.isNull() && d)
+    d->startAnimation(property);
+  renderSignal.markDirty();
+  return track;
+}
+
+/**
+ * \brief Animates a property of a Drawable on the Canvas along keyframes.
+ * \details As animate() for Handles.
+ *    \param target Pointer to a Drawable that has been added to the Canvas.
+ */
+Handle Canvas::animate(Drawable * target, AnimatedProperty property, const Keyframe keys[], int count, bool loop) {
+  return animate(target->getCanvasHandle(), property, keys, count, loop);
+}
+
+/**
+ * \brief Whether an animation track is still running.
+ *    \param track A Handle returned by animate().
+ * \return False once the track has ended or been stopped.
+ */
+bool Canvas::isAnimating(Handle track) {
+  return animator.contains(track);
+}
+
+/**
+ * \brief Stops an animation track, leaving its property where it is.
+ *    \param track A Handle returned by animate().
+ */
+void Canvas::stopAnimation(Handle track) {
+  animator.remove(track);
+}
+
+void Canvas::applyAnimations() {
+  if (animator.getSize() == 0)
+    return;
+  TSGL_PROFILE_PHASE(profiler, PHASE_ANIMATION);
+  animator.evaluate(drawTimer->getTime(), objectHandles, animatedValues);
+  float values[ANIMATED_PROPERTIES];
+  for (unsigned i = 0; i < animatedValues.size(); ) {
+    Handle target = animatedValues[i].target;
+    unsigned mask = 0;
+    for (; i < animatedValues.size() && animatedValues[i].target == target; i++) {
+      values[animatedValues[i].property] = animatedValues[i].value;
+      mask |= 1 << animatedValues[i].property;
+    }
+    objectBuffer[objectHandles.indexOf(target)]->applyAnimation(values, mask);
+  }
+}
+
+/**
+ * \brief Moves and rotates many Drawables at once.
+ * \details The Drawables are updated in parallel with OpenMP, in chunks of consecutive array elements.
+ *   The render thread draws every object under the same lock that is held for the whole update, so a frame
+ *   shows either none of the new poses or all of them.
+ *   \param objects An array of count pointers to Drawables. The same Drawable must not appear twice.
+ *   \param poses An array of count Poses; <code>poses[i]</code> is given to <code>objects[i]</code>.
+ *   \param count The number of Drawables.
+ * \see Drawable::setPose()
+ */
+void Canvas::setPoses(Drawable * const objects[], const Pose poses[], int count) {
+  objectMutex.lock();
+  #pragma omp parallel for schedule(static, BULK_UPDATE_CHUNK) if (count > BULK_UPDATE_CHUNK)
+  for (int i = 0; i < count; i++)
+    objects[i]->setPose(poses[i]);
+  objectMutex.unlock();
+}
+
+/**
+ * \brief Moves many Drawables at once, each by its own offset.
+ * \details The Drawables are updated in parallel and published to the next frame together, as in setPoses().
+ *   \param objects An array of count pointers to Drawables. The same Drawable must not appear twice.
+ *   \param deltas An array of 3 * count floats, the x, y and z offsets of each Drawable in turn.
+ *   \param count The number of Drawables.
+ * \see Drawable::changeCenterBy()
+ */
+void Canvas::changeCentersBy(Drawable * const objects[], const float deltas[], int count) {
+  objectMutex.lock();
+  #pragma omp parallel for schedule(static, BULK_UPDATE_CHUNK) if (count > BULK_UPDATE_CHUNK)
+  for (int i = 0; i < count; i++)
+    objects[i]->changeCenterBy(deltas[i*3], deltas[i*3 + 1], deltas[i*3 + 2]);
+  objectMutex.unlock();
+}
+
+/**
+ * \brief Moves and rotates many Drawables at once, by their Handles.
+ * \details As setPoses() for pointers, except that stale Handles are skipped, so the Drawables may be removed
+ *   by other threads in the meantime.
+ *   \param handles An array of count Handles returned by add() or emplace(). The same Handle must not appear twice.
+ *   \param poses An array of count Poses; <code>poses[i]</code> is given to the Drawable of <code>handles[i]</code>.
+ *   \param count The number of Handles.
+ */
+void Canvas::setPoses(const Handle handles[], const Pose poses[], int count) {
+  objectMutex.lock();
+  #pragma omp parallel for schedule(static, BULK_UPDATE_CHUNK) if (count > BULK_UPDATE_CHUNK)
+  for (int i = 0; i < count; i++) {
+    uint32_t index = objectHandles.indexOf(handles[i]);
+    if (index != UINT32_MAX)
+      objectBuffer[index]->setPose(poses[i]);
+  }
+  objectMutex.unlock();
 }
 
 void Canvas::draw()
@@ -247,6 +530,7 @@ void Canvas::draw()
     windowMutex.unlock();
 
     bool captureScreen = false;
+    double lastStatsTime = 0.0;
 
     for (frameCounter = 0; !glfwWindowShouldClose(window); frameCounter++)
     {
@@ -255,18 +539,58 @@ void Canvas::draw()
           captureScreen = true;
           --toRecord;
         }
-        drawTimer->sleep(true);
 
-        syncMutex.lock();
+        frameStepMutex.lock();
+        bool step = (bool) frameStep;
+        frameStepMutex.unlock();
+
+        // Nothing has changed since the last frame: keep handling I/O, but don't redraw or swap.
+        // Wait until either the scene changes (then draw right away) or the next tick passes.
+        // With a frame step, every tick is drawn, so that the step keeps running.
+        if (!captureScreen && !renderSignal.isDirty() && !step) {
+        #ifdef __APPLE__
+          windowMutex.lock();
+          glfwGetCursorPos(window, &mouseX, &mouseY);
+          windowMutex.unlock();
+        #else
+          glfwPollEvents();                          // Handle any I/O
+          glfwGetCursorPos(window, &mouseX, &mouseY);
+        #endif
+          bool changed;
+          {
+            TSGL_PROFILE_PHASE(profiler, PHASE_TIMER_SLEEP);
+            changed = renderSignal.waitForDirty(drawTimer->getPeriod());
+          }
+          drawTimer->restartPeriod();
+          if (toClose) glfwSetWindowShouldClose(window, GL_TRUE);
+          if (!changed) continue;
+        } else {
+          TSGL_PROFILE_PHASE(profiler, PHASE_TIMER_SLEEP);
+          drawTimer->sleep(true);
+        }
+
+        TSGL_PROFILE_FRAME(profiler);
+        {
+          TSGL_PROFILE_PHASE(profiler, PHASE_SYNC_WAIT);
+          frameGate.beginFrame();
+        }
+        renderSignal.consume();                      // Anything changed from here on is drawn next frame
 
       #ifdef __APPLE__
         windowMutex.lock();
       #endif
         glfwMakeContextCurrent(window);
-
-        realFPS = round(1 / drawTimer->getTimeBetweenSleeps());
-        if (showFPS) std::cout << realFPS << "/" << FPS << std::endl;
-        std::cout.flush();
+        GpuBuffer::collectGarbage();                 // Free the buffers of meshes and Drawables destroyed since last frame
+
+        // Refresh the FPS from the median frame time about once a second rather than from a single frame
+        if (drawTimer->getTime() - lastStatsTime >= 1.0) {
+          lastStatsTime = drawTimer->getTime();
+          FrameTimeStats stats = drawTimer->getFrameTimeStats();
+          if (stats.p50 > 0) realFPS = round(1 / stats.p50);
+          if (showFPS)
+            std::cout << realFPS << "/" << FPS << " (p95 " << stats.p95 * 1000 << " ms, p99 " << stats.p99 * 1000
+                      << " ms, " << stats.missed << " missed)" << std::endl;
+        }
 
         // clear default framebuffer
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -285,9 +609,17 @@ void Canvas::draw()
         // winHeight = windowHeight;
 
         objectMutex.lock();
-        if (objectBuffer.size() > 0) {
+        applyAnimations();                           // Anything the tracks change is drawn this frame
+        if (drawOrderStale) {
+          // objectBuffer is reordered by removals, so draw from a copy that keeps last frame's order between changes
+          drawOrder = objectBuffer;
+          drawOrderStale = false;
+        }
+        if (drawOrder.size() > 0) {
           // sort between opaques and transparents and then sort by center z. depth buffer takes care of the rest. not perfect, but good.
-          std::stable_sort(objectBuffer.begin(), objectBuffer.end(), [this](Drawable * a, Drawable * b)->bool {
+          {
+          TSGL_PROFILE_PHASE(profiler, PHASE_OBJECT_SORT);
+          std::stable_sort(drawOrder.begin(), drawOrder.end(), [this](Drawable * a, Drawable * b)->bool {
             if (a->getAlpha() == 1.0 && b->getAlpha() != 1.0)
               return true;
             else if (a->getAlpha() != 1.0 && b->getAlpha() == 1.0)
@@ -296,9 +628,15 @@ void Canvas::draw()
               return (distanceBetween(a->getCenterX(), a->getCenterY(), a->getCenterZ(), camera->getPositionX(), camera->getPositionY(), camera->getPositionZ())
                     > distanceBetween(b->getCenterX(), b->getCenterY(), b->getCenterZ(), camera->getPositionX(), camera->getPositionY(), camera->getPositionZ()));
           });
-          for (unsigned int i = 0; i < objectBuffer.size(); i++) {
-            Drawable* d = objectBuffer[i];
+          }
+          TSGL_PROFILE_PHASE(profiler, PHASE_OBJECT_DRAW);
+          // Pixels spanned by one world unit at distance 1, for picking curved Shapes' levels of detail
+          glm::vec3 eye = camera->getPosition();
+          float pixelsPerUnit = winHeight / (2 * tan(glm::radians(30.0f)));
+          for (unsigned int i = 0; i < drawOrder.size(); i++) {
+            Drawable* d = drawOrder[i];
             if(d->isProcessed()) {
+              d->selectDetail(eye, pixelsPerUnit);
               selectShaders(d->getShaderType());
               if (d->getShaderType() == SHAPE_SHADER_TYPE) {
                 d->draw(shapeShader);
@@ -306,13 +644,31 @@ void Canvas::draw()
                 d->draw(textureShader);
               } else if (d->getShaderType() == TEXT_SHADER_TYPE) {
                 d->draw(textShader);
+              } else if (d->getShaderType() == INSTANCE_SHADER_TYPE) {
+                d->draw(instanceShader);
               }
             }
           }
         }
         objectMutex.unlock();
+        frameGate.endFrame();                        // The scene has been read; updates may go on while we swap
+
+        frameStepMutex.lock();
+        if (frameStep) {
+          // Prepare the next frame on the pool while this one is swapped; the next frame waits for it
+          frameGate.openUpdate();                    // Finished by the pool thread that runs the step
+          std::function<void(int)> function = frameStep;
+          int next = frameCounter + 1;
+          TaskPool::global().submit(frameStepTasks, [this, function, next]() {
+            frameGate.adoptUpdate();
+            function(next);
+            frameGate.endUpdate();
+          });
+        }
+        frameStepMutex.unlock();
 
         if (captureScreen) {
+          TSGL_PROFILE_PHASE(profiler, PHASE_CAPTURE);
           // Update our screenBuffer copy with the default framebuffer
           screenBufferMutex.lock();
           glViewport(0,0,framebufferWidth,framebufferHeight);
@@ -325,7 +681,11 @@ void Canvas::draw()
         }
 
         // Update Screen
-        glfwSwapBuffers(window);
+        {
+          TSGL_PROFILE_PHASE(profiler, PHASE_SWAP);
+          glfwSwapBuffers(window);
+        }
+        renderSignal.markDrawn();
 
       #ifndef __APPLE__
         glfwPollEvents();                            // Handle any I/O
@@ -336,10 +696,21 @@ void Canvas::draw()
         windowMutex.unlock();
       #endif
 
-        syncMutex.unlock();
-
         if (toClose) glfwSetWindowShouldClose(window, GL_TRUE);
     }
+
+    TaskPool::global().wait(frameStepTasks);         // The last step may still be changing the scene
+
+    // Free this context's copies of the shared meshes and Drawable buffers while the context still exists
+  #ifdef __APPLE__
+    windowMutex.lock();
+  #endif
+    glfwMakeContextCurrent(window);
+    GpuBuffer::releaseContext();
+    glfwMakeContextCurrent(NULL);
+  #ifdef __APPLE__
+    windowMutex.unlock();
+  #endif
 }
 
 //  /*!
@@ -358,6 +729,17 @@ void Canvas::draw()
 //     drawText(ws, x, y, size, color, fontFileName, rotation);
 // }
 
+ /*!
+  * \brief Closes an update transaction.
+  * \details Once every transaction is closed, the rendering thread may draw the next frame, which shows every
+  *   change made in them.
+  * \warning Do not call this without having first called beginFrameUpdate().
+  * \see beginFrameUpdate(), FrameUpdate
+  */
+void Canvas::endFrameUpdate() {
+    frameGate.endUpdate();
+}
+
 void Canvas::errorCallback(int error, const char* string) {
     fprintf(stderr, "%i: %s\n", error, string);
 }
@@ -398,7 +780,8 @@ int Canvas::getDisplayWidth() {
 
  /*!
   * \brief Accessor for the current frame number.
-  * \return The number of actual draw cycles / frames the Canvas has rendered so far.
+  * \return The number of draw cycles the Canvas has gone through so far.
+  * \note Draw cycles in which nothing changed are counted as well, even though they are not redrawn.
   * \see getReps()
   */
 int Canvas::getFrameNumber() {
@@ -413,6 +796,18 @@ float Canvas::getFPS() {
     return realFPS;
 }
 
+ /*!
+  * \brief Accessor for statistics about the Canvas' frame times.
+  * \details The statistics cover the intervals between the most recent frames paced by the Canvas' draw timer.
+  *   Frames skipped because nothing changed are not included.
+  * \return A FrameTimeStats with the mean, median, 95th and 99th percentile, and longest frame times in seconds,
+  *   as well as the number of frames that missed their deadline.
+  * \see setSpinThreshold(), setThrottled()
+  */
+FrameTimeStats Canvas::getFrameTimeStats() const {
+    return drawTimer->getFrameTimeStats();
+}
+
  /*!
   * \brief Accessor for the mouse's x-position.
   * \return The x coordinates of the mouse on the Canvas.
@@ -505,6 +900,7 @@ void Canvas::glDestroy() {
     delete textShader;
     delete shapeShader;
     delete textureShader;
+    delete instanceShader;
     glDeleteBuffers(1, &VBO);
     glDeleteVertexArrays(1, &VAO);
 }
@@ -551,8 +947,6 @@ void Canvas::init(int xx, int yy, int ww, int hh, std::string title, ColorFloat
     toClose = false;
     windowClosed = false;
     frameCounter = 0;
-    syncMutexLocked = 0;
-	  syncMutexOwner = -1;
 
     started = false;                  // We haven't started the window yet
     monitorX = xx;
@@ -567,7 +961,13 @@ void Canvas::init(int xx, int yy, int ww, int hh, std::string title, ColorFloat
     myBackground = nullptr;
 
     drawTimer = new Timer((timerLength > 0.0f) ? timerLength : FRAME);
+  #ifdef TSGL_PROFILE
+    profiler = new FrameProfiler();
+  #else
+    profiler = nullptr;
+  #endif
     camera = new Camera(glm::vec3(0.0f, 0.0f, (winHeight / 2) / tan(glm::pi<float>()/6)),glm::vec3(0.0f,1.0f,0.0f),glm::vec3(0.0f,0.0f,0.0f));
+    camera->setRenderSignal(&renderSignal);
 
     for (int i = 0; i <= GLFW_KEY_LAST * 2 + 1; i++)
         boundKeys[i++] = nullptr;
@@ -648,6 +1048,8 @@ void Canvas::initGlew() {
 
     textureShader = new Shader(textureVertexShader, textureFragmentShader);
 
+    instanceShader = new Shader(instanceVertexShader, shapeFragmentShader);
+
     // char buf[PATH_MAX]; /* PATH_MAX incudes the \0 so +1 is not required */
     // char *res = realpath(".", buf);
     // if (res) {
@@ -675,6 +1077,8 @@ void Canvas::initBackground(Background * background, ColorFloat bgcolor) {
       background->setClearColor(bgcolor);
     }
     myBackground->init(shapeShader, textShader, textureShader, camera, window);
+    myBackground->setRenderSignal(&renderSignal);
+    myBackground->setProfiler(profiler);
     backgroundMutex.unlock();
 }
 
@@ -724,6 +1128,7 @@ void Canvas::initWindow() {
     glfwSetMouseButtonCallback(window, buttonCallback);
     glfwSetKeyCallback(window, keyCallback);
     glfwSetScrollCallback(window, scrollCallback);
+    glfwSetWindowRefreshCallback(window, refreshCallback);
 
     // Scale to window size
     GLint windowWidth, windowHeight;
@@ -758,28 +1163,27 @@ void Canvas::keyCallback(GLFWwindow* window, int key, int scancode, int action,
     buttonCallback(window, key, action, mods);
 }
 
+ /*!
+  * \brief Tells the Canvas that its scene has changed.
+  * \details This function forces the Canvas to redraw on its next draw cycle.
+  * \details Drawables added to the Canvas, its Background, and its Camera already do this whenever
+  *   they are modified, so this function is only needed when something the Canvas cannot see has changed
+  *   (such as the contents of a custom Drawable).
+  * \note If nothing has changed since the last frame, the Canvas neither redraws nor swaps its buffers.
+  */
+void Canvas::markDirty() {
+    renderSignal.markDirty();
+}
+
  /*!
   * \brief Pauses the rendering thread of the Canvas
-  * \details This function forces the calling thread to wait until the Canvas finishes its draw cycle,
-  *   them prevents the Canvas from rendering further updates until resumeDrawing is called.
+  * \details Opens an update transaction; equivalent to beginFrameUpdate().
   * \note This method may be called from any number of threads, so long as a matching number of calls
   *   to resumeDrawing() are made.
-  * \warning <b>This function makes use of a mutex lock. Do not call this without later calling
-  *   resumeDrawing().</b>
-  * \see resumeDrawing()
+  * \see resumeDrawing(), beginFrameUpdate()
   */
 void Canvas::pauseDrawing() {
-  #pragma omp critical (pauseResume)
-  {
-  if (syncMutexLocked == 0 && syncMutexOwner == -1) {
-    syncMutex.lock();
-    syncMutexOwner = omp_get_thread_num();
-  }
-  #pragma omp critical (syncMutLock)
-  {
-    ++syncMutexLocked;
-  }
-  }
+    beginFrameUpdate();
 }
 
  /*!
@@ -808,30 +1212,13 @@ void Canvas::reset() {
 
  /*!
   * \brief Resumes the rendering thread of the Canvas
-  * \details This function should be called after pauseDrawing to let the Canvas' rendering thread
-  *   know that it may resume rendering.
+  * \details Closes an update transaction; equivalent to endFrameUpdate().
   * \note This method may be called from any number of threads, so long as a matching number of calls
   *   to pauseDrawing() are made.
-  * \warning <b>This function makes use of a mutex lock. Do not call this without having
-  *   first called pauseDrawing().</b>
-  * \see pauseDrawing()
+  * \see pauseDrawing(), endFrameUpdate()
   */
 void Canvas::resumeDrawing() {
-  #pragma omp critical (syncMutLock)
-  {
-    --syncMutexLocked;
-  }
-  #pragma omp critical (pauseResume)
-  {
-    if (syncMutexOwner == omp_get_thread_num()) {
-      while (syncMutexLocked > 0)
-        sleepFor(FRAME/2);
-      syncMutex.unlock();
-      syncMutexOwner = -1;
-    }
-  }
-  while (syncMutexOwner != -1)
-    sleepFor(FRAME/2);
+    endFrameUpdate();
 }
 
  /*!
@@ -968,6 +1355,11 @@ void Canvas::screenShot() {
     screenBufferMutex.unlock();
 }
 
+void Canvas::refreshCallback(GLFWwindow* window) {
+    Canvas* can = reinterpret_cast<Canvas*>(glfwGetWindowUserPointer(window));
+    can->renderSignal.markDirty();
+}
+
 void Canvas::scrollCallback(GLFWwindow* window, double xpos, double ypos) {
     Canvas* can = reinterpret_cast<Canvas*>(glfwGetWindowUserPointer(window));
     if (can->scrollFunction) can->scrollFunction(xpos, ypos);
@@ -983,14 +1375,21 @@ void Canvas::setBackground(Background * background, bool previouslySet) {
   backgroundMutex.lock();
   if (myBackground != background) {
     defaultBackground = false;
+    if (myBackground) {
+      myBackground->setRenderSignal(nullptr);
+      myBackground->setProfiler(nullptr);
+    }
     myBackground = background;
     if (!previouslySet) {
       windowMutex.lock();
       background->init(shapeShader, textShader, textureShader, camera, window);
       windowMutex.unlock();
     }
+    background->setRenderSignal(&renderSignal);
+    background->setProfiler(profiler);
   }
   backgroundMutex.unlock();
+  renderSignal.markDirty();
 }
 
  /*!
@@ -1011,14 +1410,79 @@ void Canvas::setBackgroundColor(ColorFloat color) {
     windowMutex.unlock();
 }
 
+ /*!
+  * \brief Mutator for the frame step, a function that prepares each frame while the previous one is shown.
+  * \details Once the rendering thread has read the scene for frame N, it runs the step for frame N+1 as a task
+  *   on TaskPool::global(), inside an update transaction (see beginFrameUpdate()), and swaps frame N's buffers
+  *   meanwhile. Frame N+1 is not drawn until the step returns, and shows everything it changed.
+  * \details The step can split its work up further with TaskPool::global().parallelFor().
+  * \details While a step is set, the Canvas draws on every tick rather than only when the scene changes.
+  * \details Returns once the previous step, if running, has returned, so whatever it uses may then be freed.
+  *   \param step Function called with the number of the frame to prepare, or an empty function to stop.
+  *   \param owner Whoever sets the step, so that only they remove it with clearFrameStep() (optional).
+  * \warning The step must not call sleep(), setFrameStep(), clearFrameStep(), or wait for the next frame in
+  *   any other way. Tasks it starts with parallelFor() already run inside its transaction, and must not open
+  *   transactions of their own.
+  */
+void Canvas::setFrameStep(std::function<void(int)> step, const void * owner) {
+    frameStepMutex.lock();
+    frameStep = step;
+    frameStepOwner = step ? owner : nullptr;
+    frameStepMutex.unlock();
+    TaskPool::global().wait(frameStepTasks);
+    renderSignal.markDirty();
+}
+
+ /*!
+  * \brief Removes the frame step, if it is still the one set by <code>owner</code>.
+  * \details Like setFrameStep(), returns once the step, if running, has returned.
+  *   \param owner The owner given to setFrameStep().
+  * \return True if the step was removed, false if another step (or none) had replaced it.
+  */
+bool Canvas::clearFrameStep(const void * owner) {
+    frameStepMutex.lock();
+    bool owned = frameStep && frameStepOwner == owner;
+    if (owned) {
+      frameStep = nullptr;
+      frameStepOwner = nullptr;
+    }
+    frameStepMutex.unlock();
+    if (owned) {
+      TaskPool::global().wait(frameStepTasks);
+      renderSignal.markDirty();
+    }
+    return owned;
+}
+
  /*!
   * \brief Mutator for showing the FPS.
-  *   \param b Whether to print the FPS to stdout every draw cycle (for debugging purposes).
+  *   \param b Whether to print the FPS and frame time percentiles to stdout about once a second (for debugging purposes).
   */
 void Canvas::setShowFPS(bool b) {
     showFPS = b;
 }
 
+ /*!
+  * \brief Mutator for the spin threshold of the Canvas' draw timer.
+  * \details The rendering thread sleeps until <code>seconds</code> seconds before each frame is due, then
+  *   busy-waits for the remainder. The default of 2 milliseconds hides most of the OS's wake-up latency.
+  *   \param seconds How long to busy-wait before each frame. 0 only sleeps.
+  * \see Timer::setSpinThreshold()
+  */
+void Canvas::setSpinThreshold(double seconds) {
+    drawTimer->setSpinThreshold(seconds);
+}
+
+ /*!
+  * \brief Mutator for throttling the Canvas' frame rate.
+  * \details An unthrottled Canvas draws its frames as fast as it can instead of waiting for its draw timer.
+  *   This is intended for benchmarking.
+  *   \param b Whether the Canvas should wait for its draw timer between frames (true by default).
+  */
+void Canvas::setThrottled(bool b) {
+    drawTimer->setThrottled(b);
+}
+
  /*!
   * \brief Sleeps the calling thread to sync with the Canvas.
   * \details Tells the calling thread to sleep until the Canvas' drawTimer expires.
@@ -1131,11 +1595,10 @@ void Canvas::selectShaders(unsigned int sType) {
         // position attribute
         GLint posAttrib = glGetAttribLocation(shapeShader->ID, "aPos");
         glEnableVertexAttribArray(posAttrib);
-        glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)0);
-        // texture coord attribute
+        // color attribute
         GLint colAttrib = glGetAttribLocation(shapeShader->ID, "aColor");
         glEnableVertexAttribArray(colAttrib);
-        glVertexAttribPointer(colAttrib, 4, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(3 * sizeof(float)));
+        VertexFormat::setLayout(posAttrib, colAttrib);
         program->use();
     } else if (sType == TEXTURE_SHADER_TYPE) {
         program = textureShader;
@@ -1147,6 +1610,12 @@ void Canvas::selectShaders(unsigned int sType) {
         glEnableVertexAttribArray(texAttrib);
         glVertexAttribPointer(texAttrib, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
         program->use();
+    } else if (sType == INSTANCE_SHADER_TYPE) {
+        program = instanceShader;
+        // position attribute; the per-instance attributes are bound by DrawableStore::draw()
+        GLint posAttrib = glGetAttribLocation(instanceShader->ID, "aPos");
+        glEnableVertexAttribArray(posAttrib);
+        program->use();
     }
 
     // Recompute the camera matrices
@@ -1163,6 +1632,20 @@ void Canvas::selectShaders(unsigned int sType) {
     glUniformMatrix4fv(uniModel, 1, GL_FALSE, glm::value_ptr(model));
 }
 
+ /*!
+  * \brief Waits until everything changed so far is on screen.
+  * \details Marks the Canvas dirty, and blocks until the rendering thread has drawn and swapped a frame that
+  *   started after this call. Unlike watching getFrameNumber(), which also counts the cycles on which nothing
+  *   was drawn, this only returns once a frame has really been drawn.
+  *   \param seconds The maximum number of seconds to wait for.
+  * \return True if the frame was drawn, false if the wait timed out (e.g. because the Canvas was closed).
+  * \warning Do not call this while holding an update transaction (see beginFrameUpdate()), or from a frame
+  *   step: the frame it waits for cannot start until those end.
+  */
+bool Canvas::waitForRedraw(double seconds) {
+    return renderSignal.waitForRedraw(seconds);
+}
+
  /*!
   * \brief Waits for the user to close the Canvas.
   * \details This function blocks the calling thread until the user closes the Canvas or until
@@ -10,6 +10,7 @@
   #define GLEW_STATIC
 #endif
 
+#include "Animator.h"       // Our own keyframe animation tracks, evaluated on the render thread
 #include "Array.h"          // Our own array for buffering drawing operations
 #include "Arrow.h"	    // Our own array for drawing arrows
 #include "Background.h"     // Our own class for drawing a background
@@ -22,24 +23,41 @@
 #include "TriangleStrip.h" // Our own class for drawing polygons with colored vertices
 #include "Ellipse.h"        // Our own class for drawing ellipses
 #include "Ellipsoid.h"      // Our own class for drawing ellipsoids
+#include "FrameGate.h"      // Our own gate between frames and update transactions
+#include "FrameProfiler.h"  // Our own profiler for the phases of each frame
+#include "GpuBuffer.h"      // Our own per-context GL buffers that upload only what changed
 #include "Circle.h" 	    // Our own class for drawing circles
 #include "ConcavePolygon.h" // Our own class for concave polygons with colored vertices
 #include "ConvexPolygon.h"  // Our own class for convex polygons with colored vertices
+#include "DrawableStore.h"  // Our own container for very large numbers of instanced objects
+#include "Group.h"          // Our own class for moving several Drawables as one
 #include "Image.h"          // Our own class for drawing images / textured quads
+#include "InstrumentedMutex.h" // Our own mutex that can report lock contention
 #include "Keynums.h"        // Our enums for key presses
+#include "LevelOfDetail.h"  // Our own tessellation levels for curved Shapes
 #include "Line.h"           // Our own class for drawing straight lines
+#include "LineSet.h"        // Our own class for drawing many line segments at once
+#include "Mesh.h"           // Our own class for drawing large meshes kept on the GPU
+#include "ObjectPool.h"     // Our own recycled storage for Drawables made with emplace()
+#include "ParticleSystem.h" // Our own class for simulating and drawing many particles
+#include "PointCloud.h"     // Our own class for drawing many points from the caller's arrays
 #include "Polyline.h"       // Our own class for drawing polylines
 #include "ProgressBar.h"    // Our own class for drawing progress bars
 #include "Pyramid.h"        // Our own class for drawing pyramids
 #include "Rectangle.h"      // Our own class for drawing rectangles
 #include "RegularPolygon.h" // Our own class for drawing regular polygons
+#include "RenderSignal.h"   // Our own flag for redrawing only when the scene changes
+#include "ScrollingPlot.h"  // Our own class for plotting live streams of samples
+#include "SharedMesh.h"     // Our own registry of meshes shared between identical Shapes
 #include "Sphere.h"         // Our own class for drawing spheres
 #include "Square.h"         // Our own class for drawing squares
 #include "Star.h"           // Our own class for drawing stars
+#include "TaskPool.h"       // Our own work-stealing pool for the frame steps
 #include "Text.h"           // Our own class for drawing text
 #include "Timer.h"          // Our own timer for steady FPS
 #include "Triangle.h"       // Our own class for drawing triangles
 #include "Util.h"           // Needed constants and has cmath for performing math operations
+#include "VertexFormat.h"   // Our own compact vertex layout for the shape shader
 
 #include "Camera.h"
 #include "Shader.h"
@@ -54,8 +72,11 @@
 #include <functional>       // For callback upon key presses
 #include <iostream>         // DEBUGGING
 #include <mutex>            // Needed for locking the Canvas for thread-safety
+#include <new>              // For constructing Drawables in pooled storage
 #include <sstream>          // For string building
 #include <string>           // For window titles
+#include <type_traits>      // For checking the classes given to emplace()
+#include <utility>          // For forwarding arguments in emplace()
 #include <algorithm>
 #include <omp.h>
 #ifdef __APPLE__
@@ -91,9 +112,11 @@ protected:
     typedef std::function<void(double, double)>     doubleFunction;
     typedef std::function<void()>                   voidFunction;
 
+    std::vector<AnimatedValue> animatedValues;                          // Values of the animation tracks this frame
+    Animator        animator;                                           // Animation tracks of the Drawables in objectBuffer
     // float           aspect;                                             // Aspect ratio used for setting up the window
     bool        atiCard;                                                // Whether the vendor of the graphics card is ATI
-    std::mutex      backgroundMutex;                                    // Mutex for myBackground
+    InstrumentedMutex backgroundMutex{"Canvas::backgroundMutex"};       // Mutex for myBackground
     voidFunction    boundKeys    [(GLFW_KEY_LAST+1)*2];                 // Array of function objects for key binding
     Camera*         camera;
     bool            defaultBackground;                                  // Boolean indicating whether myBackground has been set by an external source
@@ -101,15 +124,27 @@ protected:
     GLint           framebufferWidth;
     GLint           framebufferHeight;
     int             frameCounter;                                       // Counter for the number of frames that have elapsed in the current session (for animations)
+    FrameGate       frameGate;                                          // Keeps frames and update transactions from overlapping
+    std::function<void(int)> frameStep;                                 // Prepares each next frame on the TaskPool, if set
+    const void *    frameStepOwner = nullptr;                           // Whoever set frameStep, for clearFrameStep()
+    std::mutex      frameStepMutex;                                     // Mutex for frameStep
+    TaskGroup       frameStepTasks;                                     // The frame step running, if any
     bool            isFinished;                                         // If the rendering is done, which will signal the window to close
     bool            keyDown;
     std::string     capturePrefix = "Image";                                          // If a key is being pressed. Prevents an action from happening twice
     int             monitorX, monitorY;                                 // Monitor position for upper left corner
+    FrameProfiler*  profiler;                                           // Times the phases of each frame (NULL unless built with TSGL_PROFILE)
     double          mouseX, mouseY;                                     // Location of the mouse once HandleIO() has been called
     Background *    myBackground;                                       // Pointer to the Background drawn each frame
+    std::vector<Drawable*> drawOrder;                                   // objectBuffer sorted into the order it is drawn in
+    bool            drawOrderStale = false;                             // Whether objects were added or removed since drawOrder was sorted
     std::vector<Drawable*> objectBuffer;                                // Holds a list of pointers to objects drawn each frame
-    std::mutex	    objectMutex;
+    HandleTable     objectHandles;                                      // Handles of the objects in objectBuffer
+    InstrumentedMutex objectMutex{"Canvas::objectMutex"};               // Mutex for objectBuffer
+    ObjectPool      objectPool;                                         // Storage for the objects made with emplace()
+    std::vector<size_t> objectSizes;                                    // Pool block size of each object in objectBuffer, or 0 if the caller owns it
     int             realFPS;                                            // Actual FPS of drawing
+    RenderSignal    renderSignal;                                       // Set whenever the scene changes and a new frame must be drawn
   #ifdef __APPLE__
     pthread_t     renderThread;                                         // Thread dedicated to rendering the Canvas
   #else
@@ -121,11 +156,9 @@ protected:
     Shader *        textShader;                                         // Shader for Text class
     Shader *        shapeShader;                                        // Shader for Shape class
     Shader *        textureShader;                                      // Shader for Background and Image classes
+    Shader *        instanceShader;                                     // Shader for DrawableStore class
     bool            showFPS;                                            // Flag to show DEBUGGING FPS
     bool            started;                                            // Whether our canvas is running and the frame counter is counting
-    std::mutex      syncMutex;                                          // Mutex for syncing the rendering thread with a computational thread
-    int             syncMutexLocked;                                    // Whether the syncMutex is currently locked
-	  int             syncMutexOwner;                                     // Thread ID of the owner of the syncMutex
     bool            toClose;                                            // If the Canvas has been asked to close
     unsigned int    toRecord;                                           // To record the screen each frame
     GLint           uniModel,                                           // Model perspective of the camera
@@ -149,6 +182,9 @@ protected:
                    int action, int mods);                               // GLFW callback for mouse buttons
     void         draw();                                                // Draw loop for the Canvas
     static void  errorCallback(int error, const char* string);          // Display where an error is coming from
+    Handle       addObject(Drawable * shapePtr, size_t pooledBytes);
+    void         applyAnimations();                                     // Evaluates the animation tracks and applies them; objectMutex must be held    // Adds a Drawable, owned by the Canvas if pooledBytes > 0
+    void         destroyPooled(Drawable * shapePtr, size_t pooledBytes); // Destroys a Drawable made with emplace()
     void         glDestroy();                                           // Destroys the GL and GLFW things that are specific for this canvas
     void         init(int xx,int yy,int ww,int hh,
                    std::string title,
@@ -162,6 +198,8 @@ protected:
     void         initWindow();                                          // Initalizes the window specific to the Canvas
     static void  keyCallback(GLFWwindow* window, int key,
                    int scancode, int action, int mods);                 // GLFW callback for keys
+    static void  refreshCallback(GLFWwindow* window);                   // GLFW callback for when the window contents are damaged
+    void         removeObjectAt(uint32_t index);                        // Removes the object at an index of objectBuffer; objectMutex must be held
     void         screenShot();                                          // Takes a screenshot
     static void  scrollCallback(GLFWwindow* window, double xpos,
                    double ypos);                                        // GLFW callback for scrolling
@@ -180,16 +218,69 @@ public:
 
     virtual ~Canvas();
 
+    void beginFrameUpdate();
+
     void bindToButton(Key button, Action action, voidFunction function);
 
     void bindToScroll(std::function<void(double, double)> function);
 
-    void add(Drawable * shapePtr);
+    void changeCentersBy(Drawable * const objects[], const float deltas[], int count);
+
+    Handle add(Drawable * shapePtr);
+
+    Handle animate(Handle target, AnimatedProperty property, const Keyframe keys[], int count, bool loop = false);
+
+    Handle animate(Drawable * target, AnimatedProperty property, const Keyframe keys[], int count, bool loop = false);
 
     void clearBackground();
 
     void close();
 
+    bool contains(Handle h);
+
+    void endFrameUpdate();
+
+    bool isAnimating(Handle track);
+
+    /**
+     * \brief Makes a Drawable in storage owned by the Canvas, and adds it to the Canvas.
+     * \details The Drawable is constructed in a block from the Canvas's ObjectPool, so that programs which spawn and
+     *   despawn many objects every frame reuse the same memory instead of going through new and delete.
+     * \details The Canvas destroys the Drawable when it is removed, when clearObjectBuffer() is called, or when the
+     *   Canvas is destroyed, whichever comes first. Refer to it with the returned Handle, through get().
+     *   \tparam T The class of Drawable to make.
+     *   \param args The arguments to pass to T's constructor.
+     * \return A Handle to the new Drawable.
+     */
+    template <typename T, typename... Args>
+    Handle emplace(Args&&... args) {
+      static_assert(std::is_base_of<Drawable, T>::value, "Canvas::emplace() can only make Drawables");
+      static_assert(alignof(T) <= alignof(std::max_align_t), "ObjectPool blocks are not aligned enough for this type");
+      void* block = objectPool.allocate(sizeof(T));
+      T* object;
+      try {
+        object = new (block) T(std::forward<Args>(args)...);
+      } catch (...) {
+        objectPool.deallocate(block, sizeof(T));
+        throw;
+      }
+      return addObject(object, sizeof(T));
+    }
+
+    Drawable * get(Handle h);
+
+    /*!
+     * \brief Accessor for a Drawable on the Canvas, as its own class.
+     *   \tparam T The class of the Drawable.
+     *   \param h A Handle returned by add() or emplace().
+     * \return A pointer to the Drawable, or NULL if the Handle is stale or the Drawable is not a T.
+     * \warning The pointer is only valid until the Drawable is removed.
+     */
+    template <typename T>
+    T * get(Handle h) { return dynamic_cast<T*>(get(h)); }
+
+    bool clearFrameStep(const void * owner);
+
     void clearObjectBuffer(bool shouldFreeMemory = false);
 
     virtual Background * getBackground();
@@ -206,6 +297,8 @@ public:
 
     float getFPS();
 
+    FrameTimeStats getFrameTimeStats() const;
+
     virtual float getMouseX();
 
     virtual float getMouseY();
@@ -214,6 +307,12 @@ public:
 
     uint8_t* getScreenBuffer();
 
+    /*!
+     * \brief Accessor for the Canvas' frame profiler.
+     * \return The FrameProfiler timing the phases of each frame, or NULL if TSGL was built without TSGL_PROFILE.
+     */
+    FrameProfiler * getProfiler() { return profiler; }
+
     double getTime();
 
     double getTimeBetweenSleeps() const;
@@ -230,12 +329,16 @@ public:
 
     bool isOpen();
 
+    void markDirty();
+
     void pauseDrawing();
 
     void recordForNumFrames(unsigned int num_frames, const std::string& newCaputurePrefix = "");
 
     void remove(Drawable * shapePtr);
 
+    void remove(Handle h);
+
     void reset();
 
     void resumeDrawing();
@@ -268,8 +371,20 @@ public:
 
     void setFont(std::string filename);
 
+    void setFrameStep(std::function<void(int)> step, const void * owner = nullptr);
+
+    void setPoses(Drawable * const objects[], const Pose poses[], int count);
+
+    void setPoses(const Handle handles[], const Pose poses[], int count);
+
     void setShowFPS(bool b);
 
+    void setSpinThreshold(double seconds);
+
+    void setThrottled(bool b);
+
+    void stopAnimation(Handle track);
+
     void sleep();
 
     void sleepFor(float seconds);
@@ -283,6 +398,38 @@ public:
     void takeScreenShot(const std::string& newCapturePrefix = "");
 
     int wait();
+
+    bool waitForRedraw(double seconds = 1.0);
+};
+
+/*! \class FrameUpdate
+ *  \brief Holds a Canvas update transaction open for as long as it is in scope.
+ *  \details Calls Canvas::beginFrameUpdate() when constructed and Canvas::endFrameUpdate() when destroyed, so the
+ *    transaction is closed even if the code in between returns early or throws:
+ *  \code
+ *    {
+ *        FrameUpdate update(can);
+ *        for (int i = 0; i < n; i++)
+ *            bars[i]->setHeight(heights[i]);
+ *    }   // Every bar shows its new height in the same frame
+ *  \endcode
+ */
+class FrameUpdate {
+ private:
+    Canvas& myCanvas;
+ public:
+    /*!
+     * \brief Opens an update transaction on a Canvas.
+     */
+    explicit FrameUpdate(Canvas& can) : myCanvas(can) { myCanvas.beginFrameUpdate(); }
+
+    /*!
+     * \brief Closes the update transaction.
+     */
+    ~FrameUpdate() { myCanvas.endFrameUpdate(); }
+
+    FrameUpdate(const FrameUpdate&) = delete;
+    FrameUpdate& operator=(const FrameUpdate&) = delete;
 };
 
 }
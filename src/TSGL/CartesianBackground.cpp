@@ -195,18 +195,17 @@ void CartesianBackground::drawAxes(Decimal originX, Decimal originY, Decimal spa
   *   \param color The color of the vertices of the plotted function (set to BLACK by default).
   */
 void CartesianBackground::drawFunction(const Function &function, ColorFloat color) {
-    int index = 0;
     int values = (int) ceil((myXMax - myXMin) / pixelWidth);
-    float vertices[values*3];
-    Decimal y;
-    for (Decimal x = myXMin; x < myXMax; x += pixelWidth) {
-        y = function.valueAt(x);
-        vertices[index] = x;
-        vertices[index+1] = y;
-        vertices[index+2] = 0; 
-        index += 3;
+    if (values <= 0)
+        return;
+    std::vector<float> vertices(values*3);
+    for (int i = 0; i < values; i++) {
+        Decimal x = myXMin + i * pixelWidth;
+        vertices[i*3] = x;
+        vertices[i*3+1] = function.valueAt(x);
+        vertices[i*3+2] = 0;
     }
-    drawPolyline(0,0,0,values,vertices,0,0,0,color);
+    drawPolyline(0,0,0,values,vertices.data(),0,0,0,color);
 }
 
  /*!
@@ -232,18 +231,17 @@ void CartesianBackground::drawFunction(functionPointer &function, ColorFloat col
   * \note <code>function</code> must receive exactly one Decimal x parameter, and return a Decimal y parameter.
   */
 void CartesianBackground::drawPartialFunction(functionPointer &function, Decimal min, Decimal max, ColorFloat color) {
-    int index = 0;
     int values = (int) ceil((max - min) / pixelWidth);
-    float vertices[values*3];
-    Decimal y;
-    for (Decimal x = min; x < max; x += pixelWidth) {
-        y = (function)(x);
-        vertices[index] = x;
-        vertices[index+1] = y;
-        vertices[index+2] = 0; 
-        index += 3;
+    if (values <= 0)
+        return;
+    std::vector<float> vertices(values*3);
+    for (int i = 0; i < values; i++) {
+        Decimal x = min + i * pixelWidth;
+        vertices[i*3] = x;
+        vertices[i*3+1] = (function)(x);
+        vertices[i*3+2] = 0;
     }
-    drawPolyline(0,0,0,values,vertices,0,0,0,color);
+    drawPolyline(0,0,0,values,vertices.data(),0,0,0,color);
 }
 
  /*!
@@ -302,11 +300,10 @@ void CartesianBackground::selectShaders(unsigned int sType) {
         // position attribute
         GLint posAttrib = glGetAttribLocation(shapeShader->ID, "aPos");
         glEnableVertexAttribArray(posAttrib);
-        glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)0);
-        // texture coord attribute
+        // color attribute
         GLint colAttrib = glGetAttribLocation(shapeShader->ID, "aColor");
         glEnableVertexAttribArray(colAttrib);
-        glVertexAttribPointer(colAttrib, 4, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(3 * sizeof(float)));
+        VertexFormat::setLayout(posAttrib, colAttrib);
         program->use();
     } else if (sType == TEXTURE_SHADER_TYPE) {
         program = textureShader;
@@ -353,6 +350,7 @@ void CartesianBackground::zoom(Decimal x, Decimal y, Decimal scale) {
     vertices[0]  = vertices[11] = vertices[21] = vertices[10] = vertices[26]  = vertices[20] = -0.5 * ((myCartHeight / 2) / tan(glm::pi<float>()/6) + myWorldZ) / ((myCartHeight / 2) / tan(glm::pi<float>()/6)); // x + y
     vertices[5] = vertices[1] = vertices[15] = vertices[6] = vertices[25] = vertices[16] = 0.5 * ((myCartHeight / 2) / tan(glm::pi<float>()/6) + myWorldZ) / ((myCartHeight / 2) / tan(glm::pi<float>()/6)); // x + y
     attribMutex.unlock();
+    markDirty();
 }
 
  /*!
@@ -371,6 +369,7 @@ void CartesianBackground::zoom(Decimal x1, Decimal y1, Decimal x2, Decimal y2) {
     attribMutex.lock();
     Decimal scale = (std::abs(x2 - x1) / myCartWidth + std::abs(y2 - y1) / myCartHeight) / 2.0;
     attribMutex.unlock();
+    markDirty();
     zoom((x2 + x1) / 2, (y2 + y1) / 2, scale);
 }
 
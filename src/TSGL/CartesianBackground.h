@@ -8,6 +8,7 @@
 #include "Background.h"
 #include "Function.h"   // For drawing math functions on the screen
 #include "Util.h"
+#include <vector>     // For the sampled vertices of plotted functions
 
 namespace tsgl {
 
@@ -134,11 +134,10 @@ void CartesianCanvas::selectShaders(unsigned int sType) {
         // position attribute
         GLint posAttrib = glGetAttribLocation(shapeShader->ID, "aPos");
         glEnableVertexAttribArray(posAttrib);
-        glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)0);
-        // texture coord attribute
+        // color attribute
         GLint colAttrib = glGetAttribLocation(shapeShader->ID, "aColor");
         glEnableVertexAttribArray(colAttrib);
-        glVertexAttribPointer(colAttrib, 4, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(3 * sizeof(float)));
+        VertexFormat::setLayout(posAttrib, colAttrib);
         program->use();
     } else if (sType == TEXTURE_SHADER_TYPE) {
         program = textureShader;
@@ -14,7 +14,7 @@ namespace tsgl {
  *   \param roll The circle's roll in 3D space.
  *   \param color The color of the circle's fill
  */
-Circle::Circle(float x, float y, float z, GLfloat radius, float yaw, float pitch, float roll, ColorFloat color) : ConvexPolygon(x,y,z,(radius + 5) + 1,yaw,pitch,roll) {
+Circle::Circle(float x, float y, float z, GLfloat radius, float yaw, float pitch, float roll, ColorFloat color) : ConvexPolygon(x,y,z,(radius + 5) + 1,yaw,pitch,roll,MeshOnly()) {
     if (radius <= 0) {
         TsglDebug("Cannot have a Circle with radius less than or equal to 0.");
         return;
@@ -23,14 +23,10 @@ Circle::Circle(float x, float y, float z, GLfloat radius, float yaw, float pitch
     myXScale = myYScale = myRadius = radius;
     myZScale = 1;
     verticesPerColor = (myRadius + 6) / 8;
-    numberOfOutlineVertices = numberOfVertices - 1;
+    myFixedSegments = numberOfVertices - 2;
     attribMutex.unlock();
-    addVertex(0,0,0,color);
-    float delta = 2.0f / (numberOfVertices - 2) * PI;
-    for (int i = 0; i < numberOfVertices - 1; ++i) {
-        addVertex(cos(i*delta), sin(i*delta), 0, color);
-        addOutlineVertex(cos(i*delta), sin(i*delta), 0, GRAY);
-    }
+    enableDetail(radius);
+    setColor(color);
 }
 
 /*!
@@ -45,7 +41,7 @@ Circle::Circle(float x, float y, float z, GLfloat radius, float yaw, float pitch
  *   \param roll The circle's roll in 3D space.
  *   \param color An array of colors for the Circle's fill
  */
-Circle::Circle(float x, float y, float z, GLfloat radius, float yaw, float pitch, float roll, ColorFloat color[]) : ConvexPolygon(x,y,z,(GLint) (radius + 5) + 1,yaw,pitch,roll) {
+Circle::Circle(float x, float y, float z, GLfloat radius, float yaw, float pitch, float roll, ColorFloat color[]) : ConvexPolygon(x,y,z,(GLint) (radius + 5) + 1,yaw,pitch,roll,MeshOnly()) {
     if (radius <= 0) {
         TsglDebug("Cannot have a Circle with radius less than or equal to 0.");
         return;
@@ -54,14 +50,47 @@ Circle::Circle(float x, float y, float z, GLfloat radius, float yaw, float pitch
     myXScale = myYScale = myRadius = radius;
     myZScale = 1;
     verticesPerColor = (myRadius + 6) / 8;
-    numberOfOutlineVertices = numberOfVertices - 1;
+    myFixedSegments = numberOfVertices - 2;
+    tessellate(myFixedSegments);
     attribMutex.unlock();
-    addVertex(0,0,0,color[0]);
-    float delta = 2.0f / (numberOfVertices - 2) * PI;
-    for (int i = 0; i < numberOfVertices - 1; ++i) {
-        addVertex(cos(i*delta), sin(i*delta), 0, color[(int) ((float) i / verticesPerColor + 1)]);
-        addOutlineVertex(cos(i*delta), sin(i*delta), 0, GRAY);
-    }
+    setColor(color);
+}
+
+/*!
+ * \brief Switches the Circle to the circle mesh with the given number of segments.
+ * \details Called with <code>attribMutex</code> held.
+ *   \param segments The number of segments around the Circle.
+ */
+void Circle::tessellate(int segments) {
+    setMesh(SharedMesh::acquire(MESH_CIRCLE, segments + 2, 0, buildMesh));
+}
+
+/*!
+ * \brief Builds the unit circle mesh shared by every Circle and Ellipse with the same number of vertices.
+ *   \param count The number of fill vertices: the center, followed by the points on the circumference.
+ *   \param unused Ignored; Circles only have one tessellation parameter.
+ * \return A new SharedMesh of radius 1.
+ */
+SharedMesh * Circle::buildMesh(int count, int unused) {
+    SharedMesh * mesh = new SharedMesh(count, count - 1);
+    mesh->setVertex(0, 0,0,0);
+    const GLfloat * t = TrigTable::unitCircle(count - 2);
+    for (int i = 0; i < count - 1; ++i)
+        mesh->setVertex(i + 1, t[i*2], t[i*2 + 1], 0);
+    mesh->setOutlineBuilder(buildOutline, count, unused);
+    return mesh;
+}
+
+/*!
+ * \brief Fills in the outline of a unit circle mesh, the first time a Circle or Ellipse using it is outlined.
+ *   \param mesh The mesh made by buildMesh().
+ *   \param count The number of fill vertices of the mesh.
+ *   \param unused Ignored; Circles only have one tessellation parameter.
+ */
+void Circle::buildOutline(SharedMesh& mesh, int count, int unused) {
+    const GLfloat * t = TrigTable::unitCircle(count - 2);
+    for (int i = 0; i < count - 1; ++i)
+        mesh.setOutlineVertex(i, t[i*2], t[i*2 + 1], 0);
 }
 
 /**
@@ -77,6 +106,7 @@ void Circle::setRadius(GLfloat radius) {
     myRadius = radius;
     myXScale = myYScale = radius;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -93,6 +123,7 @@ void Circle::changeRadiusBy(GLfloat delta) {
     myXScale += delta;
     myYScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -100,24 +131,21 @@ void Circle::changeRadiusBy(GLfloat delta) {
  * \param c An array of the new ColorFloats.
  */
 void Circle::setColor(ColorFloat c[]) {
+    disableDetail();
     attribMutex.lock();
     myAlpha = 0.0f;
-    vertices[3] = c[0].R;
-    vertices[4] = c[0].G;
-    vertices[5] = c[0].B;
-    vertices[6] = c[0].A;
+    setVertexColor(0, c[0]);
     myAlpha += c[0].A;
     int colorIndex;
     for (int i = 1; i < numberOfVertices; ++i) {
         colorIndex = (int) ((float) (i - 1) / verticesPerColor + 1);
-        vertices[i*7 + 3] = c[colorIndex].R;
-        vertices[i*7 + 4] = c[colorIndex].G;
-        vertices[i*7 + 5] = c[colorIndex].B;
-        vertices[i*7 + 6] = c[colorIndex].A;
+        setVertexColor(i, c[colorIndex]);
         myAlpha += c[colorIndex].A;
     }
     myAlpha /= numberOfVertices;
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -129,7 +157,7 @@ void Circle::setColor(ColorFloat c[]) {
 void Circle::getColors(std::vector<ColorFloat> &colorVec) { 
     attribMutex.lock();
     for (int i = 0; i < numberOfVertices; i+=verticesPerColor) {
-        colorVec.push_back(ColorFloat(vertices[i*7+3],vertices[i*7+4],vertices[i*7+5],vertices[i*7+6]));
+        colorVec.push_back(getVertexColor(i));
     }
     attribMutex.unlock();
 }
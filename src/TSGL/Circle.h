@@ -17,6 +17,8 @@ class Circle : public ConvexPolygon {
 protected:
 	GLfloat myRadius;
     GLfloat verticesPerColor;
+
+    virtual void tessellate(int segments);
 public:
     Circle(float x, float y, float z, GLfloat radius, float yaw, float pitch, float roll, ColorFloat color);
 
@@ -37,6 +39,10 @@ public:
     void setColor(ColorFloat c[]);
 
     virtual void getColors(std::vector<ColorFloat> &colorVec);
+
+    static SharedMesh * buildMesh(int count, int unused);
+
+    static void buildOutline(SharedMesh& mesh, int count, int unused);
   };
 
 }
@@ -1,5 +1,7 @@
 #include "ConcavePolygon.h"
 
+#include <algorithm>
+
 namespace tsgl {
 
  /*!
@@ -16,7 +18,7 @@ namespace tsgl {
   */
 ConcavePolygon::ConcavePolygon(float centerX, float centerY, float centerZ, int numVertices, float yaw, float pitch, float roll) : Shape(centerX,centerY,centerZ,yaw,pitch,roll) {
     attribMutex.lock();
-    geometryType = GL_TRIANGLE_FAN;
+    geometryType = GL_TRIANGLES;
     outlineGeometryType = GL_LINE_LOOP;
     numberOfVertices = numberOfOutlineVertices = numVertices;
     vertices = new GLfloat[numberOfVertices * 7];
@@ -42,7 +44,7 @@ ConcavePolygon::ConcavePolygon(float centerX, float centerY, float centerZ, int
   */
 ConcavePolygon::ConcavePolygon(float centerX, float centerY, float centerZ, int numVertices, float x[], float y[], float yaw, float pitch, float roll, ColorFloat color) : Shape(centerX,centerY,centerZ,yaw,pitch,roll) {
     attribMutex.lock();
-    geometryType = GL_TRIANGLE_FAN;
+    geometryType = GL_TRIANGLES;
     numberOfVertices = numVertices;
     vertices = new GLfloat[numberOfVertices * 7];
     myXScale = myYScale = myZScale = 1;
@@ -70,11 +72,10 @@ ConcavePolygon::ConcavePolygon(float centerX, float centerY, float centerZ, int
   *   \param roll The ConcavePolygon's roll in 3D space.
   *   \param color An array of ColorFloats, the ConcavePolygon's fill color.
   * \return A new ConcavePolygon with a buffer for storing the specified number of vertices.
-  * \warning Can sometimes incorrectly render; if this occurs, try shifting your last vertex to be your first vertex, or otherwise adjusting vertex order.
   */
 ConcavePolygon::ConcavePolygon(float centerX, float centerY, float centerZ, int numVertices, float x[], float y[], float yaw, float pitch, float roll, ColorFloat color[]) : Shape(centerX,centerY,centerZ,yaw,pitch,roll) {
     attribMutex.lock();
-    geometryType = GL_TRIANGLE_FAN;
+    geometryType = GL_TRIANGLES;
     numberOfVertices = numVertices;
     vertices = new GLfloat[numberOfVertices * 7];
     myXScale = myYScale = myZScale = 1;
@@ -89,57 +90,121 @@ ConcavePolygon::ConcavePolygon(float centerX, float centerY, float centerZ, int
 }
 
 /*!
- * \brief Draw the ConcavePolygon.
- * \details This function actually draws the ConcavePolygon to the Canvas.
- * \note This function overrides Drawable::draw()
- * \note This function does nothing if the vertex buffer is not yet full.
- * \note A message indicating that the ConcavePolygon cannot be drawn yet will be given
- *   if the above condition is met (vertex buffer = not full).
+ * \brief Splits the polygon into triangles by ear clipping.
+ * \details The vertices are projected onto the coordinate plane the polygon faces most, and made counterclockwise.
+ *   An ear is a convex corner whose triangle contains no other remaining vertex; clipping ears one at a time
+ *   leaves n - 2 triangles. Since clipping an ear only changes whether its neighbours are ears, the whole
+ *   triangulation takes O(n^2) time. Self-intersecting polygons have no ear at some point, in which case the next corner is
+ *   clipped anyway so that the polygon is still drawn.
+ * \note Called with <code>attribMutex</code> held.
  */
-void ConcavePolygon::draw(Shader * shader) {
-    if (!init) {
-        TsglDebug("Vertex buffer is not full.");
+void ConcavePolygon::triangulate() {
+    int n = numberOfVertices;
+    myTriangles.clear();
+    myTrianglesDirty = false;
+    if (n < 3)
         return;
+    myTriangles.reserve((n - 2) * 3);
+
+    // Newell's method gives the polygon's normal; drop its largest axis to flatten the polygon
+    float normal[3] = { 0, 0, 0 };
+    for (int i = 0; i < n; i++) {
+        const GLfloat * a = vertices + i*7;
+        const GLfloat * b = vertices + ((i + 1) % n)*7;
+        normal[0] += (a[1] - b[1]) * (a[2] + b[2]);
+        normal[1] += (a[2] - b[2]) * (a[0] + b[0]);
+        normal[2] += (a[0] - b[0]) * (a[1] + b[1]);
     }
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(myRotationPointX, myRotationPointY, myRotationPointZ));
-    model = glm::rotate(model, glm::radians(myCurrentYaw), glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::rotate(model, glm::radians(myCurrentPitch), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(myCurrentRoll), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::translate(model, glm::vec3(myCenterX - myRotationPointX, myCenterY - myRotationPointY, myCenterZ - myRotationPointZ));
-    model = glm::scale(model, glm::vec3(myXScale, myYScale, myZScale));
+    int drop = 2;
+    if (fabs(normal[0]) > fabs(normal[drop])) drop = 0;
+    if (fabs(normal[1]) > fabs(normal[drop])) drop = 1;
+    int u = (drop + 1) % 3, v = (drop + 2) % 3;
 
-    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+    std::vector<float> px(n), py(n);
+    float area = 0;
+    for (int i = 0; i < n; i++) {
+        px[i] = vertices[i*7 + u];
+        py[i] = vertices[i*7 + v];
+    }
+    for (int i = 0; i < n; i++)
+        area += px[i] * py[(i + 1) % n] - px[(i + 1) % n] * py[i];
 
-    if (isFilled) {
-        /* extra stencil buffer stuff, because it's concave */
-        glClearStencil(0);
-        glClear(GL_STENCIL_BUFFER);
-        glEnable(GL_STENCIL_TEST);
-        glDisable(GL_CULL_FACE);
-        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
-        glStencilFunc(GL_NEVER, 0, 1);
-        glStencilOp(GL_INVERT, GL_INVERT, GL_INVERT);
-        /* end */
+    // The remaining corners, as a doubly linked ring in counterclockwise order
+    std::vector<int> prev(n), next(n);
+    for (int i = 0; i < n; i++) {
+        int after = (area < 0) ? (i + n - 1) % n : (i + 1) % n;
+        next[i] = after;
+        prev[after] = i;
+    }
 
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfVertices * 7, vertices, GL_DYNAMIC_DRAW);
-        glDrawArrays(geometryType, 0, numberOfVertices);
+    auto cross = [&](int o, int a, int b) {
+        return (px[a] - px[o]) * (py[b] - py[o]) - (py[a] - py[o]) * (px[b] - px[o]);
+    };
+    auto isEar = [&](int cur) {
+        int a = prev[cur], b = next[cur];
+        if (cross(a, cur, b) <= 0)
+            return false;
+        for (int p = next[b]; p != a; p = next[p])
+            if (cross(a, cur, p) >= 0 && cross(cur, b, p) >= 0 && cross(b, a, p) >= 0)
+                return false;
+        return true;
+    };
 
-        /* extra stencil buffer stuff, because it's concave */
-        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-        glStencilFunc(GL_EQUAL, 1, 1);
-        glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
+    // Clipping an ear only changes whether its two neighbours are ears, so only they are tested again
+    std::vector<char> ear(n);
+    for (int i = 0; i < n; i++)
+        ear[i] = isEar(i);
+    int cur = 0;
+    for (int remaining = n; remaining > 3; remaining--) {
+        int start = cur;
+        while (!ear[cur]) {
+            cur = next[cur];
+            if (cur == start)
+                break;                           // No ear left: clip this corner anyway
+        }
+        int a = prev[cur], b = next[cur];
+        myTriangles.push_back(a);
+        myTriangles.push_back(cur);
+        myTriangles.push_back(b);
+        next[a] = b;
+        prev[b] = a;
+        ear[a] = isEar(a);
+        ear[b] = isEar(b);
+        cur = b;
+    }
+    myTriangles.push_back(prev[cur]);
+    myTriangles.push_back(cur);
+    myTriangles.push_back(next[cur]);
+}
 
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfVertices * 7, vertices, GL_DYNAMIC_DRAW);
-        glDrawArrays(geometryType, 0, numberOfVertices);
+/*!
+ * \brief Packs the ConcavePolygon's triangulation, triangulating it again first if its vertices moved.
+ * \note This function overrides Shape::packFill()
+ */
+void ConcavePolygon::packFill(std::vector<PackedVertex>& out) {
+    if (myTrianglesDirty)
+        triangulate();
+    VertexFormat::pack(vertices, myTriangles.data(), myTriangles.size(), out);
+}
 
-        glDisable(GL_STENCIL_TEST);
+/*!
+ * \brief Appends the ConcavePolygon's triangulation and outline to a Group's batch.
+ * \note This function overrides Shape::appendBatch()
+ */
+bool ConcavePolygon::appendBatch(std::vector<PackedVertex>& out, std::vector<BatchRange>& ranges) {
+    glm::mat4 model = modelMatrix();
+    attribMutex.lock();
+    if (isFilled) {
+        if (myTrianglesDirty)
+            triangulate();
+        ranges.push_back(BatchRange{ geometryType, (GLint) out.size(), (GLsizei) myTriangles.size() });
+        appendVertices(model, vertices, myTriangles.data(), myTriangles.size(), out);
     }
-
     if (isOutlined) {
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfOutlineVertices * 7, outlineVertices, GL_DYNAMIC_DRAW);
-        glDrawArrays(outlineGeometryType, 0, numberOfOutlineVertices);
+        ranges.push_back(BatchRange{ outlineGeometryType, (GLint) out.size(), numberOfOutlineVertices });
+        appendVertices(model, outlineVertices, NULL, numberOfOutlineVertices, out);
     }
+    attribMutex.unlock();
+    return true;
 }
 }
@@ -9,28 +9,42 @@
 #include "TsglAssert.h"  // For unit testing purposes
 #include <queue>         // std::queue
 #include <iostream>      // DEBUGGING
+#include <vector>        // For the cached triangulation
 
 namespace tsgl {
 
 /*! \class ConcavePolygon
  *  \brief Draw an arbitrary Concave polygon with colored vertices.
- *  \details ConcavePolygon is a class for holding vertex data for a triangle strip with colored vertices.
- *  \details Vertices are drawn in triangle strip format, where the first three vertices make up the first triangle,
- *   the next vertex plus the previous two make up the second triangle, and so on.
- *  \details This method is optimized for long lists and offers a marked improvement over drawing individual Triangle instances.
+ *  \details ConcavePolygon is a class for holding vertex data for a simple polygon with colored vertices.
+ *  \details The polygon is split into triangles by ear clipping once all of its vertices have been added, and the
+ *   triangles are packed and cached until its vertices move, so each frame draws it in a single pass.
  *  \note The addVertex() method must be called the same number of times as specified in the constructor.
  *  \note Calling addVertex() after all vertices have been added will do nothing.
  *  \note Calling draw() before all vertices have been added will do nothing.
  */
 class ConcavePolygon : public Shape {
+ private:
+    std::vector<GLuint> myTriangles;       // Vertex indices of the triangulation, three per triangle
+    bool myTrianglesDirty = true;          // Whether the vertices moved since the last triangulation
+
+    void triangulate();
  protected:
     ConcavePolygon(float centerX, float centerY, float centerZ, int numVertices, float yaw, float pitch, float roll); 
+
+    /*!
+     * \brief Marks the cached triangulation as stale, so that it is rebuilt by the next repack().
+     * \details Subclasses that move their vertices after construction must call this, and then repack(), with
+     *   <code>attribMutex</code> held.
+     */
+    void invalidateTriangles() { myTrianglesDirty = true; }
+
+    virtual void packFill(std::vector<PackedVertex>& out);
  public:
     ConcavePolygon(float centerX, float centerY, float centerZ, int numVertices, float x[], float y[], float yaw, float pitch, float roll, ColorFloat color);
 
     ConcavePolygon(float centerX, float centerY, float centerZ, int numVertices, float x[], float y[], float yaw, float pitch, float roll, ColorFloat color[]);
 
-    virtual void draw(Shader * shader);
+    virtual bool appendBatch(std::vector<PackedVertex>& out, std::vector<BatchRange>& ranges);
 };
 
 }
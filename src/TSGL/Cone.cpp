@@ -18,8 +18,9 @@ namespace tsgl {
   * \return A new Cone with a buffer for storing the specified numbered of vertices.
   */
 Cone::Cone(float x, float y, float z, float height, float radius, float yaw, float pitch, float roll, ColorFloat c)  
-: Pyramid(x, y, z, 40, height, radius, yaw, pitch, roll, c)  { 
-    numberOfOutlineVertices /= 2;
+: Pyramid(x, y, z, 40, height, radius, yaw, pitch, roll, c)  {
+    myFixedSegments = 40;
+    enableDetail(radius);
 }
 
  /*!
@@ -39,7 +40,23 @@ Cone::Cone(float x, float y, float z, float height, float radius, float yaw, flo
   */
 Cone::Cone(float x, float y, float z, float height, float radius, float yaw, float pitch, float roll, ColorFloat c[]) 
 : Pyramid(x, y, z, 40, height, radius, yaw, pitch, roll, c)  {
+    myFixedSegments = 40;
+    attribMutex.lock();
+    numberOfOutlineVertices /= 2;
+    repack();
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Switches the Cone to the pyramid mesh with the given number of sides.
+  * \details Called with <code>attribMutex</code> held.
+  *   \param segments The number of sides of the Cone's base.
+  */
+void Cone::tessellate(int segments) {
+    mySides = segments;
+    setMesh(SharedMesh::acquire(MESH_PYRAMID, mySides, 0, Pyramid::buildMesh));
     numberOfOutlineVertices /= 2;
+    repack();
 }
 
 /*!
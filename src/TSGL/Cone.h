@@ -13,9 +13,18 @@ namespace tsgl {
 /*! \class Cone
  *  \brief Draw an arbitrary Cone with colored vertices.
  *  \details Cone is a class for holding vertex data for a cone.
- *  \details Cone is a subclass of Pyramid with a base of (radius * 3) sides, minimum of 3.
+ *  \details Cone is a subclass of Pyramid with a circular base, approximated by as many sides as LevelOfDetail
+ *   picks for its size on screen (or 40 sides, if it has per-vertex colors).
  */
 class Cone : public Pyramid {
+protected:
+    virtual void tessellate(int segments);
+
+    /*!
+    * \brief Accessor for the radius used to decide the Cone's level of detail.
+    * \details Only the radius of the base matters, since the Cone is only curved around its axis.
+    */
+    virtual GLfloat getDetailRadius() { return std::max(myXScale, myZScale); }
 public:
     Cone(float x, float y, float z, float height, float radius, float yaw, float pitch, float roll, ColorFloat c);
 
@@ -2,9 +2,18 @@
 
 namespace tsgl {
 
+const GLfloat ConvexPolygon::UNIT_SQUARE[4 * 3] = {
+    -0.5f,  0.5f, 0.0f,
+    -0.5f, -0.5f, 0.0f,
+     0.5f, -0.5f, 0.0f,
+     0.5f,  0.5f, 0.0f
+};
+
  /*!
   * \brief Explicitly constructs a new ConvexPolygon.
   * \details Protected explicit constructor for a Convex Polygon object. Used as superclass constructor.
+  * \details Subclasses with a fixed number of vertices (Triangle, Rectangle, Square) pass arrays of their own
+  *   to store the vertices in, so that the whole Shape is a single allocation.
  *   \param centerX The x coordinate of the ConvexPolygon's center.
  *   \param centerY The y coordinate of the ConvexPolygon's center.
  *   \param centerZ The z coordinate of the ConvexPolygon's center.
@@ -12,19 +21,46 @@ namespace tsgl {
  *   \param yaw The ConvexPolygon's yaw in 3D space.
  *   \param pitch The ConvexPolygon's pitch in 3D space.
  *   \param roll The ConvexPolygon's roll in 3D space..
+ *   \param vertexStorage An array of <code>numVertices * 7</code> floats for the fill vertices, owned by the
+ *     subclass, or NULL to allocate one.
+ *   \param outlineStorage An array of <code>numVertices * 7</code> floats for the outline vertices; must be
+ *     given if and only if <code>vertexStorage</code> is.
   * \return A new ConvexPolygon with a buffer for storing the specified numbered of vertices.
   */
-ConvexPolygon::ConvexPolygon(float centerX, float centerY, float centerZ,  int numVertices, float yaw, float pitch, float roll) : Shape(centerX,centerY,centerZ,yaw,pitch,roll) {
+ConvexPolygon::ConvexPolygon(float centerX, float centerY, float centerZ,  int numVertices, float yaw, float pitch, float roll, GLfloat vertexStorage[], GLfloat outlineStorage[]) : Shape(centerX,centerY,centerZ,yaw,pitch,roll) {
     attribMutex.lock();
     geometryType = GL_TRIANGLE_FAN;
     outlineGeometryType = GL_LINE_LOOP;
     numberOfVertices = numberOfOutlineVertices = numVertices;
-    vertices = new GLfloat[numberOfVertices * 7];
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
+    myVerticesInline = (vertexStorage != nullptr);
+    vertices = myVerticesInline ? vertexStorage : new GLfloat[numberOfVertices * 7];
+    outlineVertices = myVerticesInline ? outlineStorage : new GLfloat[numberOfOutlineVertices * 7];
     myXScale = myYScale = myZScale = 1;
     attribMutex.unlock();    
 }
 
+ /*!
+  * \brief Explicitly constructs a new ConvexPolygon that is drawn from a SharedMesh.
+  * \details Protected explicit constructor for subclasses (Circle, Ellipse) that switch to a SharedMesh before they
+  *   are drawn: the vertex counts are set, but no vertices are allocated, since the mesh replaces them.
+ *   \param centerX The x coordinate of the ConvexPolygon's center.
+ *   \param centerY The y coordinate of the ConvexPolygon's center.
+ *   \param centerZ The z coordinate of the ConvexPolygon's center.
+ *   \param numVertices The number of vertices of the fixed tessellation.
+ *   \param yaw The ConvexPolygon's yaw in 3D space.
+ *   \param pitch The ConvexPolygon's pitch in 3D space.
+ *   \param roll The ConvexPolygon's roll in 3D space..
+  * \return A new ConvexPolygon without vertices, which the subclass must give a mesh.
+  */
+ConvexPolygon::ConvexPolygon(float centerX, float centerY, float centerZ,  int numVertices, float yaw, float pitch, float roll, MeshOnly) : Shape(centerX,centerY,centerZ,yaw,pitch,roll) {
+    attribMutex.lock();
+    geometryType = GL_TRIANGLE_FAN;
+    outlineGeometryType = GL_LINE_LOOP;
+    numberOfVertices = numberOfOutlineVertices = numVertices;
+    myXScale = myYScale = myZScale = 1;
+    attribMutex.unlock();
+}
+
  /*!
   * \brief Explicitly constructs a new ConvexPolygon with monocolored fill.
   * \details Explicit constructor for a Convex Polygon object.
@@ -49,10 +85,14 @@ ConvexPolygon::ConvexPolygon(float centerX, float centerY, float centerZ,  int n
     outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
     myXScale = myYScale = myZScale = 1;
     attribMutex.unlock();    
+    std::vector<GLfloat> positions(numVertices * 3);
     for (int i = 0; i < numVertices; i++) {
-        addVertex(x[i] - centerX, y[i] - centerY, 0, color);
-        addOutlineVertex(x[i] - centerX, y[i] - centerY, 0, GRAY);
+        positions[i*3] = x[i] - centerX;
+        positions[i*3 + 1] = y[i] - centerY;
+        positions[i*3 + 2] = 0;
     }
+    addVertices(positions.data(), numVertices, color);
+    addOutlineVertices(positions.data(), numVertices, GRAY);
 }
 
  /*!
@@ -79,10 +119,14 @@ ConvexPolygon::ConvexPolygon(float centerX, float centerY, float centerZ,  int n
     outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
     myXScale = myYScale = myZScale = 1;
     attribMutex.unlock();    
+    std::vector<GLfloat> positions(numVertices * 3);
     for (int i = 0; i < numVertices; i++) {
-        addVertex(x[i] - centerX, y[i] - centerY, 0, color[i]);
-        addOutlineVertex(x[i] - centerX, y[i] - centerY, 0, GRAY);
+        positions[i*3] = x[i] - centerX;
+        positions[i*3 + 1] = y[i] - centerY;
+        positions[i*3 + 2] = 0;
     }
+    addVertices(positions.data(), numVertices, color);
+    addOutlineVertices(positions.data(), numVertices, GRAY);
 }
 
 }
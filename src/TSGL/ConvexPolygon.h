@@ -22,7 +22,14 @@ namespace tsgl {
  */
 class ConvexPolygon : public Shape {
  protected:
-    ConvexPolygon(float centerX, float centerY, float centerZ, int numVertices, float yaw, float pitch, float roll);
+    static const GLfloat UNIT_SQUARE[4 * 3];  // Corners of a unit square, counterclockwise from the top left
+
+    struct MeshOnly { };                      // Tag for subclasses that always draw a SharedMesh
+
+    ConvexPolygon(float centerX, float centerY, float centerZ, int numVertices, float yaw, float pitch, float roll,
+                  GLfloat vertexStorage[] = nullptr, GLfloat outlineStorage[] = nullptr);
+
+    ConvexPolygon(float centerX, float centerY, float centerZ, int numVertices, float yaw, float pitch, float roll, MeshOnly);
  public:
     ConvexPolygon(float centerX, float centerY, float centerZ, int numVertices, GLfloat x[], GLfloat y[], float yaw, float pitch, float roll, ColorFloat color);
 
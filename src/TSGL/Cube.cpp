@@ -2,6 +2,41 @@
 
 namespace tsgl {
 
+const GLfloat Cube::CORNERS[8 * 3] = {
+    -0.5f, -0.5f, -0.5f,
+    -0.5f, -0.5f,  0.5f,
+    -0.5f,  0.5f,  0.5f,
+    -0.5f,  0.5f, -0.5f,
+     0.5f, -0.5f, -0.5f,
+     0.5f, -0.5f,  0.5f,
+     0.5f,  0.5f,  0.5f,
+     0.5f,  0.5f, -0.5f
+};
+
+const int Cube::VERTEX_CORNERS[36] = {
+    0, 1, 2,  0, 2, 3,
+    4, 5, 6,  4, 6, 7,
+    4, 0, 1,  4, 1, 5,
+    7, 3, 2,  7, 2, 6,
+    0, 3, 7,  0, 7, 4,
+    1, 2, 6,  1, 6, 5
+};
+
+const GLfloat Cube::UNIT_OUTLINE[24 * 3] = {
+     0.5f,  0.5f,  0.5f,   0.5f,  0.5f, -0.5f,
+     0.5f,  0.5f, -0.5f,   0.5f, -0.5f, -0.5f,
+     0.5f, -0.5f, -0.5f,   0.5f, -0.5f,  0.5f,
+     0.5f, -0.5f,  0.5f,   0.5f,  0.5f,  0.5f,
+    -0.5f,  0.5f,  0.5f,  -0.5f,  0.5f, -0.5f,
+    -0.5f,  0.5f, -0.5f,  -0.5f, -0.5f, -0.5f,
+    -0.5f, -0.5f, -0.5f,  -0.5f, -0.5f,  0.5f,
+    -0.5f, -0.5f,  0.5f,  -0.5f,  0.5f,  0.5f,
+    -0.5f,  0.5f,  0.5f,   0.5f,  0.5f,  0.5f,
+    -0.5f,  0.5f, -0.5f,   0.5f,  0.5f, -0.5f,
+    -0.5f, -0.5f, -0.5f,   0.5f, -0.5f, -0.5f,
+    -0.5f, -0.5f,  0.5f,   0.5f, -0.5f,  0.5f
+};
+
  /*!
   * \brief Explicitly constructs a new Cube.
   * \details Explicit constructor for a Cube object.
@@ -27,80 +62,10 @@ Cube::Cube(float x, float y, float z, GLfloat sideLength, float yaw, float pitch
     myXScale = sideLength;
     myYScale = sideLength;
     myZScale = sideLength;
-    numberOfVertices = 36;
-    vertices = new GLfloat[numberOfVertices * 7];  
     outlineGeometryType = GL_LINES;
-    numberOfOutlineVertices = 24;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];  
     attribMutex.unlock();
-    addVertex(-0.5, -0.5, -0.5, c);
-    addVertex(-0.5, -0.5, 0.5, c);
-    addVertex(-0.5, 0.5, 0.5, c);
-    addVertex(-0.5, -0.5, -0.5, c);
-    addVertex(-0.5, 0.5, 0.5, c);
-    addVertex(-0.5, 0.5, -0.5, c);
-    
-    addVertex(0.5, -0.5, -0.5, c);
-    addVertex(0.5, -0.5, 0.5, c);
-    addVertex(0.5, 0.5, 0.5, c);
-    addVertex(0.5, -0.5, -0.5, c);
-    addVertex(0.5, 0.5, 0.5, c);
-    addVertex(0.5, 0.5, -0.5, c);
-
-    addVertex(0.5, -0.5, -0.5, c);
-    addVertex(-0.5, -0.5, -0.5, c);
-    addVertex(-0.5, -0.5, 0.5, c);
-    addVertex(0.5, -0.5, -0.5, c);
-    addVertex(-0.5, -0.5, 0.5, c);
-    addVertex(0.5, -0.5, 0.5, c);
-
-    addVertex(0.5, 0.5, -0.5, c);
-    addVertex(-0.5, 0.5, -0.5, c);
-    addVertex(-0.5, 0.5, 0.5, c);
-    addVertex(0.5, 0.5, -0.5, c);
-    addVertex(-0.5, 0.5, 0.5, c);
-    addVertex(0.5, 0.5, 0.5, c);
-
-    addVertex(-0.5, -0.5, -0.5, c);
-    addVertex(-0.5, 0.5, -0.5, c);
-    addVertex(0.5, 0.5, -0.5, c);
-    addVertex(-0.5, -0.5, -0.5, c);
-    addVertex(0.5, 0.5, -0.5, c);
-    addVertex(0.5, -0.5, -0.5, c);
-
-    addVertex(-0.5, -0.5, 0.5, c);
-    addVertex(-0.5, 0.5, 0.5, c);
-    addVertex(0.5, 0.5, 0.5, c);
-    addVertex(-0.5, -0.5, 0.5, c);
-    addVertex(0.5, 0.5, 0.5, c);
-    addVertex(0.5, -0.5, 0.5, c);
-
-    addOutlineVertex( 0.5,  0.5,  0.5, GRAY);
-    addOutlineVertex( 0.5,  0.5, -0.5, GRAY);
-    addOutlineVertex( 0.5,  0.5, -0.5, GRAY);
-    addOutlineVertex( 0.5, -0.5, -0.5, GRAY);
-    addOutlineVertex( 0.5, -0.5, -0.5, GRAY);
-    addOutlineVertex( 0.5, -0.5,  0.5, GRAY);
-    addOutlineVertex( 0.5, -0.5,  0.5, GRAY);
-    addOutlineVertex( 0.5,  0.5,  0.5, GRAY);
-
-    addOutlineVertex(-0.5,  0.5,  0.5, GRAY);
-    addOutlineVertex(-0.5,  0.5, -0.5, GRAY);
-    addOutlineVertex(-0.5,  0.5, -0.5, GRAY);
-    addOutlineVertex(-0.5, -0.5, -0.5, GRAY);
-    addOutlineVertex(-0.5, -0.5, -0.5, GRAY);
-    addOutlineVertex(-0.5, -0.5,  0.5, GRAY);
-    addOutlineVertex(-0.5, -0.5,  0.5, GRAY);
-    addOutlineVertex(-0.5,  0.5,  0.5, GRAY);
-
-    addOutlineVertex(-0.5,  0.5,  0.5, GRAY);
-    addOutlineVertex( 0.5,  0.5,  0.5, GRAY);
-    addOutlineVertex(-0.5,  0.5, -0.5, GRAY);
-    addOutlineVertex( 0.5,  0.5, -0.5, GRAY);
-    addOutlineVertex(-0.5, -0.5, -0.5, GRAY);
-    addOutlineVertex( 0.5, -0.5, -0.5, GRAY);
-    addOutlineVertex(-0.5, -0.5,  0.5, GRAY);
-    addOutlineVertex( 0.5, -0.5,  0.5, GRAY);
+    useMesh(SharedMesh::acquire(MESH_CUBE, 0, 0, buildMesh));
+    setColor(c);
 }
 
  /*!
@@ -128,80 +93,38 @@ Cube::Cube(float x, float y, float z, GLfloat sideLength, float yaw, float pitch
     myXScale = sideLength;
     myYScale = sideLength;
     myZScale = sideLength;
-    numberOfVertices = 36;
-    vertices = new GLfloat[numberOfVertices * 7];
     outlineGeometryType = GL_LINES;
-    numberOfOutlineVertices = 24;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7]; 
     attribMutex.unlock();
-    addVertex(-0.5, -0.5, -0.5, c[0]);
-    addVertex(-0.5, -0.5, 0.5, c[1]);
-    addVertex(-0.5, 0.5, 0.5, c[2]);
-    addVertex(-0.5, -0.5, -0.5, c[0]);
-    addVertex(-0.5, 0.5, 0.5, c[2]);
-    addVertex(-0.5, 0.5, -0.5, c[3]);
-    
-    addVertex(0.5, -0.5, -0.5, c[4]);
-    addVertex(0.5, -0.5, 0.5, c[5]);
-    addVertex(0.5, 0.5, 0.5, c[6]);
-    addVertex(0.5, -0.5, -0.5, c[4]);
-    addVertex(0.5, 0.5, 0.5, c[6]);
-    addVertex(0.5, 0.5, -0.5, c[7]);
-
-    addVertex(0.5, -0.5, -0.5, c[4]);
-    addVertex(-0.5, -0.5, -0.5, c[0]);
-    addVertex(-0.5, -0.5, 0.5, c[1]);
-    addVertex(0.5, -0.5, -0.5, c[4]);
-    addVertex(-0.5, -0.5, 0.5, c[1]);
-    addVertex(0.5, -0.5, 0.5, c[5]);
-
-    addVertex(0.5, 0.5, -0.5, c[7]);
-    addVertex(-0.5, 0.5, -0.5, c[3]);
-    addVertex(-0.5, 0.5, 0.5, c[2]);
-    addVertex(0.5, 0.5, -0.5, c[7]);
-    addVertex(-0.5, 0.5, 0.5, c[2]);
-    addVertex(0.5, 0.5, 0.5, c[6]);
-
-    addVertex(-0.5, -0.5, -0.5, c[0]);
-    addVertex(-0.5, 0.5, -0.5, c[3]);
-    addVertex(0.5, 0.5, -0.5, c[7]);
-    addVertex(-0.5, -0.5, -0.5, c[0]);
-    addVertex(0.5, 0.5, -0.5, c[7]);
-    addVertex(0.5, -0.5, -0.5, c[4]);
-
-    addVertex(-0.5, -0.5, 0.5, c[1]);
-    addVertex(-0.5, 0.5, 0.5, c[2]);
-    addVertex(0.5, 0.5, 0.5, c[6]);
-    addVertex(-0.5, -0.5, 0.5, c[1]);
-    addVertex(0.5, 0.5, 0.5, c[6]);
-    addVertex(0.5, -0.5, 0.5, c[5]);
-
-    addOutlineVertex( 0.5,  0.5,  0.5, GRAY);
-    addOutlineVertex( 0.5,  0.5, -0.5, GRAY);
-    addOutlineVertex( 0.5,  0.5, -0.5, GRAY);
-    addOutlineVertex( 0.5, -0.5, -0.5, GRAY);
-    addOutlineVertex( 0.5, -0.5, -0.5, GRAY);
-    addOutlineVertex( 0.5, -0.5,  0.5, GRAY);
-    addOutlineVertex( 0.5, -0.5,  0.5, GRAY);
-    addOutlineVertex( 0.5,  0.5,  0.5, GRAY);
+    useMesh(SharedMesh::acquire(MESH_CUBE, 0, 0, buildMesh));
+    setColor(c);
+}
 
-    addOutlineVertex(-0.5,  0.5,  0.5, GRAY);
-    addOutlineVertex(-0.5,  0.5, -0.5, GRAY);
-    addOutlineVertex(-0.5,  0.5, -0.5, GRAY);
-    addOutlineVertex(-0.5, -0.5, -0.5, GRAY);
-    addOutlineVertex(-0.5, -0.5, -0.5, GRAY);
-    addOutlineVertex(-0.5, -0.5,  0.5, GRAY);
-    addOutlineVertex(-0.5, -0.5,  0.5, GRAY);
-    addOutlineVertex(-0.5,  0.5,  0.5, GRAY);
+ /*!
+  * \brief Builds the unit cube mesh shared by every Cube and Cuboid.
+  * \details The 8 corners are stored once and indexed by the 12 triangles of the faces.
+  *   \param unused1 Ignored; there is only one cube mesh.
+  *   \param unused2 Ignored; there is only one cube mesh.
+  * \return A new SharedMesh with side length 1.
+  */
+SharedMesh * Cube::buildMesh(int unused1, int unused2) {
+    SharedMesh * mesh = new SharedMesh(8, 24, 36);
+    for (int i = 0; i < 8; i++)
+        mesh->setVertex(i, CORNERS[i*3], CORNERS[i*3 + 1], CORNERS[i*3 + 2]);
+    for (int i = 0; i < 36; i++)
+        mesh->setIndex(i, VERTEX_CORNERS[i]);
+    mesh->setOutlineBuilder(buildOutline, unused1, unused2);
+    return mesh;
+}
 
-    addOutlineVertex(-0.5,  0.5,  0.5, GRAY);
-    addOutlineVertex( 0.5,  0.5,  0.5, GRAY);
-    addOutlineVertex(-0.5,  0.5, -0.5, GRAY);
-    addOutlineVertex( 0.5,  0.5, -0.5, GRAY);
-    addOutlineVertex(-0.5, -0.5, -0.5, GRAY);
-    addOutlineVertex( 0.5, -0.5, -0.5, GRAY);
-    addOutlineVertex(-0.5, -0.5,  0.5, GRAY);
-    addOutlineVertex( 0.5, -0.5,  0.5, GRAY);
+ /*!
+  * \brief Fills in the edges of the unit cube mesh, the first time a Cube or Cuboid is outlined.
+  *   \param mesh The mesh made by buildMesh().
+  *   \param unused1 Ignored; there is only one cube mesh.
+  *   \param unused2 Ignored; there is only one cube mesh.
+  */
+void Cube::buildOutline(SharedMesh& mesh, int unused1, int unused2) {
+    for (int i = 0; i < 24; i++)
+        mesh.setOutlineVertex(i, UNIT_OUTLINE[i*3], UNIT_OUTLINE[i*3 + 1], UNIT_OUTLINE[i*3 + 2]);
 }
 
 /**
@@ -219,6 +142,7 @@ void Cube::setSideLength(GLfloat length) {
     myZScale = length;
     mySideLength = length;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -236,6 +160,7 @@ void Cube::changeSideLengthBy(GLfloat delta) {
     myYScale += delta;
     myZScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -245,48 +170,12 @@ void Cube::changeSideLengthBy(GLfloat delta) {
  */
 void Cube::setColor(ColorFloat c[]) {
     attribMutex.lock();
-    vertices[3] = vertices[24] = vertices[94] = vertices[171] = vertices[192] = c[0].R;
-    vertices[4] = vertices[25] = vertices[95] = vertices[172] = vertices[193] = c[0].G;
-    vertices[5] = vertices[26] = vertices[96] = vertices[173] = vertices[194] = c[0].B;
-    vertices[6] = vertices[27] = vertices[97] = vertices[174] = vertices[195] = c[0].A;
-
-    vertices[10] = vertices[101] = vertices[115] = vertices[213] = vertices[234] = c[1].R;
-    vertices[11] = vertices[102] = vertices[116] = vertices[214] = vertices[235] = c[1].G;
-    vertices[12] = vertices[103] = vertices[117] = vertices[215] = vertices[236] = c[1].B;
-    vertices[13] = vertices[104] = vertices[118] = vertices[216] = vertices[237] = c[1].A;
-
-    vertices[17] = vertices[31] = vertices[143] = vertices[157] = vertices[220] = c[2].R;
-    vertices[18] = vertices[32] = vertices[144] = vertices[158] = vertices[221] = c[2].G;
-    vertices[19] = vertices[33] = vertices[145] = vertices[159] = vertices[222] = c[2].B;
-    vertices[20] = vertices[34] = vertices[146] = vertices[160] = vertices[223] = c[2].A;
-
-    vertices[38] = vertices[136] = vertices[178] = c[3].R;
-    vertices[39] = vertices[137] = vertices[179] = c[3].G;
-    vertices[40] = vertices[138] = vertices[180] = c[3].B;
-    vertices[41] = vertices[139] = vertices[181] = c[3].A;
-
-    vertices[45] = vertices[66] = vertices[87] = vertices[108] = vertices[206] = c[4].R;
-    vertices[46] = vertices[67] = vertices[88] = vertices[109] = vertices[207] = c[4].G;
-    vertices[47] = vertices[68] = vertices[89] = vertices[110] = vertices[208] = c[4].B;
-    vertices[48] = vertices[69] = vertices[90] = vertices[111] = vertices[209] = c[4].A;
-
-    vertices[52] = vertices[122] = vertices[248] = c[5].R;
-    vertices[53] = vertices[123] = vertices[249] = c[5].G;
-    vertices[54] = vertices[124] = vertices[250] = c[5].B;
-    vertices[55] = vertices[125] = vertices[251] = c[5].A;
-
-    vertices[59] = vertices[73] = vertices[164] = vertices[227] = vertices[241] = c[6].R;
-    vertices[60] = vertices[74] = vertices[165] = vertices[228] = vertices[242] = c[6].G;
-    vertices[61] = vertices[75] = vertices[166] = vertices[229] = vertices[243] = c[6].B;
-    vertices[62] = vertices[76] = vertices[167] = vertices[230] = vertices[244] = c[6].A;
-
-    vertices[80] = vertices[129] = vertices[150] = vertices[185] = vertices[199] = c[7].R;
-    vertices[81] = vertices[130] = vertices[151] = vertices[186] = vertices[200] = c[7].G;
-    vertices[82] = vertices[131] = vertices[152] = vertices[187] = vertices[201] = c[7].B;
-    vertices[83] = vertices[132] = vertices[153] = vertices[188] = vertices[202] = c[7].A;
-
+    for (int i = 0; i < numberOfVertices; i++)
+        setVertexColor(i, c[VERTEX_CORNERS[i]]);
     myAlpha = (c[0].A + c[1].A + c[2].A + c[3].A + c[4].A + c[5].A + c[6].A + c[7].A) / 8;
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -297,14 +186,12 @@ void Cube::setColor(ColorFloat c[]) {
  */
 void Cube::getColors(std::vector<ColorFloat> &colorVec) {
     attribMutex.lock();
-    colorVec.push_back(ColorFloat(vertices[3],vertices[4],vertices[5],vertices[6]));
-    colorVec.push_back(ColorFloat(vertices[10],vertices[11],vertices[12],vertices[13]));
-    colorVec.push_back(ColorFloat(vertices[17],vertices[18],vertices[19],vertices[20]));
-    colorVec.push_back(ColorFloat(vertices[38],vertices[39],vertices[40],vertices[41]));
-    colorVec.push_back(ColorFloat(vertices[45],vertices[46],vertices[47],vertices[48]));
-    colorVec.push_back(ColorFloat(vertices[52],vertices[53],vertices[54],vertices[55]));
-    colorVec.push_back(ColorFloat(vertices[59],vertices[60],vertices[61],vertices[62]));
-    colorVec.push_back(ColorFloat(vertices[80],vertices[81],vertices[82],vertices[83]));
+    for (int corner = 0; corner < 8; corner++) {
+        int i = 0;
+        while (VERTEX_CORNERS[i] != corner)
+            i++;
+        colorVec.push_back(getVertexColor(i));
+    }
     attribMutex.unlock();
 }
 
@@ -19,6 +19,10 @@ class Cube : public Shape {
 protected:
     GLfloat mySideLength;
 public:
+    static const GLfloat CORNERS[8 * 3];         // Positions of the 8 corners of a unit cube
+    static const int VERTEX_CORNERS[36];         // Corner of each vertex of the 12 triangles, two per face
+    static const GLfloat UNIT_OUTLINE[24 * 3];   // Positions of the ends of the unit cube's 12 edges
+
     Cube(float x, float y, float z, GLfloat sideLength, float yaw, float pitch, float roll, ColorFloat c);
 
     Cube(float x, float y, float z, GLfloat sideLength, float yaw, float pitch, float roll, ColorFloat c[]);
@@ -39,6 +43,10 @@ public:
 
     virtual void getColors(std::vector<ColorFloat> &colorVec);
 
+    static SharedMesh * buildMesh(int unused1, int unused2);
+
+    static void buildOutline(SharedMesh& mesh, int unused1, int unused2);
+
     /*!
      * \brief Destructor for the Cube.
      */
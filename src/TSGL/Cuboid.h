@@ -5,6 +5,7 @@
 #ifndef CUBOID_H_
 #define CUBOID_H_
 
+#include "Cube.h"        // For the unit cube geometry
 #include "Shape.h"       // For extending our Prism object
 #include "TsglAssert.h"  // For unit testing purposes
 
@@ -19,7 +19,8 @@ namespace tsgl {
   */
 Cylinder::Cylinder(float x, float y, float z, GLfloat height, GLfloat radius, float yaw, float pitch, float roll, ColorFloat c)  
 : Prism(x, y, z, 40, height, radius, yaw, pitch, roll, c)  {
-    numberOfOutlineVertices = numberOfOutlineVertices * 2 / 3;
+    myFixedSegments = 40;
+    enableDetail(radius);
 }
 
  /*!
@@ -38,8 +39,24 @@ Cylinder::Cylinder(float x, float y, float z, GLfloat height, GLfloat radius, fl
   * \return A new Cylinder with a buffer for storing the specified numbered of vertices.
   */
 Cylinder::Cylinder(float x, float y, float z, float height, float radius, float yaw, float pitch, float roll, ColorFloat c[])  
-: Prism(x, y, z, 40, height, radius, yaw, pitch, roll, c)  { 
+: Prism(x, y, z, 40, height, radius, yaw, pitch, roll, c)  {
+    myFixedSegments = 40;
+    attribMutex.lock();
+    numberOfOutlineVertices = numberOfOutlineVertices * 2 / 3;
+    repack();
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Switches the Cylinder to the prism mesh with the given number of sides.
+  * \details Called with <code>attribMutex</code> held.
+  *   \param segments The number of sides of the Cylinder's base.
+  */
+void Cylinder::tessellate(int segments) {
+    mySides = segments;
+    setMesh(SharedMesh::acquire(MESH_PRISM, mySides, 0, Prism::buildMesh));
     numberOfOutlineVertices = numberOfOutlineVertices * 2 / 3;
+    repack();
 }
 
 /*!
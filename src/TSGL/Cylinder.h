@@ -13,9 +13,18 @@ namespace tsgl {
 /*! \class Cylinder
  *  \brief Draw an arbitrary Cylinder with colored vertices.
  *  \details Cylinder is a class for holding vertex data for a Cylinder.
- *  \details Cylinder is a subclass of Prism with a circular base.
+ *  \details Cylinder is a subclass of Prism with a circular base, approximated by as many sides as LevelOfDetail
+ *   picks for its size on screen (or 40 sides, if it has per-vertex colors).
  */
 class Cylinder : public Prism {
+protected:
+    virtual void tessellate(int segments);
+
+    /*!
+    * \brief Accessor for the radius used to decide the Cylinder's level of detail.
+    * \details Only the radius of the base matters, since the Cylinder is only curved around its axis.
+    */
+    virtual GLfloat getDetailRadius() { return std::max(myXScale, myZScale); }
 public:
     Cylinder(float x, float y, float z, GLfloat height, GLfloat radius, float yaw, float pitch, float roll, ColorFloat c);
 
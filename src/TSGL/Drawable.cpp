@@ -23,11 +23,98 @@ Drawable::Drawable(float x, float y, float z, float yaw, float pitch, float roll
     myRotationPointZ = myCenterZ;
 }
 
+/*!
+ * \brief Builds the model matrix from the Drawable's center, rotation point, rotation and scale.
+ * \details Takes a consistent snapshot of the transform through attribMutex's sequence counter, so the render
+ *   thread never blocks on the lock, and never sees a transform that a setter has only half written.
+ * \details While a Group is drawing the Drawable, returns the world matrix the Group cached for it instead.
+ * \warning Must not be called while holding attribMutex.
+ * \return The matrix that draw() should pass to the shader's <code>model</code> uniform.
+ */
+glm::mat4 Drawable::modelMatrix() {
+    if (myModelOverride)
+        return *myModelOverride;
+    float rx, ry, rz, cx, cy, cz, yaw, pitch, roll, sx, sy, sz;
+    unsigned seq;
+    do {
+        seq = attribMutex.readBegin();
+        rx = myRotationPointX; ry = myRotationPointY; rz = myRotationPointZ;
+        cx = myCenterX; cy = myCenterY; cz = myCenterZ;
+        yaw = myCurrentYaw; pitch = myCurrentPitch; roll = myCurrentRoll;
+        sx = myXScale; sy = myYScale; sz = myZScale;
+    } while (attribMutex.readRetry(seq));
+
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, glm::vec3(rx, ry, rz));
+    model = glm::rotate(model, glm::radians(yaw), glm::vec3(0.0f, 0.0f, 1.0f));
+    model = glm::rotate(model, glm::radians(pitch), glm::vec3(0.0f, 1.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(roll), glm::vec3(1.0f, 0.0f, 0.0f));
+    model = glm::translate(model, glm::vec3(cx - rx, cy - ry, cz - rz));
+    model = glm::scale(model, glm::vec3(sx, sy, sz));
+    return model;
+}
+
+/*!
+ * \brief Transforms vertices in the Drawable's 7-float format and appends them as PackedVertex.
+ * \details Helper for appendBatch().
+ * \param transform Matrix to transform each position by.
+ * \param source Vertices, 7 floats each (x, y, z, r, g, b, a).
+ * \param indices Indices of the vertices to append, or NULL to append the first <code>count</code> in order.
+ * \param count The number of vertices to append.
+ * \param out Array to append them to.
+ */
+void Drawable::appendVertices(const glm::mat4& transform, const GLfloat source[], const GLuint indices[], int count,
+                              std::vector<PackedVertex>& out) {
+    size_t first = out.size();
+    out.resize(first + count);
+    for (int i = 0; i < count; i++) {
+        const GLfloat* v = source + (indices ? indices[i] : i) * 7;
+        glm::vec4 p = transform * glm::vec4(v[0], v[1], v[2], 1.0f);
+        PackedVertex& pv = out[first + i];
+        pv.x = p.x; pv.y = p.y; pv.z = p.z;
+        pv.color[0] = VertexFormat::packChannel(v[3]);
+        pv.color[1] = VertexFormat::packChannel(v[4]);
+        pv.color[2] = VertexFormat::packChannel(v[5]);
+        pv.color[3] = VertexFormat::packChannel(v[6]);
+    }
+}
+
 /////////////////////////////////////////////////
 // MUTATORS
 /////////////////////////////////////////////////
 
 
+/**
+ * \brief Sets the properties driven by animation tracks, under a single lock.
+ * \details Called by Canvas on the render thread with the values of every track of this Drawable.
+ *   The rotation point follows the center if they matched, as with setCenter().
+ * \param values Array of ANIMATED_PROPERTIES values, indexed by AnimatedProperty.
+ * \param mask Bit <code>1 << p</code> is set for each property <code>p</code> to set; the others are left alone.
+ */
+void Drawable::applyAnimation(const float values[], unsigned mask) {
+    const unsigned TRANSFORM = (1 << ANIMATE_X) | (1 << ANIMATE_Y) | (1 << ANIMATE_Z)
+                             | (1 << ANIMATE_YAW) | (1 << ANIMATE_PITCH) | (1 << ANIMATE_ROLL);
+    if (!(mask & TRANSFORM))
+        return;
+    attribMutex.lock();
+    float x = (mask & (1 << ANIMATE_X)) ? values[ANIMATE_X] : myCenterX;
+    float y = (mask & (1 << ANIMATE_Y)) ? values[ANIMATE_Y] : myCenterY;
+    float z = (mask & (1 << ANIMATE_Z)) ? values[ANIMATE_Z] : myCenterZ;
+    if (centerMatchesRotationPoint()) {
+        myRotationPointX = x;
+        myRotationPointY = y;
+        myRotationPointZ = z;
+    }
+    myCenterX = x;
+    myCenterY = y;
+    myCenterZ = z;
+    if (mask & (1 << ANIMATE_YAW)) myCurrentYaw = values[ANIMATE_YAW];
+    if (mask & (1 << ANIMATE_PITCH)) myCurrentPitch = values[ANIMATE_PITCH];
+    if (mask & (1 << ANIMATE_ROLL)) myCurrentRoll = values[ANIMATE_ROLL];
+    attribMutex.unlock();
+    markDirty();
+}
+
 /**
  * \brief Alters the Drawable's x position
  * \param deltaX The difference between the new and old vertex x coordinates.
@@ -41,6 +128,7 @@ void Drawable::changeXBy(float deltaX) {
     }
     myCenterX += deltaX;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -56,6 +144,7 @@ void Drawable::changeYBy(float deltaY) {
     }
     myCenterY += deltaY;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -71,6 +160,7 @@ void Drawable::changeZBy(float deltaZ) {
     }
     myCenterZ += deltaZ;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -92,6 +182,7 @@ void Drawable::changeCenterBy(float deltaX, float deltaY, float deltaZ) {
     myCenterY += deltaY;
     myCenterZ += deltaZ;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -107,6 +198,7 @@ void Drawable::setCenterX(float x) {
     }
     myCenterX = x;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -122,6 +214,7 @@ void Drawable::setCenterY(float y) {
     }
     myCenterY = y;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -137,6 +230,7 @@ void Drawable::setCenterZ(float z) {
     }
     myCenterZ = z;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -158,6 +252,7 @@ void Drawable::setCenter(float x, float y, float z) {
     myCenterY = y;
     myCenterZ = z;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -168,6 +263,7 @@ void Drawable::setYaw(float yaw) {
     attribMutex.lock();
     myCurrentYaw = yaw;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -178,6 +274,7 @@ void Drawable::setPitch(float pitch) {
     attribMutex.lock();
     myCurrentPitch = pitch;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -188,6 +285,7 @@ void Drawable::setRoll(float roll) {
     attribMutex.lock();
     myCurrentRoll = roll;
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
@@ -202,6 +300,32 @@ void Drawable::setYawPitchRoll(float yaw, float pitch, float roll) {
     myCurrentPitch = pitch;
     myCurrentRoll = roll;
     attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Moves and rotates the Drawable at once.
+ * \details Equivalent to setCenter() followed by setYawPitchRoll(), but locks <code>attribMutex</code> only once,
+ *   and the render thread never draws the new center with the old rotation.
+ * \param pose The new center and yaw, pitch and roll.
+ * \warning This will also alter the Drawable's rotation point similarly if and
+ *          only if the old rotation point was at the Drawable's old center.
+ */
+void Drawable::setPose(const Pose& pose) {
+    attribMutex.lock();
+    if (centerMatchesRotationPoint()) {
+        myRotationPointX = pose.x;
+        myRotationPointY = pose.y;
+        myRotationPointZ = pose.z;
+    }
+    myCenterX = pose.x;
+    myCenterY = pose.y;
+    myCenterZ = pose.z;
+    myCurrentYaw = pose.yaw;
+    myCurrentPitch = pose.pitch;
+    myCurrentRoll = pose.roll;
+    attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -212,6 +336,7 @@ void Drawable::changeYawBy(float deltaYaw) {
     attribMutex.lock();
     myCurrentYaw += deltaYaw;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -222,6 +347,7 @@ void Drawable::changePitchBy(float deltaPitch) {
     attribMutex.lock();
     myCurrentPitch += deltaPitch;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -232,6 +358,7 @@ void Drawable::changeRollBy(float deltaRoll) {
     attribMutex.lock();
     myCurrentRoll += deltaRoll;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -246,6 +373,7 @@ void Drawable::changeYawPitchRollBy(float deltaYaw, float deltaPitch, float delt
     myCurrentPitch += deltaPitch;
     myCurrentRoll += deltaRoll;
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
@@ -257,6 +385,7 @@ void Drawable::setRotationPointX(float x) {
     attribMutex.lock();
     myRotationPointX = x;
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
@@ -268,6 +397,7 @@ void Drawable::setRotationPointY(float y) {
     attribMutex.lock();
     myRotationPointY = y;
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
@@ -279,6 +409,7 @@ void Drawable::setRotationPointZ(float z) {
     attribMutex.lock();
     myRotationPointZ = z;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -293,6 +424,7 @@ void Drawable::setRotationPoint(float x, float y, float z) {
     myRotationPointY = y;
     myRotationPointZ = z;
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
@@ -369,7 +501,8 @@ float Drawable::getCenterZ() {
 }
 
 Drawable::~Drawable() {
-    delete[] vertices;
+    if (!myVerticesInline)
+        delete[] vertices;
 }
 
 }
\ No newline at end of file
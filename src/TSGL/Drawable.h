@@ -6,14 +6,50 @@
 #define DRAWABLE_H_
 
 #include "Color.h"      // Needed for color type
+#include "HandleTable.h" // For the Handle of the Drawable in its Canvas
+#include "SeqLock.h"    // Our own mutex that the renderer can read past without locking
+#include "RenderSignal.h" // For telling the Canvas that the Drawable changed
 #include "Shader.h"
+#include "VertexFormat.h" // For the vertices Drawables hand to a Group's batch
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <atomic>       // For the version counter
 #include <mutex>        // Needed for locking the attribute mutex for thread-safety
+#include <vector>       // For the vertices Drawables hand to a Group's batch
 
 namespace tsgl {
 
+/*! \struct Pose
+ *  \brief The center and rotation of a Drawable, for setting both at once.
+ *  \details Angles are in degrees, as for Drawable::setYawPitchRoll().
+ */
+struct Pose {
+    float x, y, z;
+    float yaw, pitch, roll;
+};
+
+/*! \enum AnimatedProperty
+ *  \brief The properties of a Drawable that keyframe animation tracks can drive.
+ *  \details Colors only apply to Shapes.
+ *  \see Canvas::animate()
+ */
+enum AnimatedProperty {
+    ANIMATE_X, ANIMATE_Y, ANIMATE_Z,
+    ANIMATE_YAW, ANIMATE_PITCH, ANIMATE_ROLL,
+    ANIMATE_RED, ANIMATE_GREEN, ANIMATE_BLUE, ANIMATE_ALPHA,
+    ANIMATED_PROPERTIES
+};
+
+/*! \struct BatchRange
+ *  \brief A run of vertices in a Group's batch, drawn with a single primitive mode.
+ */
+struct BatchRange {
+    GLenum mode;         // GL primitive mode
+    GLint first;         // Index of the first vertex in the batch
+    GLsizei count;       // Number of vertices
+};
+
 /*! \class Drawable
  *  \brief A class for drawing objects onto a Canvas or CartesianCanvas.
  *  \warning <b><i>Though extending this class must be allowed due to the way the code is set up, attempting to do so
@@ -26,11 +62,16 @@ namespace tsgl {
  *  See https://www.opengl.org/sdk/docs/man2/xhtml/glBegin.xml for further information.
  *  \details Theoretically, you could potentially extend the Drawable class so that you can create another Drawable class that suits your needs.
  *  \details However, this is not recommended for normal use of the TSGL library.
+ *  \details Mutators lock <code>attribMutex</code>. The render thread builds each Drawable's model matrix with
+ *  modelMatrix(), which reads the transform through the lock's sequence counter instead of locking it.
+ *  Shapes, Polylines, Meshes and LineSets also hand their vertices, colors and meshes to the render thread through a
+ *  Mailbox or VertexMailbox while the mutator still holds the lock, so their draw() never locks it at all.
  */
 class Drawable {
  protected:
-    std::mutex      attribMutex; ///< Protects the attributes of the Drawable from being accessed while simultaneously being changed
-    GLfloat* vertices;
+    SeqLock attribMutex{"Drawable::attribMutex"}; ///< Protects the attributes of the Drawable from being accessed while simultaneously being changed; draw() reads the transform and vertices without locking it
+    GLfloat* vertices = nullptr;
+    bool myVerticesInline = false; ///< Whether the vertex arrays are members of the Drawable itself rather than on the heap
     float myCurrentYaw, myCurrentPitch, myCurrentRoll;
     float myXScale, myYScale, myZScale;
     float myRotationPointX, myRotationPointY, myRotationPointZ;
@@ -38,6 +79,10 @@ class Drawable {
     bool init = false;
     unsigned int shaderType = SHAPE_SHADER_TYPE;
     GLfloat myAlpha = 0.0;
+    RenderSignal * myRenderSignal = nullptr; ///< Signal of the Canvas this Drawable was added to, if any
+    Handle myCanvasHandle; ///< Handle of the Drawable in the Canvas it was added to, if any
+    const glm::mat4 * myModelOverride = nullptr; ///< World matrix cached by the Group drawing this Drawable; only set during Group::draw()
+    std::atomic<unsigned> myVersion{0}; ///< Incremented by markDirty(), whenever the Drawable changes
     /*!
         * \brief Protected helper method that determines if the Drawable's center matches its rotation point.
         * \details Checks to see if myCenterX == myRotationPointX, myCenterY == myRotationPointY, myCenterZ == myRotationPointZ
@@ -46,6 +91,19 @@ class Drawable {
     bool centerMatchesRotationPoint() {
         return (myCenterX == myRotationPointX && myCenterY == myRotationPointY && myCenterZ == myRotationPointZ);
     }
+
+    static void appendVertices(const glm::mat4& transform, const GLfloat source[], const GLuint indices[], int count,
+                               std::vector<PackedVertex>& out);
+
+    /*!
+        * \brief Protected helper method that records that the Drawable has changed, and tells the owning Canvas.
+        * \details Bumps the number returned by getVersion(). Does not tell a Canvas if the Drawable has not been
+        *   added to one.
+        */
+    void markDirty() {
+        myVersion.fetch_add(1, std::memory_order_release);
+        if (myRenderSignal) myRenderSignal->markDirty();
+    }
  public:
     Drawable(float x, float y, float z, float yaw, float pitch, float roll);
 
@@ -53,6 +111,18 @@ class Drawable {
 
     virtual void draw(Shader * shader) = 0;
 
+    glm::mat4 modelMatrix();
+
+   /*!
+    * \brief Appends the Drawable's vertices, in its parent's space, to a Group's batch.
+    * \details Called by Group with <code>attribMutex</code> not held. Drawables that draw plain vertices with the
+    *   shape shader override this; the rest are drawn one by one with draw().
+    * \param out Array to append the vertices to, transformed by modelMatrix().
+    * \param ranges Array to append a BatchRange to for each primitive mode drawn.
+    * \return False if the Drawable cannot be batched, in which case nothing is appended.
+    */
+    virtual bool appendBatch(std::vector<PackedVertex>& out, std::vector<BatchRange>& ranges) { return false; }
+
     virtual void changeXBy(float deltaX);
     virtual void changeYBy(float deltaY);
     virtual void changeZBy(float deltaZ);
@@ -68,6 +138,18 @@ class Drawable {
     virtual void setRoll(float roll);
     virtual void setYawPitchRoll(float yaw, float pitch, float roll);
 
+    virtual void setPose(const Pose& pose);
+
+    /*!
+     * \brief Called by Canvas::animate() when a track starts animating one of the Drawable's properties.
+     * \details Does nothing by default; overridden by Drawables that animate a property relative to its value
+     *   when the track started.
+     * \param property The AnimatedProperty the track drives.
+     */
+    virtual void startAnimation(AnimatedProperty property) { }
+
+    virtual void applyAnimation(const float values[], unsigned mask);
+
     virtual void changeYawBy(float deltaYaw);
     virtual void changePitchBy(float deltaPitch);
     virtual void changeRollBy(float deltaRoll);
@@ -135,6 +217,49 @@ class Drawable {
     * \details Principally designed to be used within Canvas for transparency sorting.
     */
     virtual float getAlpha() { return myAlpha; }
+
+   /*!
+    * \brief Lets the Drawable adapt its tessellation to its size on screen.
+    * \details Called by Canvas every frame, just before draw(). Does nothing unless overridden.
+    * \param eye The position of the camera.
+    * \param pixelsPerUnit The number of pixels one world unit spans at distance 1 from the camera.
+    */
+    virtual void selectDetail(const glm::vec3& eye, float pixelsPerUnit) { }
+
+   /*!
+    * \brief Mutator for the RenderSignal notified when the Drawable changes.
+    * \details Called by Canvas::add() and Canvas::remove(); there is no need to call this directly.
+    * \param signal Pointer to the RenderSignal of the owning Canvas, or nullptr.
+    */
+    virtual void setRenderSignal(RenderSignal * signal) { myRenderSignal = signal; }
+
+   /*!
+    * \brief Mutator for the Handle of the Drawable in its Canvas.
+    * \details Called by Canvas::add() and Canvas::remove(); there is no need to call this directly.
+    * \param h The Handle returned by Canvas::add(), or a null Handle.
+    */
+    void setCanvasHandle(Handle h) { myCanvasHandle = h; }
+
+   /*!
+    * \brief Accessor for the Handle of the Drawable in its Canvas.
+    * \return The Handle returned when the Drawable was last added to a Canvas, or a null Handle if it has been removed.
+    */
+    Handle getCanvasHandle() { return myCanvasHandle; }
+
+   /*!
+    * \brief Accessor for a number that changes whenever the Drawable is changed.
+    * \details Every mutator changes it, through markDirty(); accessors and drawing do not. Used by Group to tell
+    *   which of its children's cached transforms and vertices are out of date.
+    */
+    unsigned getVersion() { return myVersion.load(std::memory_order_acquire); }
+
+   /*!
+    * \brief Makes modelMatrix() return the given matrix instead of building one.
+    * \details Called by Group around drawing a child, with the child's cached world matrix; there is no need to
+    *   call this directly.
+    * \param model Pointer to the matrix, or nullptr to go back to building it from the Drawable's attributes.
+    */
+    void setModelOverride(const glm::mat4 * model) { myModelOverride = model; }
 };
 
 }
@@ -0,0 +1,445 @@
+#include "DrawableStore.h"
+
+namespace tsgl {
+
+namespace {
+    // Names of the instanced shader's per-instance attributes, in array order
+    const char* const ATTRIBUTE_NAMES[] = { "aX", "aY", "aZ", "aYaw", "aPitch", "aRoll", "aScale", "aColor", "aVisible" };
+}
+
+ /*!
+  * \brief Explicitly constructs a new, empty DrawableStore.
+  * \details Explicit constructor for a DrawableStore object.
+  *   \param x The x coordinate of the DrawableStore's center.
+  *   \param y The y coordinate of the DrawableStore's center.
+  *   \param z The z coordinate of the DrawableStore's center.
+  *   \param yaw The DrawableStore's yaw.
+  *   \param pitch The DrawableStore's pitch.
+  *   \param roll The DrawableStore's roll.
+  * \return A new DrawableStore with no meshes and no instances.
+  */
+DrawableStore::DrawableStore(float x, float y, float z, float yaw, float pitch, float roll) : Drawable(x,y,z,yaw,pitch,roll) {
+    attribMutex.lock();
+    myXScale = myYScale = myZScale = 1;
+    shaderType = INSTANCE_SHADER_TYPE;
+    myAlpha = 1.0f;
+    init = true;
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Draw the DrawableStore.
+ * \details This function actually draws the DrawableStore to the Canvas, with one glDrawArraysInstanced() per
+ *   mesh that has instances. Each instance array is bound as a separate attribute with a divisor of 1, offset
+ *   to the first instance of the mesh being drawn.
+ * \note This function overrides Drawable::draw()
+ */
+void DrawableStore::draw(Shader * shader) {
+    if (!init) {
+        TsglDebug("Vertex buffer is not full.");
+        return;
+    }
+    glm::mat4 model = modelMatrix();
+    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+    GLint canvasBuffer;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &canvasBuffer);
+    GLint posAttrib = glGetAttribLocation(shader->ID, "aPos");
+    GLint locations[ARRAYS];
+    for (int a = 0; a < ARRAYS; a++)
+        locations[a] = glGetAttribLocation(shader->ID, ATTRIBUTE_NAMES[a]);
+
+    myArrayMutex.lock();
+    unsigned n = myHandles.size();
+    if (n == 0) {
+        myArrayMutex.unlock();
+        return;
+    }
+    myMeshBuffer.bind(GL_ARRAY_BUFFER, myMeshVertices.data(), myMeshVertices.size() * sizeof(GLfloat));
+    glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (void*)0);
+    for (int a = 0; a < ARRAYS; a++) {
+        glEnableVertexAttribArray(locations[a]);
+        glVertexAttribDivisor(locations[a], 1);
+    }
+    for (unsigned m = 0; m < myMeshes.size(); m++) {
+        const MeshRange& r = myMeshes[m];
+        if (r.numInstances == 0)
+            continue;
+        // The first bind of each array in a frame uploads whatever changed; later ones only bind
+        for (int a = 0; a < FLOAT_ARRAYS; a++) {
+            myBuffers[a].bind(GL_ARRAY_BUFFER, myFloats[a].data(), n * sizeof(GLfloat));
+            glVertexAttribPointer(locations[a], 1, GL_FLOAT, GL_FALSE, 0, (void*)(r.firstInstance * sizeof(GLfloat)));
+        }
+        myBuffers[FLOAT_ARRAYS].bind(GL_ARRAY_BUFFER, myColors.data(), n * 4);
+        glVertexAttribPointer(locations[FLOAT_ARRAYS], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, (void*)((size_t)r.firstInstance * 4));
+        myBuffers[FLOAT_ARRAYS + 1].bind(GL_ARRAY_BUFFER, myVisible.data(), n);
+        glVertexAttribPointer(locations[FLOAT_ARRAYS + 1], 1, GL_UNSIGNED_BYTE, GL_FALSE, 0, (void*)(size_t)r.firstInstance);
+        glDrawArraysInstanced(r.mode, r.firstVertex, r.numVertices, r.numInstances);
+    }
+    myArrayMutex.unlock();
+
+    for (int a = 0; a < ARRAYS; a++) {
+        glVertexAttribDivisor(locations[a], 0);
+        glDisableVertexAttribArray(locations[a]);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, canvasBuffer);
+}
+
+// Swaps two instances in every array; called with myArrayMutex held
+void DrawableStore::swapInstances(unsigned a, unsigned b) {
+    if (a == b)
+        return;
+    for (int i = 0; i < FLOAT_ARRAYS; i++)
+        std::swap(myFloats[i][a], myFloats[i][b]);
+    for (int i = 0; i < 4; i++)
+        std::swap(myColors[a*4 + i], myColors[b*4 + i]);
+    std::swap(myVisible[a], myVisible[b]);
+    std::swap(myMeshIds[a], myMeshIds[b]);
+    myHandles.swap(a, b);
+    invalidateInstance(a);
+    invalidateInstance(b);
+}
+
+// Marks one instance to be uploaded again; called with myArrayMutex held
+void DrawableStore::invalidateInstance(unsigned index) {
+    for (int a = 0; a < FLOAT_ARRAYS; a++)
+        myBuffers[a].invalidate(index * sizeof(GLfloat), sizeof(GLfloat));
+    myBuffers[FLOAT_ARRAYS].invalidate(index * 4, 4);
+    myBuffers[FLOAT_ARRAYS + 1].invalidate(index, 1);
+}
+
+// Resizes every array; called with myArrayMutex held
+void DrawableStore::resizeArrays(unsigned size) {
+    for (int a = 0; a < FLOAT_ARRAYS; a++)
+        myFloats[a].resize(size);
+    myColors.resize(size * 4);
+    myVisible.resize(size);
+    myMeshIds.resize(size);
+}
+
+// Locks the instance arrays once no update is open, so that they can be resized
+void DrawableStore::lockForResize() {
+    std::unique_lock<InstrumentedMutex> lock(myArrayMutex);
+    myUpdateEnded.wait(lock, [this]() { return !myUpdating; });
+    lock.release();
+}
+
+/**
+ * \brief Adds a mesh that instances can be drawn with.
+ * \param numVertices The number of vertices in the mesh.
+ * \param positions An array of 3 * numVertices floats, the x-y-z of each vertex relative to an instance's position.
+ * \param mode The GL primitive the vertices form, such as GL_TRIANGLES (the default) or GL_LINES.
+ * \return The ID of the new mesh, for add(), or -1 if the mesh is invalid.
+ */
+int DrawableStore::addMesh(int numVertices, const GLfloat positions[], GLenum mode) {
+    if (numVertices <= 0 || !positions) {
+        TsglDebug("Cannot have a mesh without vertices.");
+        return -1;
+    }
+    myArrayMutex.lock();
+    if (myMeshes.size() > UINT16_MAX) {
+        myArrayMutex.unlock();
+        TsglDebug("Cannot have any more meshes in a DrawableStore.");
+        return -1;
+    }
+    MeshRange r;
+    r.firstVertex = myMeshVertices.size() / 3;
+    r.numVertices = numVertices;
+    r.mode = mode;
+    r.firstInstance = myHandles.size();
+    r.numInstances = 0;
+    size_t oldSize = myMeshVertices.size();
+    myMeshVertices.insert(myMeshVertices.end(), positions, positions + numVertices * 3);
+    // Upload the new vertices even if they fit in the buffer the GPU already has
+    myMeshBuffer.invalidate(oldSize * sizeof(GLfloat), (myMeshVertices.size() - oldSize) * sizeof(GLfloat));
+    myMeshes.push_back(r);
+    int id = myMeshes.size() - 1;
+    myArrayMutex.unlock();
+    return id;
+}
+
+/**
+ * \brief Adds an instance of a mesh.
+ * \details The instance is placed after the other instances of its mesh, which moves the first instance of every
+ *   later mesh to the end of that mesh's instances.
+ * \param mesh The ID of the mesh, from addMesh().
+ * \param x The x coordinate of the instance, relative to the DrawableStore's center.
+ * \param y The y coordinate of the instance, relative to the DrawableStore's center.
+ * \param z The z coordinate of the instance, relative to the DrawableStore's center.
+ * \param color The color of the instance.
+ * \param scale The scale of the mesh for the instance (set to 1 by default).
+ * \return A Handle to the new instance, or a null Handle if the mesh does not exist.
+ */
+Handle DrawableStore::add(int mesh, float x, float y, float z, ColorFloat color, float scale) {
+    lockForResize();
+    if (mesh < 0 || mesh >= (int)myMeshes.size()) {
+        myArrayMutex.unlock();
+        TsglDebug("Cannot add an instance of a mesh that does not exist.");
+        return Handle();
+    }
+    Handle h = myHandles.push();
+    unsigned index = myHandles.size() - 1;
+    resizeArrays(index + 1);
+    for (int k = myMeshes.size() - 1; k > mesh; k--) {
+        MeshRange& r = myMeshes[k];
+        if (r.numInstances > 0) {
+            swapInstances(r.firstInstance, index);
+            index = r.firstInstance;
+        }
+        r.firstInstance++;
+    }
+    myMeshes[mesh].numInstances++;
+    GLfloat values[FLOAT_ARRAYS] = { x, y, z, 0, 0, 0, scale };
+    for (int a = 0; a < FLOAT_ARRAYS; a++)
+        myFloats[a][index] = values[a];
+    VertexFormat::packColor(color, &myColors[index * 4]);
+    myVisible[index] = 1;
+    myMeshIds[index] = mesh;
+    invalidateInstance(index);
+    myArrayMutex.unlock();
+    markDirty();
+    return h;
+}
+
+/**
+ * \brief Removes an instance.
+ * \details The instance is swapped to the end of its mesh's instances, and then to the end of every later mesh's
+ *   instances, so every mesh's instances stay contiguous.
+ * \param h A Handle to the instance. Stale Handles are ignored.
+ */
+void DrawableStore::remove(Handle h) {
+    lockForResize();
+    unsigned index = myHandles.indexOf(h);
+    if (index == UINT32_MAX) {
+        myArrayMutex.unlock();
+        return;
+    }
+    int mesh = myMeshIds[index];
+    MeshRange& own = myMeshes[mesh];
+    swapInstances(index, own.firstInstance + own.numInstances - 1);
+    index = own.firstInstance + own.numInstances - 1;
+    own.numInstances--;
+    for (unsigned k = mesh + 1; k < myMeshes.size(); k++) {
+        MeshRange& r = myMeshes[k];
+        r.firstInstance--;
+        if (r.numInstances > 0) {
+            swapInstances(index, r.firstInstance + r.numInstances);
+            index = r.firstInstance + r.numInstances;
+        }
+    }
+    myHandles.release(h);
+    myHandles.popBack();
+    resizeArrays(myHandles.size());
+    myArrayMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Removes every instance, keeping the meshes.
+ * \details Every Handle issued so far becomes stale.
+ */
+void DrawableStore::clear() {
+    lockForResize();
+    myHandles.clear();
+    resizeArrays(0);
+    for (unsigned k = 0; k < myMeshes.size(); k++)
+        myMeshes[k].firstInstance = myMeshes[k].numInstances = 0;
+    myArrayMutex.unlock();
+    markDirty();
+}
+
+/*!
+ * \brief Whether a Handle still refers to an instance of the DrawableStore.
+ */
+bool DrawableStore::contains(Handle h) {
+    myArrayMutex.lock();
+    bool c = myHandles.contains(h);
+    myArrayMutex.unlock();
+    return c;
+}
+
+/**
+ * \brief Moves an instance.
+ * \param h A Handle to the instance. Stale Handles are ignored.
+ * \param x The new x coordinate, relative to the DrawableStore's center.
+ * \param y The new y coordinate, relative to the DrawableStore's center.
+ * \param z The new z coordinate, relative to the DrawableStore's center.
+ */
+void DrawableStore::setPosition(Handle h, float x, float y, float z) {
+    myArrayMutex.lock();
+    unsigned i = myHandles.indexOf(h);
+    if (i != UINT32_MAX) {
+        myFloats[0][i] = x; myFloats[1][i] = y; myFloats[2][i] = z;
+        invalidateInstance(i);
+    }
+    myArrayMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Rotates an instance about its own position.
+ * \param h A Handle to the instance. Stale Handles are ignored.
+ * \param yaw The new yaw in degrees.
+ * \param pitch The new pitch in degrees.
+ * \param roll The new roll in degrees.
+ */
+void DrawableStore::setRotation(Handle h, float yaw, float pitch, float roll) {
+    myArrayMutex.lock();
+    unsigned i = myHandles.indexOf(h);
+    if (i != UINT32_MAX) {
+        myFloats[3][i] = yaw; myFloats[4][i] = pitch; myFloats[5][i] = roll;
+        invalidateInstance(i);
+    }
+    myArrayMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Scales an instance's mesh.
+ * \param h A Handle to the instance. Stale Handles are ignored.
+ * \param scale The new scale.
+ */
+void DrawableStore::setScale(Handle h, float scale) {
+    myArrayMutex.lock();
+    unsigned i = myHandles.indexOf(h);
+    if (i != UINT32_MAX) {
+        myFloats[6][i] = scale;
+        invalidateInstance(i);
+    }
+    myArrayMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Recolors an instance.
+ * \param h A Handle to the instance. Stale Handles are ignored.
+ * \param color The new color.
+ */
+void DrawableStore::setInstanceColor(Handle h, ColorFloat color) {
+    myArrayMutex.lock();
+    unsigned i = myHandles.indexOf(h);
+    if (i != UINT32_MAX) {
+        VertexFormat::packColor(color, &myColors[i * 4]);
+        invalidateInstance(i);
+    }
+    myArrayMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Shows or hides an instance without removing it.
+ * \param h A Handle to the instance. Stale Handles are ignored.
+ * \param visible Whether the instance is drawn.
+ */
+void DrawableStore::setVisible(Handle h, bool visible) {
+    myArrayMutex.lock();
+    unsigned i = myHandles.indexOf(h);
+    if (i != UINT32_MAX) {
+        myVisible[i] = visible;
+        invalidateInstance(i);
+    }
+    myArrayMutex.unlock();
+    markDirty();
+}
+
+/*!
+ * \brief Accessor for the x coordinate of an instance.
+ * \return The x coordinate, or 0 if the Handle is stale.
+ */
+float DrawableStore::getX(Handle h) {
+    myArrayMutex.lock();
+    unsigned i = myHandles.indexOf(h);
+    float x = (i != UINT32_MAX) ? myFloats[0][i] : 0;
+    myArrayMutex.unlock();
+    return x;
+}
+
+/*!
+ * \brief Accessor for the y coordinate of an instance.
+ * \return The y coordinate, or 0 if the Handle is stale.
+ */
+float DrawableStore::getY(Handle h) {
+    myArrayMutex.lock();
+    unsigned i = myHandles.indexOf(h);
+    float y = (i != UINT32_MAX) ? myFloats[1][i] : 0;
+    myArrayMutex.unlock();
+    return y;
+}
+
+/*!
+ * \brief Accessor for the z coordinate of an instance.
+ * \return The z coordinate, or 0 if the Handle is stale.
+ */
+float DrawableStore::getZ(Handle h) {
+    myArrayMutex.lock();
+    unsigned i = myHandles.indexOf(h);
+    float z = (i != UINT32_MAX) ? myFloats[2][i] : 0;
+    myArrayMutex.unlock();
+    return z;
+}
+
+/*!
+ * \brief Accessor for the mesh of an instance.
+ * \return The mesh ID, or -1 if the Handle is stale.
+ */
+int DrawableStore::getMesh(Handle h) {
+    myArrayMutex.lock();
+    unsigned i = myHandles.indexOf(h);
+    int mesh = (i != UINT32_MAX) ? myMeshIds[i] : -1;
+    myArrayMutex.unlock();
+    return mesh;
+}
+
+/**
+ * \brief Hands out a copy of the instance arrays for writing them directly.
+ * \details Between beginUpdate() and endUpdate(), the arrays from getXs(), getYs() and so on may be written from
+ *   any number of threads, as long as each element is written by only one. They start out as a copy of the
+ *   current values, and the DrawableStore goes on being drawn from those until endUpdate().
+ * \details Adding or removing instances, or beginning another update, waits until endUpdate(). Changes made with
+ *   setPosition() and the like meanwhile are overwritten if endUpdate() is told their attribute changed.
+ */
+void DrawableStore::beginUpdate() {
+    std::unique_lock<InstrumentedMutex> lock(myArrayMutex);
+    myUpdateEnded.wait(lock, [this]() { return !myUpdating; });
+    myUpdating = true;
+    for (int a = 0; a < FLOAT_ARRAYS; a++)
+        myStagedFloats[a] = myFloats[a];
+    myStagedColors = myColors;
+    myStagedVisible = myVisible;
+}
+
+/**
+ * \brief Swaps in the arrays written since beginUpdate(), and uploads them the next frame.
+ * \param changed The Attributes that were written, or'd together, such as <code>DrawableStore::POSITION</code>.
+ *   The other arrays are left as they were.
+ */
+void DrawableStore::endUpdate(unsigned changed) {
+    myArrayMutex.lock();
+    if (!myUpdating) {
+        myArrayMutex.unlock();
+        TsglDebug("Cannot end an update that was never begun.");
+        return;
+    }
+    unsigned n = myHandles.size();
+    for (int a = 0; a < FLOAT_ARRAYS; a++) {
+        if (changed & (1 << a)) {
+            myFloats[a].swap(myStagedFloats[a]);
+            myBuffers[a].invalidate(0, n * sizeof(GLfloat));
+        }
+    }
+    if (changed & COLOR) {
+        myColors.swap(myStagedColors);
+        myBuffers[FLOAT_ARRAYS].invalidate(0, n * 4);
+    }
+    if (changed & VISIBLE) {
+        myVisible.swap(myStagedVisible);
+        myBuffers[FLOAT_ARRAYS + 1].invalidate(0, n);
+    }
+    myUpdating = false;
+    myArrayMutex.unlock();
+    myUpdateEnded.notify_all();
+    markDirty();
+}
+
+}
@@ -0,0 +1,193 @@
+/*
+ * DrawableStore.h extends Drawable and provides a container for very large numbers of simple objects.
+ */
+
+#ifndef DRAWABLESTORE_H_
+#define DRAWABLESTORE_H_
+
+#include "Drawable.h"         // For extending our Drawable object
+#include "GpuBuffer.h"        // For keeping the meshes and instance arrays on the GPU
+#include "HandleTable.h"      // For stable handles to instances
+#include "InstrumentedMutex.h" // For locking the instance arrays
+#include "VertexFormat.h"     // For packing colors
+#include <condition_variable> // For waiting for an update to end
+#include <vector>             // For the instance arrays
+
+namespace tsgl {
+
+/*! \class DrawableStore
+ *  \brief Draw hundreds of thousands of simple objects, stored as arrays rather than as separate Drawables.
+ *  \details A DrawableStore holds a few meshes and many instances of them. Each instance has a position,
+ *   a rotation, a uniform scale, a color and a visibility flag. Rather than one heap-allocated object per
+ *   instance, each of these is kept in its own contiguous array (x coordinates together, then y coordinates,
+ *   and so on), and each mesh is drawn with a single instanced draw call.
+ *  \details Instances are referred to by Handles, which stay valid while other instances come and go.
+ *   Adding and removing instances is O(number of meshes).
+ *  \details To update many instances at once, call beginUpdate(), write straight into the arrays it hands out
+ *   (for instance from an OpenMP <code>parallel for simd</code> loop over getSize() elements), and then call
+ *   endUpdate() with the attributes that changed. The arrays are a staging copy, so frames go on being drawn
+ *   from the previous values meanwhile; endUpdate() swaps the changed ones in, and only those are uploaded the
+ *   next frame.
+ *  \details Instances of the same mesh are contiguous, in mesh order. Removing an instance moves others, so
+ *   hold on to Handles rather than indices across add() and remove().
+ *  \details Positions are relative to the DrawableStore's center, and the whole store can be moved and rotated
+ *   like any other Drawable. Mesh vertices are relative to each instance's position.
+ *  \note DrawableStores are drawn with Canvas' instanced shader, and can be added to a Canvas alongside any
+ *   other Drawables.
+ */
+class DrawableStore : public Drawable {
+ public:
+    /*!
+     * \brief Attributes of an instance, as flags for endUpdate().
+     */
+    enum Attribute {
+        X = 1 << 0, Y = 1 << 1, Z = 1 << 2,
+        YAW = 1 << 3, PITCH = 1 << 4, ROLL = 1 << 5,
+        SCALE = 1 << 6, COLOR = 1 << 7, VISIBLE = 1 << 8,
+        POSITION = X | Y | Z,
+        ROTATION = YAW | PITCH | ROLL,
+        ALL_ATTRIBUTES = (1 << 9) - 1
+    };
+ private:
+    enum { FLOAT_ARRAYS = 7, ARRAYS = 9 };  // X through SCALE are floats; then COLOR and VISIBLE
+
+    struct MeshRange {
+        int firstVertex, numVertices;
+        GLenum mode;
+        unsigned firstInstance, numInstances;
+    };
+
+    std::vector<GLfloat> myMeshVertices;          // Positions of every mesh, one after another
+    std::vector<MeshRange> myMeshes;
+    GpuBuffer myMeshBuffer{GL_STATIC_DRAW};
+
+    InstrumentedMutex myArrayMutex{"DrawableStore::arrayMutex"};
+    HandleTable myHandles;
+    std::vector<GLfloat> myFloats[FLOAT_ARRAYS];   // One array per float attribute
+    std::vector<GLubyte> myColors;                // Four per instance
+    std::vector<GLubyte> myVisible;
+    std::vector<uint16_t> myMeshIds;
+    GpuBuffer myBuffers[ARRAYS];
+
+    std::vector<GLfloat> myStagedFloats[FLOAT_ARRAYS];  // Written between beginUpdate() and endUpdate()
+    std::vector<GLubyte> myStagedColors;
+    std::vector<GLubyte> myStagedVisible;
+    bool myUpdating = false;                      // Whether beginUpdate() has been called without endUpdate()
+    std::condition_variable_any myUpdateEnded;
+
+    void swapInstances(unsigned a, unsigned b);
+    void invalidateInstance(unsigned index);
+    void resizeArrays(unsigned size);
+    void lockForResize();
+ public:
+    DrawableStore(float x, float y, float z, float yaw, float pitch, float roll);
+
+    virtual void draw(Shader * shader);
+
+    int addMesh(int numVertices, const GLfloat positions[], GLenum mode = GL_TRIANGLES);
+
+    Handle add(int mesh, float x, float y, float z, ColorFloat color, float scale = 1);
+
+    void remove(Handle h);
+
+    void clear();
+
+    bool contains(Handle h);
+
+    void setPosition(Handle h, float x, float y, float z);
+
+    void setRotation(Handle h, float yaw, float pitch, float roll);
+
+    void setScale(Handle h, float scale);
+
+    void setInstanceColor(Handle h, ColorFloat color);
+
+    void setVisible(Handle h, bool visible);
+
+    float getX(Handle h);
+    float getY(Handle h);
+    float getZ(Handle h);
+
+    int getMesh(Handle h);
+
+    void beginUpdate();
+
+    void endUpdate(unsigned changed);
+
+    /*!
+     * \brief Accessor for the number of instances.
+     * \note Only stable between beginUpdate() and endUpdate().
+     */
+    unsigned getSize() { return myHandles.size(); }
+
+    /*!
+     * \brief Accessor for the index of an instance in the arrays.
+     * \return The index, or UINT32_MAX if the Handle is stale.
+     * \note Only stable between beginUpdate() and endUpdate().
+     */
+    unsigned indexOf(Handle h) { return myHandles.indexOf(h); }
+
+    /*!
+     * \brief Accessor for the Handle of the instance at an index of the arrays.
+     * \note Only stable between beginUpdate() and endUpdate().
+     */
+    Handle handleAt(unsigned index) { return myHandles.handleAt(index); }
+
+    /*!
+     * \brief Accessor for the array of x coordinates, one per instance.
+     * \note Only valid between beginUpdate() and endUpdate().
+     */
+    GLfloat* getXs() { return myStagedFloats[0].data(); }
+
+    /*!
+     * \brief Accessor for the array of y coordinates, one per instance.
+     * \note Only valid between beginUpdate() and endUpdate().
+     */
+    GLfloat* getYs() { return myStagedFloats[1].data(); }
+
+    /*!
+     * \brief Accessor for the array of z coordinates, one per instance.
+     * \note Only valid between beginUpdate() and endUpdate().
+     */
+    GLfloat* getZs() { return myStagedFloats[2].data(); }
+
+    /*!
+     * \brief Accessor for the array of yaws in degrees, one per instance.
+     * \note Only valid between beginUpdate() and endUpdate().
+     */
+    GLfloat* getYaws() { return myStagedFloats[3].data(); }
+
+    /*!
+     * \brief Accessor for the array of pitches in degrees, one per instance.
+     * \note Only valid between beginUpdate() and endUpdate().
+     */
+    GLfloat* getPitches() { return myStagedFloats[4].data(); }
+
+    /*!
+     * \brief Accessor for the array of rolls in degrees, one per instance.
+     * \note Only valid between beginUpdate() and endUpdate().
+     */
+    GLfloat* getRolls() { return myStagedFloats[5].data(); }
+
+    /*!
+     * \brief Accessor for the array of scales, one per instance.
+     * \note Only valid between beginUpdate() and endUpdate().
+     */
+    GLfloat* getScales() { return myStagedFloats[6].data(); }
+
+    /*!
+     * \brief Accessor for the array of colors, four bytes (red, green, blue, alpha) per instance.
+     * \note Only valid between beginUpdate() and endUpdate().
+     */
+    GLubyte* getColorBytes() { return myStagedColors.data(); }
+
+    /*!
+     * \brief Accessor for the array of visibility flags (0 or 1), one per instance.
+     * \note Only valid between beginUpdate() and endUpdate().
+     */
+    GLubyte* getVisibility() { return myStagedVisible.data(); }
+};
+
+}
+
+#endif /* DRAWABLESTORE_H_ */
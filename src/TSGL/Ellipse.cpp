@@ -1,4 +1,5 @@
 #include "Ellipse.h"
+#include "Circle.h"
 
 namespace tsgl {
 
@@ -15,20 +16,16 @@ namespace tsgl {
  *   \param roll The Ellipse's roll in 3D space.
  *   \param color The color of the Ellipse's fill.
  */
-Ellipse::Ellipse(float x, float y, float z, GLfloat xRadius, GLfloat yRadius, float yaw, float pitch, float roll, ColorFloat color) : ConvexPolygon(x,y,z,(xRadius + yRadius) / 2 + 5 + 1,yaw,pitch,roll) {
+Ellipse::Ellipse(float x, float y, float z, GLfloat xRadius, GLfloat yRadius, float yaw, float pitch, float roll, ColorFloat color) : ConvexPolygon(x,y,z,(xRadius + yRadius) / 2 + 5 + 1,yaw,pitch,roll,MeshOnly()) {
     attribMutex.lock();
     myXScale = myXRadius = xRadius;
     myYScale = myYRadius = yRadius;
     myZScale = 1;
     verticesPerColor = ((xRadius + yRadius) / 2 + 6) / 8;
-    numberOfOutlineVertices = numberOfVertices - 1;
+    myFixedSegments = numberOfVertices - 2;
     attribMutex.unlock();
-    addVertex(0,0,0,color);
-    float delta = 2.0f / (numberOfVertices - 2) * PI;
-    for (int i = 0; i < numberOfVertices - 1; ++i) {
-        addVertex(cos(i*delta), sin(i*delta), 0, color);
-        addOutlineVertex(cos(i*delta), sin(i*delta), 0, GRAY);
-    }
+    enableDetail(std::max(xRadius, yRadius));
+    setColor(color);
 }
 
 /*!
@@ -44,20 +41,25 @@ Ellipse::Ellipse(float x, float y, float z, GLfloat xRadius, GLfloat yRadius, fl
  *   \param roll The Ellipse's roll in 3D space.
  *   \param color An array of colors for the Ellipse's fill.
  */
-Ellipse::Ellipse(float x, float y, float z, GLfloat xRadius, GLfloat yRadius, float yaw, float pitch, float roll, ColorFloat color[]) : ConvexPolygon(x,y,z,(xRadius + yRadius) / 2 + 5 + 1,yaw,pitch,roll) {
+Ellipse::Ellipse(float x, float y, float z, GLfloat xRadius, GLfloat yRadius, float yaw, float pitch, float roll, ColorFloat color[]) : ConvexPolygon(x,y,z,(xRadius + yRadius) / 2 + 5 + 1,yaw,pitch,roll,MeshOnly()) {
     attribMutex.lock();
     myXScale = myXRadius = xRadius;
     myYScale = myYRadius = yRadius;
     myZScale = 1;
     verticesPerColor = ((xRadius + yRadius) / 2 + 6) / 8;
-    numberOfOutlineVertices = numberOfVertices - 1;
+    myFixedSegments = numberOfVertices - 2;
+    tessellate(myFixedSegments);
     attribMutex.unlock();
-    addVertex(0,0,0,color[0]);
-    float delta = 2.0f / (numberOfVertices - 2) * PI;
-    for (int i = 0; i < numberOfVertices - 1; ++i) {
-        addVertex(cos(i*delta), sin(i*delta), 0, color[(int) ((float) i / verticesPerColor + 1)]);
-        addOutlineVertex(cos(i*delta), sin(i*delta), 0, GRAY);
-    }
+    setColor(color);
+}
+
+/*!
+ * \brief Switches the Ellipse to the circle mesh with the given number of segments.
+ * \details Called with <code>attribMutex</code> held.
+ *   \param segments The number of segments around the Ellipse.
+ */
+void Ellipse::tessellate(int segments) {
+    setMesh(SharedMesh::acquire(MESH_CIRCLE, segments + 2, 0, Circle::buildMesh));
 }
 
 /**
@@ -73,6 +75,7 @@ void Ellipse::setXRadius(GLfloat xRadius) {
     myXRadius = xRadius;
     myXScale = xRadius;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -88,6 +91,7 @@ void Ellipse::changeXRadiusBy(GLfloat delta) {
     myXRadius += delta;
     myXScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -103,6 +107,7 @@ void Ellipse::setYRadius(GLfloat yRadius) {
     myYRadius = yRadius;
     myYScale = yRadius;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -118,6 +123,7 @@ void Ellipse::changeYRadiusBy(GLfloat delta) {
     myYRadius += delta;
     myYScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -125,24 +131,21 @@ void Ellipse::changeYRadiusBy(GLfloat delta) {
  * \param c An array of the new ColorFloats.
  */
 void Ellipse::setColor(ColorFloat c[]) {
+    disableDetail();
     attribMutex.lock();
     myAlpha = 0.0f;
-    vertices[3] = c[0].R;
-    vertices[4] = c[0].G;
-    vertices[5] = c[0].B;
-    vertices[6] = c[0].A;
+    setVertexColor(0, c[0]);
     myAlpha += c[0].A;
     int colorIndex;
     for (int i = 1; i < numberOfVertices; ++i) {
         colorIndex = (int) ((float) (i - 1) / verticesPerColor + 1);
-        vertices[i*7 + 3] = c[colorIndex].R;
-        vertices[i*7 + 4] = c[colorIndex].G;
-        vertices[i*7 + 5] = c[colorIndex].B;
-        vertices[i*7 + 6] = c[colorIndex].A;
+        setVertexColor(i, c[colorIndex]);
         myAlpha += c[colorIndex].A;
     }
     myAlpha /= numberOfVertices;
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -154,7 +157,7 @@ void Ellipse::setColor(ColorFloat c[]) {
 void Ellipse::getColors(std::vector<ColorFloat> &colorVec) { 
     attribMutex.lock();
     for (int i = 0; i < numberOfVertices; i+=verticesPerColor) {
-        colorVec.push_back(ColorFloat(vertices[i*7+3],vertices[i*7+4],vertices[i*7+5],vertices[i*7+6]));
+        colorVec.push_back(getVertexColor(i));
     }
     attribMutex.unlock();
 }
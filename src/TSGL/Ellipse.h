@@ -17,6 +17,8 @@ class Ellipse : public ConvexPolygon {
  private:
     GLfloat myXRadius, myYRadius;
     GLfloat verticesPerColor;
+ protected:
+    virtual void tessellate(int segments);
  public:
     Ellipse(float x, float y, float z, GLfloat xRadius, GLfloat yRadius, float yaw, float pitch, float roll, ColorFloat color);
 
@@ -1,4 +1,5 @@
 #include "Ellipsoid.h"
+#include "Sphere.h"
 
 namespace tsgl {
 
@@ -29,46 +30,13 @@ Ellipsoid::Ellipsoid(float x, float y, float z, GLfloat xRadius, GLfloat yRadius
     myXScale = xRadius;
     myYScale = yRadius;
     myZScale = zRadius;
-    verticalSections = 36;
-    horizontalSections = 20;
+    myFixedSegments = 36;
     geometryType = GL_TRIANGLE_STRIP;
-    numberOfVertices = verticalSections*horizontalSections*2 + 1;
-    vertices = new GLfloat[numberOfVertices * 7];
     outlineGeometryType = GL_LINES;
-    numberOfOutlineVertices = verticalSections*horizontalSections*4 + 1;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
     isOutlined = false;
     attribMutex.unlock();
-	for(float b=0;b<horizontalSections;b++)
-	{
-		for(float a=0;a<verticalSections;a++)
-		{
-			addVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), ColorFloat(c.R * (1 - 1 * sin(a/verticalSections * PI) / 2), c.G * (1 - 1 * sin(a/verticalSections * PI) / 2), c.B * (1 - 1 * sin(a/verticalSections * PI) / 2), c.A));
-			addVertex(sin((a*PI)/(verticalSections/2))*sin(((b+1)*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos(((b+1)*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), ColorFloat(c.R * (1 - 1 * sin(a/verticalSections * PI) / 2), c.G * (1 - 1 * sin(a/verticalSections * PI) / 2), c.B * (1 - 1 * sin(a/verticalSections * PI) / 2), c.A));
-		}
-	}
-    addVertex(0, 1, 0, c);
-
-    // horizontal outline
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin(((b+1)*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos(((b+1)*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-		}
-	}
-    
-    // vertical outline
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-			addOutlineVertex(sin(((a+1)*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos(((a+1)*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin(((a+1)*PI)/(verticalSections/2)), GRAY);
-		}
-	}
-    addOutlineVertex(0, 1, 0, GRAY);
+    enableDetail(std::max(xRadius, std::max(yRadius, zRadius)));
+    setColor(c);
 }
 
  /*!
@@ -98,46 +66,24 @@ Ellipsoid::Ellipsoid(float x, float y, float z, GLfloat xRadius, GLfloat yRadius
     myXScale = xRadius;
     myYScale = yRadius;
     myZScale = zRadius;
-    verticalSections = 36;
-    horizontalSections = 20;
+    myFixedSegments = 36;
     geometryType = GL_TRIANGLE_STRIP;
-    numberOfVertices = verticalSections*horizontalSections*2 + 1;
-    vertices = new GLfloat[numberOfVertices * 7];
     outlineGeometryType = GL_LINES;
-    numberOfOutlineVertices = verticalSections*horizontalSections*4 + 1;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
     isOutlined = false;
+    tessellate(myFixedSegments);
     attribMutex.unlock();
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			addVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), c[b]);
-			addVertex(sin((a*PI)/(verticalSections/2))*sin(((b+1)*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos(((b+1)*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), c[b]);
-		}
-	}
-    addVertex(0, 1, 0, c[horizontalSections-1]);
-
-    // horizontal outline
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin(((b+1)*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos(((b+1)*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-		}
-	}
+    setColor(c);
+}
 
-    // vertical outline
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-			addOutlineVertex(sin(((a+1)*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos(((a+1)*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin(((a+1)*PI)/(verticalSections/2)), GRAY);
-		}
-	}
-    addOutlineVertex(0, 1, 0, GRAY);
+ /*!
+  * \brief Switches the Ellipsoid to the sphere mesh with the given number of segments around.
+  * \details Called with <code>attribMutex</code> held.
+  *   \param segments The number of vertical sections; the number of horizontal sections follows from it.
+  */
+void Ellipsoid::tessellate(int segments) {
+    verticalSections = segments;
+    horizontalSections = segments / 2 + 2;
+    setMesh(SharedMesh::acquire(MESH_SPHERE, verticalSections, horizontalSections, Sphere::buildMesh));
 }
 
 /**
@@ -153,6 +99,7 @@ void Ellipsoid::setXRadius(GLfloat radiusX) {
     myXRadius = radiusX;
     myXScale = radiusX;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -168,6 +115,7 @@ void Ellipsoid::changeXRadiusBy(GLfloat delta) {
     myXRadius += delta;
     myXScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -183,6 +131,7 @@ void Ellipsoid::setYRadius(GLfloat radiusY) {
     myYRadius = radiusY;
     myYScale = radiusY;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -198,6 +147,7 @@ void Ellipsoid::changeYRadiusBy(GLfloat delta) {
     myYRadius += delta;
     myYScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -213,6 +163,7 @@ void Ellipsoid::setZRadius(GLfloat radiusZ) {
     myZRadius = radiusZ;
     myZScale = radiusZ;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -228,34 +179,7 @@ void Ellipsoid::changeZRadiusBy(GLfloat delta) {
     myZRadius += delta;
     myZScale += delta;
     attribMutex.unlock();
-}
-
-/**
- * \brief Sets the Ellipsoid to a new color.
- * \param c The new ColorFloat.
- */
-void Ellipsoid::setColor(ColorFloat c) {
-    attribMutex.lock();
-    myAlpha = c.A;
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			vertices[(b*verticalSections + a)*2*7 + 3] = c.R * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 4] = c.G * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 5] = c.B * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 6] = c.A;
-			vertices[(b*verticalSections + a)*2*7 + 10] = c.R * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 11] = c.G * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 12] = c.B * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 13] = c.A;
-		}
-	}
-    vertices[horizontalSections*verticalSections*2*7+3] = c.R;
-    vertices[horizontalSections*verticalSections*2*7+4] = c.G;
-    vertices[horizontalSections*verticalSections*2*7+5] = c.B;
-    vertices[horizontalSections*verticalSections*2*7+6] = c.A;
-    attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -264,30 +188,24 @@ void Ellipsoid::setColor(ColorFloat c) {
  * \details The array should have 20 ColorFloat minimum, one for each horizontal section.
  */
 void Ellipsoid::setColor(ColorFloat c[]) {
+    disableDetail();
     attribMutex.lock();
     myAlpha = 0.0;
 	for(int b=0;b<horizontalSections;b++)
 	{
 		for(int a=0;a<verticalSections;a++)
 		{
-			vertices[(b*verticalSections + a)*2*7 + 3] = c[b].R;
-            vertices[(b*verticalSections + a)*2*7 + 4] = c[b].G;
-            vertices[(b*verticalSections + a)*2*7 + 5] = c[b].B;
-            vertices[(b*verticalSections + a)*2*7 + 6] = c[b].A;
-			vertices[(b*verticalSections + a)*2*7 + 10] = c[b].R;
-            vertices[(b*verticalSections + a)*2*7 + 11] = c[b].G;
-            vertices[(b*verticalSections + a)*2*7 + 12] = c[b].B;
-            vertices[(b*verticalSections + a)*2*7 + 13] = c[b].A;
+			setVertexColor((b*verticalSections + a)*2, c[b]);
+			setVertexColor((b*verticalSections + a)*2 + 1, c[b]);
             myAlpha += c[b].A * 2;
 		}
 	}
-    vertices[horizontalSections*verticalSections*2*7+3] = c[horizontalSections-1].R;
-    vertices[horizontalSections*verticalSections*2*7+4] = c[horizontalSections-1].G;
-    vertices[horizontalSections*verticalSections*2*7+5] = c[horizontalSections-1].B;
-    vertices[horizontalSections*verticalSections*2*7+6] = c[horizontalSections-1].A;
+    setVertexColor(horizontalSections*verticalSections*2, c[horizontalSections-1]);
     myAlpha += c[horizontalSections-1].A;
     myAlpha /= numberOfVertices;
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -299,12 +217,7 @@ void Ellipsoid::setColor(ColorFloat c[]) {
 void Ellipsoid::getColors(std::vector<ColorFloat> &colorVec) {
     attribMutex.lock();
     for(int b=0;b<horizontalSections;b++) {
-        colorVec.push_back(ColorFloat(
-            vertices[(b*verticalSections)*2*7 + 3],
-            vertices[(b*verticalSections)*2*7 + 4],
-            vertices[(b*verticalSections)*2*7 + 5],
-            vertices[(b*verticalSections)*2*7 + 6])
-            );
+        colorVec.push_back(getVertexColor(b*verticalSections*2));
     }
     attribMutex.unlock();
 }
@@ -18,6 +18,8 @@ class Ellipsoid : public Shape {
 protected:
     GLfloat myXRadius, myYRadius, myZRadius;
     int horizontalSections, verticalSections;
+
+    virtual void tessellate(int segments);
 public:
     Ellipsoid(float x, float y, float z, GLfloat xRadius, GLfloat yRadius, GLfloat zRadius, float yaw, float pitch, float roll, ColorFloat c);
 
@@ -41,7 +43,7 @@ public:
 
     virtual GLfloat getZRadius() { return myZRadius; }
 
-    virtual void setColor(ColorFloat c);
+    virtual void setColor(ColorFloat c) { Shape::setColor(c); }
 
     virtual void setColor(ColorFloat c[]);
 
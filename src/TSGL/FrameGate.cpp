@@ -0,0 +1,101 @@
+#include "FrameGate.h"
+
+#include <utility>
+#include <vector>
+
+namespace tsgl {
+
+namespace {
+    // The number of transactions the calling thread has open on each FrameGate
+    thread_local std::vector<std::pair<const FrameGate*, unsigned>> openDepths;
+
+    unsigned& depthOn(const FrameGate* gate) {
+        for (unsigned i = 0; i < openDepths.size(); ++i)
+            if (openDepths[i].first == gate)
+                return openDepths[i].second;
+        openDepths.push_back(std::make_pair(gate, 0u));
+        return openDepths.back().second;
+    }
+
+    void forget(const FrameGate* gate) {
+        for (unsigned i = 0; i < openDepths.size(); ++i) {
+            if (openDepths[i].first == gate) {
+                openDepths[i] = openDepths.back();
+                openDepths.pop_back();
+                return;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Opens a transaction.
+ * \details Blocks while a frame is being drawn or the rendering thread is waiting to draw one, unless the calling
+ *   thread already has a transaction open, in which case the new one is nested in it and opens right away.
+ */
+void FrameGate::beginUpdate() {
+    unsigned& depth = depthOn(this);
+    if (depth > 0) {
+        std::lock_guard<std::mutex> lock(myMutex);
+        ++myOpenUpdates;
+    } else {
+        openUpdate();
+    }
+    ++depth;
+}
+
+/*!
+ * \brief Opens a transaction on behalf of another thread.
+ * \details Blocks like beginUpdate() on a thread with no transaction open. The transaction does not belong to
+ *   the calling thread; the thread that finishes it calls adoptUpdate() and then endUpdate().
+ */
+void FrameGate::openUpdate() {
+    std::unique_lock<std::mutex> lock(myMutex);
+    myCondition.wait(lock, [this]() { return !myDrawing && !myFrameWaiting; });
+    ++myOpenUpdates;
+}
+
+/*!
+ * \brief Makes a transaction opened with openUpdate() the calling thread's own.
+ * \details Transactions the thread opens from then on until endUpdate() are nested in it.
+ */
+void FrameGate::adoptUpdate() {
+    ++depthOn(this);
+}
+
+/*!
+ * \brief Closes a transaction.
+ * \details Wakes up the rendering thread if this was the last transaction open.
+ */
+void FrameGate::endUpdate() {
+    unsigned& depth = depthOn(this);
+    if (depth > 0 && --depth == 0)
+        forget(this);
+    std::lock_guard<std::mutex> lock(myMutex);
+    if (myOpenUpdates > 0 && --myOpenUpdates == 0)
+        myCondition.notify_all();
+}
+
+/*!
+ * \brief Starts a frame.
+ * \details Called by the rendering thread. Blocks until every open transaction is closed.
+ */
+void FrameGate::beginFrame() {
+    std::unique_lock<std::mutex> lock(myMutex);
+    myFrameWaiting = true;
+    myCondition.wait(lock, [this]() { return myOpenUpdates == 0; });
+    myFrameWaiting = false;
+    myDrawing = true;
+}
+
+/*!
+ * \brief Ends a frame.
+ * \details Called by the rendering thread. Wakes up every thread waiting to open a transaction.
+ */
+void FrameGate::endFrame() {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myDrawing = false;
+    myCondition.notify_all();
+}
+
+}
@@ -0,0 +1,51 @@
+/*
+ * FrameGate.h provides the synchronization between a Canvas' rendering thread and threads updating its scene
+ * in transactions.
+ */
+
+#ifndef FRAMEGATE_H_
+#define FRAMEGATE_H_
+
+#include <condition_variable>  // For blocking without spinning
+#include <mutex>               // Needed by the condition variable
+
+namespace tsgl {
+
+/*! \class FrameGate
+ *  \brief Keeps a Canvas' frames and its update transactions from overlapping.
+ *  \details Threads wrap a group of changes to the scene in beginUpdate() and endUpdate(); the rendering thread
+ *    wraps each frame in beginFrame() and endFrame(). A frame never starts while a transaction is open, and a
+ *    transaction never starts while a frame is being drawn, so every change made in a transaction shows up in the
+ *    same frame.
+ *  \details Transactions do not exclude each other: any number of threads may have one open at once, and a
+ *    thread may nest them. Once the rendering thread is waiting for a frame, though, a new transaction waits for
+ *    that frame to be drawn, so that threads opening transactions back to back cannot starve the rendering
+ *    thread. Only a nested transaction, on a thread that already has one open, goes ahead; a thread must therefore
+ *    not wait for another thread's transaction while it has one open itself.
+ *  \details All waiting is done on a condition variable, so waiting threads use no CPU, and wake up as soon as
+ *    they may proceed. FrameGate only uses the standard library, so it works with threads from any library.
+ */
+class FrameGate {
+ private:
+    std::mutex              myMutex;
+    std::condition_variable myCondition;
+    unsigned                myOpenUpdates = 0;      // Number of transactions open
+    bool                    myDrawing = false;      // Whether a frame is being drawn
+    bool                    myFrameWaiting = false; // Whether the rendering thread is waiting to draw a frame
+ public:
+    void beginUpdate();
+
+    void openUpdate();
+
+    void adoptUpdate();
+
+    void endUpdate();
+
+    void beginFrame();
+
+    void endFrame();
+};
+
+}
+
+#endif /* FRAMEGATE_H_ */
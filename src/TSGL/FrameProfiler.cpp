@@ -0,0 +1,135 @@
+#include "FrameProfiler.h"
+
+#include <fstream>
+
+namespace tsgl {
+
+/*!
+ * \brief Default FrameProfiler constructor method.
+ * \return A new, empty FrameProfiler whose timestamps start now.
+ */
+FrameProfiler::FrameProfiler() {
+    epoch = profileClock::now();
+    head.store(0);
+    frame.store(0);
+}
+
+/*!
+ * \brief Starts a new frame.
+ * \details Every event recorded until the next call is tagged with the new frame number.
+ */
+void FrameProfiler::beginFrame() {
+    frame.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*!
+ * \brief Discards every recorded event.
+ * \note Events recorded while clear() runs may or may not be kept.
+ */
+void FrameProfiler::clear() {
+    head.store(0, std::memory_order_release);
+}
+
+/*!
+ * \brief Accessor for the recorded events.
+ * \return A copy of the (up to) CAPACITY - 1 most recent events, oldest first.
+ */
+std::vector<PhaseEvent> FrameProfiler::getEvents() const {
+    // The slot of event head - CAPACITY is the one the rendering thread writes next, so it is never copied
+    unsigned long last = head.load(std::memory_order_acquire);
+    unsigned long first = (last >= CAPACITY) ? last - CAPACITY + 1 : 0;
+    std::vector<PhaseEvent> snapshot;
+    snapshot.reserve(last - first);
+    for (unsigned long i = first; i < last; ++i)
+      snapshot.push_back(events[i % CAPACITY]);
+
+    // Drop whatever the rendering thread overwrote while we were copying
+    unsigned long now = head.load(std::memory_order_acquire);
+    if (now >= CAPACITY && now - CAPACITY + 1 > first) {
+      unsigned long overwritten = now - CAPACITY + 1 - first;
+      if (overwritten >= snapshot.size())
+        snapshot.clear();
+      else
+        snapshot.erase(snapshot.begin(), snapshot.begin() + overwritten);
+    }
+    return snapshot;
+}
+
+/*!
+ * \brief Accessor for the phase durations of the last complete frame.
+ * \return A vector of PHASE_COUNT durations in microseconds, indexed by FramePhase.
+ *   Phases that did not happen during the frame are 0.
+ */
+std::vector<double> FrameProfiler::getLastFrame() const {
+    std::vector<double> durations(PHASE_COUNT, 0.0);
+    unsigned long current = frame.load(std::memory_order_relaxed);
+    if (current < 2)
+      return durations;
+    std::vector<PhaseEvent> snapshot = getEvents();
+    for (unsigned int i = 0; i < snapshot.size(); ++i)
+      if (snapshot[i].frame == current - 1 && snapshot[i].phase < PHASE_COUNT)
+        durations[snapshot[i].phase] += snapshot[i].duration;
+    return durations;
+}
+
+/*!
+ * \brief Gets the current time on the FrameProfiler's clock.
+ * \return The time in microseconds since the FrameProfiler was created.
+ */
+double FrameProfiler::now() const {
+    return std::chrono::duration<double, std::micro>(profileClock::now() - epoch).count();
+}
+
+/*!
+ * \brief Records a phase.
+ * \details Only one thread (the rendering thread) may call this function.
+ *   \param phase The FramePhase measured.
+ *   \param start When the phase started, as returned by now().
+ *   \param end When the phase ended, as returned by now().
+ */
+void FrameProfiler::record(unsigned int phase, double start, double end) {
+    unsigned long index = head.load(std::memory_order_relaxed);
+    PhaseEvent& event = events[index % CAPACITY];
+    event.phase = phase;
+    event.frame = frame.load(std::memory_order_relaxed);
+    event.start = start;
+    event.duration = end - start;
+    head.store(index + 1, std::memory_order_release);
+}
+
+/*!
+ * \brief Writes the recorded events to a Chrome trace-event file.
+ * \details The file can be opened in chrome://tracing or https://ui.perfetto.dev.
+ *   \param filename The name of the JSON file to write.
+ * \return True if the file was written, false if it could not be opened.
+ */
+bool FrameProfiler::writeChromeTrace(const std::string& filename) const {
+    std::ofstream out(filename.c_str());
+    if (!out)
+      return false;
+    std::vector<PhaseEvent> snapshot = getEvents();
+    out << "{\"traceEvents\":[";
+    for (unsigned int i = 0; i < snapshot.size(); ++i) {
+      if (i > 0) out << ",";
+      out << "\n{\"name\":\"" << phaseName(snapshot[i].phase) << "\",\"cat\":\"frame\",\"ph\":\"X\""
+          << ",\"ts\":" << snapshot[i].start << ",\"dur\":" << snapshot[i].duration
+          << ",\"pid\":1,\"tid\":1,\"args\":{\"frame\":" << snapshot[i].frame << "}}";
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return out.good();
+}
+
+/*!
+ * \brief Gets the name of a FramePhase.
+ *   \param phase The FramePhase.
+ * \return A human-readable name for <code>phase</code>.
+ */
+const char* FrameProfiler::phaseName(unsigned int phase) {
+    static const char* names[PHASE_COUNT] = {
+      "timer sleep", "sync wait", "background drawables", "pixel upload", "MSAA resolve",
+      "readback", "animation", "object sort", "object draw", "capture", "swap"
+    };
+    return (phase < PHASE_COUNT) ? names[phase] : "unknown";
+}
+
+}
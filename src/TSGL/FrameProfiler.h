@@ -0,0 +1,125 @@
+/*
+ * FrameProfiler.h provides low-overhead timers for measuring the phases of a Canvas' frames.
+ */
+
+#ifndef FRAMEPROFILER_H_
+#define FRAMEPROFILER_H_
+
+#include <atomic>        // For the lock-free ring buffer
+#include <chrono>        // For timing
+#include <string>        // For file names
+#include <vector>        // For returning snapshots of the recorded events
+
+namespace tsgl {
+
+/*! \enum FramePhase
+ *  \brief The phases of a frame measured by a FrameProfiler.
+ */
+enum FramePhase {
+    PHASE_TIMER_SLEEP = 0,      // Waiting for the draw timer, or for the scene to change
+    PHASE_SYNC_WAIT,            // Waiting for pauseDrawing() callers to release the Canvas
+    PHASE_BACKGROUND_DRAWABLES, // Drawing the Background's procedural drawables
+    PHASE_PIXEL_UPLOAD,         // Uploading the Background's pixel buffer
+    PHASE_MSAA_RESOLVE,         // Blitting the multisampled Background to a texture
+    PHASE_READBACK,             // Reading the Background back for getPixel()
+    PHASE_ANIMATION,            // Evaluating and applying animation tracks
+    PHASE_OBJECT_SORT,          // Sorting the Canvas' Drawables
+    PHASE_OBJECT_DRAW,          // Drawing the Canvas' Drawables
+    PHASE_CAPTURE,              // Taking screenshots
+    PHASE_SWAP,                 // Swapping buffers
+    PHASE_COUNT
+};
+
+/*! \struct PhaseEvent
+ *  \brief A single measurement taken by a FrameProfiler.
+ *  \details Times are in microseconds since the FrameProfiler was created.
+ */
+struct PhaseEvent {
+    unsigned int  phase;     // The FramePhase measured
+    unsigned long frame;     // The frame during which it was measured
+    double        start;     // When the phase started
+    double        duration;  // How long the phase took
+};
+
+/*! \class FrameProfiler
+ *  \brief A lock-free ring buffer of timed frame phases.
+ *  \details Each Canvas built with <code>TSGL_PROFILE</code> defined (e.g. <code>make PROFILE=1</code>) owns a
+ *    FrameProfiler, which its rendering thread fills through TSGL_PROFILE_PHASE() scopes. Only the last
+ *    <code>CAPACITY</code> events are kept.
+ *  \details Recording never blocks: the rendering thread is the only writer, and readers take a snapshot,
+ *    discarding any event that was overwritten while it was being copied.
+ *  \note Phases are timed on the CPU. Since OpenGL runs asynchronously, GPU work often shows up in the
+ *    phases that wait for it (readback and swap) rather than in the phase that issued it.
+ *  \note Without <code>TSGL_PROFILE</code>, TSGL_PROFILE_PHASE() compiles to nothing and Canvas::getProfiler()
+ *    returns NULL.
+ */
+class FrameProfiler {
+ public:
+    static const unsigned int CAPACITY = 8192;       // Number of events kept
+ private:
+    typedef std::chrono::high_resolution_clock profileClock;
+
+    PhaseEvent                  events[CAPACITY];
+    std::atomic<unsigned long>  head;                // Total number of events recorded
+    std::atomic<unsigned long>  frame;               // Current frame number
+    profileClock::time_point    epoch;
+ public:
+    FrameProfiler();
+
+    void beginFrame();
+
+    void clear();
+
+    std::vector<PhaseEvent> getEvents() const;
+
+    std::vector<double> getLastFrame() const;
+
+    double now() const;
+
+    void record(unsigned int phase, double start, double end);
+
+    bool writeChromeTrace(const std::string& filename) const;
+
+    static const char* phaseName(unsigned int phase);
+};
+
+/*! \class ScopedPhaseTimer
+ *  \brief Records the time between its construction and destruction in a FrameProfiler.
+ *  \details Use TSGL_PROFILE_PHASE() rather than constructing one directly, so that the timer
+ *    compiles out when profiling is disabled.
+ */
+class ScopedPhaseTimer {
+ private:
+    FrameProfiler * myProfiler;
+    unsigned int myPhase;
+    double myStart;
+ public:
+    /*!
+     * \brief Starts timing a phase.
+     *   \param profiler The FrameProfiler to record into. If NULL, nothing is recorded.
+     *   \param phase The FramePhase being timed.
+     */
+    ScopedPhaseTimer(FrameProfiler * profiler, unsigned int phase)
+      : myProfiler(profiler), myPhase(phase), myStart(profiler ? profiler->now() : 0.0) {}
+
+    /*!
+     * \brief Stops timing the phase and records it.
+     */
+    ~ScopedPhaseTimer() { if (myProfiler) myProfiler->record(myPhase, myStart, myProfiler->now()); }
+};
+
+}
+
+#define TSGL_PROFILE_CONCAT_(a, b) a##b
+#define TSGL_PROFILE_CONCAT(a, b) TSGL_PROFILE_CONCAT_(a, b)
+
+#ifdef TSGL_PROFILE
+  #define TSGL_PROFILE_PHASE(profiler, phase) \
+    tsgl::ScopedPhaseTimer TSGL_PROFILE_CONCAT(tsglPhaseTimer, __LINE__)(profiler, phase)
+  #define TSGL_PROFILE_FRAME(profiler) if (profiler) (profiler)->beginFrame()
+#else
+  #define TSGL_PROFILE_PHASE(profiler, phase)
+  #define TSGL_PROFILE_FRAME(profiler)
+#endif
+
+#endif /* FRAMEPROFILER_H_ */
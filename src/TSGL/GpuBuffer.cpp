@@ -0,0 +1,209 @@
+#include "GpuBuffer.h"
+
+#include <GLFW/glfw3.h>  // For identifying the current GL context
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace tsgl {
+
+namespace {
+    typedef std::vector<std::pair<void*, GLuint> > bufferList;
+
+    // The registries are never destroyed, so that buffers owned by static objects can still be released on exit
+    std::mutex& registryMutex() {
+        static std::mutex* m = new std::mutex();
+        return *m;
+    }
+
+    std::set<GpuBuffer*>& registry() {
+        static std::set<GpuBuffer*>* r = new std::set<GpuBuffer*>();
+        return *r;
+    }
+
+    // Buffers of destroyed GpuBuffers, deleted by the next frame drawn in their context
+    std::mutex& orphanMutex() {
+        static std::mutex* m = new std::mutex();
+        return *m;
+    }
+
+    bufferList& orphans() {
+        static bufferList* o = new bufferList();
+        return *o;
+    }
+}
+
+/*!
+ * \brief Explicit GpuBuffer constructor method.
+ *   \param usage The usage hint passed to glBufferData(): GL_STATIC_DRAW for data that never changes,
+ *     GL_DYNAMIC_DRAW for data that is partially updated.
+ * \return A new GpuBuffer with no buffer in any GL context yet.
+ */
+GpuBuffer::GpuBuffer(GLenum usage) {
+    myUsage = usage;
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().insert(this);
+}
+
+/*!
+ * \brief GpuBuffer destructor method.
+ * \details Hands the buffer of every GL context to collectGarbage().
+ */
+GpuBuffer::~GpuBuffer() {
+    {
+      std::lock_guard<std::mutex> lock(registryMutex());
+      registry().erase(this);
+    }
+    std::lock_guard<std::mutex> lock(orphanMutex());
+    for (std::map<void*, ContextBuffer>::const_iterator it = myBuffers.begin(); it != myBuffers.end(); ++it)
+      orphans().push_back(std::make_pair(it->first, it->second.name));
+}
+
+/*!
+ * \brief Marks a range of the array as changed, in every GL context.
+ * \details The range is uploaded the next time the buffer is bound in each context. Ranges marked between two
+ *   binds are merged into the smallest range covering them all.
+ *   \param offset The offset of the first changed byte.
+ *   \param bytes The number of changed bytes.
+ */
+void GpuBuffer::invalidate(size_t offset, size_t bytes) {
+    if (bytes == 0)
+      return;
+    std::lock_guard<std::mutex> lock(myMutex);
+    for (std::map<void*, ContextBuffer>::iterator it = myBuffers.begin(); it != myBuffers.end(); ++it) {
+      ContextBuffer& b = it->second;
+      if (b.dirtyBegin == b.dirtyEnd) {
+        b.dirtyBegin = offset;
+        b.dirtyEnd = offset + bytes;
+      } else {
+        b.dirtyBegin = std::min(b.dirtyBegin, offset);
+        b.dirtyEnd = std::max(b.dirtyEnd, offset + bytes);
+      }
+    }
+}
+
+/*!
+ * \brief Marks the whole array as changed, in every GL context.
+ */
+void GpuBuffer::invalidateAll() {
+    std::lock_guard<std::mutex> lock(myMutex);
+    for (std::map<void*, ContextBuffer>::iterator it = myBuffers.begin(); it != myBuffers.end(); ++it) {
+      it->second.dirtyBegin = 0;
+      it->second.dirtyEnd = it->second.capacity;
+    }
+}
+
+// Finds the buffer of the current GL context, generating one if there is none yet; called with myMutex held
+GpuBuffer::ContextBuffer& GpuBuffer::currentBuffer(bool& created) {
+    void* context = glfwGetCurrentContext();
+    std::map<void*, ContextBuffer>::iterator it = myBuffers.find(context);
+    created = (it == myBuffers.end());
+    if (created) {
+      ContextBuffer b = { 0, 0, 0, 0 };
+      glGenBuffers(1, &b.name);
+      it = myBuffers.insert(std::make_pair(context, b)).first;
+    }
+    return it->second;
+}
+
+/*!
+ * \brief Binds the buffer of the current GL context to a target, uploading whatever changed first.
+ *   \param target The target to bind to, such as GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER.
+ *   \param data The CPU copy of the array.
+ *   \param bytes The size of the array in bytes.
+ * \note Must be called from a thread with a current GL context.
+ */
+void GpuBuffer::bind(GLenum target, const void* data, size_t bytes) {
+    std::lock_guard<std::mutex> lock(myMutex);
+    bool created;
+    ContextBuffer& b = currentBuffer(created);
+    glBindBuffer(target, b.name);
+    if (created) {
+      glBufferData(target, bytes, data, myUsage);
+      b.capacity = bytes;
+    } else if (b.capacity < bytes) {
+      // Grow geometrically, so that an array appended to every frame is not reallocated every frame
+      b.capacity = std::max(bytes, b.capacity * 2);
+      glBufferData(target, b.capacity, NULL, myUsage);
+      glBufferSubData(target, 0, bytes, data);
+    } else if (b.dirtyBegin < b.dirtyEnd && b.dirtyBegin < bytes) {
+      size_t end = std::min(b.dirtyEnd, bytes);
+      glBufferSubData(target, b.dirtyBegin, end - b.dirtyBegin, (const char*)data + b.dirtyBegin);
+    }
+    b.dirtyBegin = b.dirtyEnd = 0;
+}
+
+/*!
+ * \brief Binds the buffer of the current GL context to a target and maps it for writing the whole array.
+ * \details The previous contents are discarded, so the driver need not wait for draws still reading them.
+ *   Every byte that is drawn must be written before unmap() is called.
+ *   \param target The target to bind to, such as GL_ARRAY_BUFFER.
+ *   \param bytes The size of the array in bytes.
+ * \return A pointer to write the array to, or NULL if the buffer could not be mapped.
+ * \note Must be called from a thread with a current GL context.
+ */
+void* GpuBuffer::map(GLenum target, size_t bytes) {
+    std::lock_guard<std::mutex> lock(myMutex);
+    bool created;
+    ContextBuffer& b = currentBuffer(created);
+    glBindBuffer(target, b.name);
+    if (created || b.capacity < bytes) {
+      glBufferData(target, bytes, NULL, myUsage);
+      b.capacity = bytes;
+    }
+    b.dirtyBegin = b.dirtyEnd = 0;
+    if (bytes == 0)
+      return NULL;
+    return glMapBufferRange(target, 0, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+}
+
+/*!
+ * \brief Unmaps the buffer mapped by map(), which must still be bound to the target.
+ *   \param target The target the buffer was mapped through.
+ */
+void GpuBuffer::unmap(GLenum target) {
+    glUnmapBuffer(target);
+}
+
+/*!
+ * \brief Deletes the buffers of destroyed GpuBuffers that belong to the current GL context.
+ * \details Called by Canvas once per frame.
+ * \note Must be called from a thread with a current GL context.
+ */
+void GpuBuffer::collectGarbage() {
+    void* context = glfwGetCurrentContext();
+    std::lock_guard<std::mutex> lock(orphanMutex());
+    bufferList& list = orphans();
+    for (unsigned int i = 0; i < list.size(); ) {
+      if (list[i].first == context) {
+        glDeleteBuffers(1, &list[i].second);
+        list[i] = list.back();
+        list.pop_back();
+      } else {
+        ++i;
+      }
+    }
+}
+
+/*!
+ * \brief Deletes every GpuBuffer's buffer in the current GL context.
+ * \details Called by Canvas just before it destroys its context, so that a later context created at the
+ *   same address does not inherit stale buffer names.
+ * \note Must be called from a thread with a current GL context.
+ */
+void GpuBuffer::releaseContext() {
+    void* context = glfwGetCurrentContext();
+    collectGarbage();
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for (std::set<GpuBuffer*>::iterator it = registry().begin(); it != registry().end(); ++it) {
+      std::lock_guard<std::mutex> bufferLock((*it)->myMutex);
+      std::map<void*, ContextBuffer>::iterator b = (*it)->myBuffers.find(context);
+      if (b != (*it)->myBuffers.end()) {
+        glDeleteBuffers(1, &b->second.name);
+        (*it)->myBuffers.erase(b);
+      }
+    }
+}
+
+}
@@ -0,0 +1,68 @@
+/*
+ * GpuBuffer.h provides a GL buffer object that is created in each GL context it is used in,
+ * and that re-uploads only the ranges that changed.
+ */
+
+#ifndef GPUBUFFER_H_
+#define GPUBUFFER_H_
+
+#include <GL/glew.h>     // Needed for GL function calls
+#include <cstddef>       // For size_t
+#include <map>           // For the buffer of each GL context
+#include <mutex>         // For locking the buffers
+
+namespace tsgl {
+
+/*! \class GpuBuffer
+ *  \brief A GL buffer object mirroring an array kept on the CPU.
+ *  \details A GpuBuffer does not hold the data itself; its owner passes its CPU copy to bind() every time the
+ *    buffer is bound. The first bind in a GL context creates a buffer in that context and uploads the whole array.
+ *    After that, only the byte ranges marked with invalidate() are uploaded again, with glBufferSubData().
+ *    If the array outgrows the buffer, the buffer is reallocated at twice its size (or more) and the whole array
+ *    is uploaded again.
+ *  \details Owners that have no CPU copy, or rewrite the whole array every frame, can instead map() the buffer
+ *    and write the array straight into GPU memory.
+ *  \details Buffers cannot be deleted in the destructor, since the owner may be destroyed on a thread without
+ *    a GL context. They are deleted by collectGarbage() the next time their context draws a frame instead.
+ *  \note GpuBuffer is used by SharedMesh and by Drawables that keep their vertices on the GPU between frames,
+ *    such as Mesh.
+ */
+class GpuBuffer {
+ private:
+    struct ContextBuffer {
+        GLuint name;
+        size_t capacity;                 // Bytes allocated on the GPU
+        size_t dirtyBegin, dirtyEnd;     // Byte range changed since the last upload; empty if equal
+    };
+
+    std::map<void*, ContextBuffer> myBuffers;  // Buffer of each GL context
+    std::mutex myMutex;
+    GLenum myUsage;
+
+    ContextBuffer& currentBuffer(bool& created);
+ public:
+    explicit GpuBuffer(GLenum usage = GL_STATIC_DRAW);
+
+    ~GpuBuffer();
+
+    GpuBuffer(const GpuBuffer&) = delete;
+    GpuBuffer& operator=(const GpuBuffer&) = delete;
+
+    void invalidate(size_t offset, size_t bytes);
+
+    void invalidateAll();
+
+    void bind(GLenum target, const void* data, size_t bytes);
+
+    void* map(GLenum target, size_t bytes);
+
+    void unmap(GLenum target);
+
+    static void collectGarbage();
+
+    static void releaseContext();
+};
+
+}
+
+#endif /* GPUBUFFER_H_ */
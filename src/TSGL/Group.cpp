@@ -0,0 +1,251 @@
+#include "Group.h"
+
+namespace tsgl {
+
+ /*!
+  * \brief Explicitly constructs a new, empty Group.
+  * \details This is the constructor for the Group class.
+  *   \param x The x coordinate of the center of the Group.
+  *   \param y The y coordinate of the center of the Group.
+  *   \param z The z coordinate of the center of the Group.
+  *   \param yaw The Group's yaw.
+  *   \param pitch The Group's pitch.
+  *   \param roll The Group's roll.
+  * \return A new Group with no children.
+  */
+Group::Group(float x, float y, float z, float yaw, float pitch, float roll) : Drawable(x,y,z,yaw,pitch,roll) {
+    attribMutex.lock();
+    shaderType = SHAPE_SHADER_TYPE;
+    myXScale = myYScale = myZScale = 1;
+    myWorld = glm::mat4(1.0f);
+    init = true;
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Draw the Group.
+ * \details This function actually draws the Group's children to the Canvas: first the batch, with the Group's
+ *   model matrix, and then each child that could not be batched, with its cached world matrix.
+ * \note This function overrides Drawable::draw()
+ */
+void Group::draw(Shader * shader) {
+    glm::mat4 world = modelMatrix();
+    myChildMutex.lock();
+    if (world != myWorld) {
+        myWorld = world;
+        myWorldSerial++;
+    }
+    if (!updateBatch())
+        rebuildBatch();
+    drawBatch(shader);
+    for (unsigned i = 0; i < myChildren.size(); i++) {
+        Child& c = myChildren[i];
+        if (c.batched)
+            continue;
+        unsigned version = c.drawable->getVersion();
+        if (version != c.version || c.worldSerial != myWorldSerial) {
+            c.world = myWorld * c.drawable->modelMatrix();
+            c.version = version;
+            c.worldSerial = myWorldSerial;
+        }
+        if (c.drawable->isProcessed()) {
+            c.drawable->setModelOverride(&c.world);
+            c.drawable->draw(shader);
+            c.drawable->setModelOverride(nullptr);
+        }
+    }
+    myChildMutex.unlock();
+}
+
+/*!
+ * \brief Re-transforms the batched children that changed since the last frame, in place.
+ * \details Called with myChildMutex held.
+ * \return False if the batch must be rebuilt instead, because it is stale or a child's vertex count or primitive
+ *   modes changed.
+ */
+bool Group::updateBatch() {
+    if (myBatchStale)
+        return false;
+    static thread_local std::vector<PackedVertex> vertices;
+    static thread_local std::vector<BatchRange> ranges;
+    for (unsigned i = 0; i < myChildren.size(); i++) {
+        Child& c = myChildren[i];
+        if (!c.batched || !c.drawable->isProcessed())
+            continue;
+        unsigned version = c.drawable->getVersion();
+        if (version == c.version)
+            continue;
+        vertices.clear();
+        ranges.clear();
+        if (!c.drawable->appendBatch(vertices, ranges) || vertices.size() != c.numVertices || ranges.size() != c.numRanges)
+            return false;
+        for (unsigned r = 0; r < c.numRanges; r++) {
+            const BatchRange& old = myRanges[c.firstRange + r];
+            if (ranges[r].mode != old.mode || ranges[r].count != old.count)
+                return false;
+        }
+        std::copy(vertices.begin(), vertices.end(), myBatch.begin() + c.firstVertex);
+        myBatchBuffer.invalidate(c.firstVertex * sizeof(PackedVertex), c.numVertices * sizeof(PackedVertex));
+        c.version = version;
+    }
+    return true;
+}
+
+/*!
+ * \brief Transforms every batchable child into the Group's space, from scratch.
+ * \details Called with myChildMutex held. Children that are not processed yet get an empty place in the batch,
+ *   which updateBatch() gives up on, triggering another rebuild, once they are.
+ */
+void Group::rebuildBatch() {
+    myBatch.clear();
+    myRanges.clear();
+    for (unsigned i = 0; i < myChildren.size(); i++) {
+        Child& c = myChildren[i];
+        c.firstVertex = myBatch.size();
+        c.firstRange = myRanges.size();
+        c.version = NEVER_CACHED;
+        if (!c.drawable->isProcessed()) {
+            c.batched = true;
+        } else {
+            unsigned version = c.drawable->getVersion();
+            c.batched = c.drawable->appendBatch(myBatch, myRanges);
+            if (c.batched)
+                c.version = version;
+        }
+        c.numVertices = myBatch.size() - c.firstVertex;
+        c.numRanges = myRanges.size() - c.firstRange;
+    }
+    myBatchBuffer.invalidateAll();
+    myBatchStale = false;
+}
+
+/*!
+ * \brief Draws the batch, merging consecutive ranges with the same primitive mode into one draw call.
+ * \details Called with myChildMutex held.
+ */
+void Group::drawBatch(Shader * shader) {
+    if (myBatch.empty())
+        return;
+    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(myWorld));
+
+    GLint canvasBuffer;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &canvasBuffer);
+    GLint posAttrib = glGetAttribLocation(shader->ID, "aPos");
+    GLint colAttrib = glGetAttribLocation(shader->ID, "aColor");
+
+    myBatchBuffer.bind(GL_ARRAY_BUFFER, myBatch.data(), myBatch.size() * sizeof(PackedVertex));
+    VertexFormat::setLayout(posAttrib, colAttrib);
+    static thread_local std::vector<GLint> firsts;
+    static thread_local std::vector<GLsizei> counts;
+    for (unsigned i = 0; i < myRanges.size(); ) {
+        GLenum mode = myRanges[i].mode;
+        firsts.clear();
+        counts.clear();
+        for (; i < myRanges.size() && myRanges[i].mode == mode; i++) {
+            if (myRanges[i].count > 0) {
+                firsts.push_back(myRanges[i].first);
+                counts.push_back(myRanges[i].count);
+            }
+        }
+        if (!firsts.empty())
+            glMultiDrawArrays(mode, firsts.data(), counts.data(), firsts.size());
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, canvasBuffer);
+    VertexFormat::setLayout(posAttrib, colAttrib);
+}
+
+/**
+ * \brief Adds a child to the Group.
+ * \details The child's center and rotation are taken as relative to the Group's.
+ *   \param child Pointer to the Drawable to add. It must be drawn with the shape shader.
+ */
+void Group::add(Drawable * child) {
+    if (child->getShaderType() != SHAPE_SHADER_TYPE) {
+        TsglDebug("Only Drawables drawn with the shape shader can be added to a Group.");
+        return;
+    }
+    Child c;
+    c.drawable = child;
+    c.version = NEVER_CACHED;
+    c.batched = false;
+    c.firstVertex = c.numVertices = c.firstRange = c.numRanges = 0;
+    c.worldSerial = 0;
+    myChildMutex.lock();
+    myChildren.push_back(c);
+    myBatchStale = true;
+    myChildMutex.unlock();
+    child->setRenderSignal(myRenderSignal);
+    markDirty();
+}
+
+/**
+ * \brief Removes a child from the Group.
+ * \details Does nothing if the Drawable is not a child of the Group.
+ *   \param child Pointer to the Drawable to remove.
+ */
+void Group::remove(Drawable * child) {
+    myChildMutex.lock();
+    for (unsigned i = 0; i < myChildren.size(); i++) {
+        if (myChildren[i].drawable == child) {
+            myChildren.erase(myChildren.begin() + i);
+            myBatchStale = true;
+            break;
+        }
+    }
+    myChildMutex.unlock();
+    child->setRenderSignal(nullptr);
+    markDirty();
+}
+
+/**
+ * \brief Removes every child from the Group.
+ */
+void Group::clear() {
+    myChildMutex.lock();
+    for (unsigned i = 0; i < myChildren.size(); i++)
+        myChildren[i].drawable->setRenderSignal(nullptr);
+    myChildren.clear();
+    myBatchStale = true;
+    myChildMutex.unlock();
+    markDirty();
+}
+
+/*!
+ * \brief Accessor for the number of children in the Group.
+ */
+int Group::getSize() {
+    myChildMutex.lock();
+    int size = myChildren.size();
+    myChildMutex.unlock();
+    return size;
+}
+
+/*!
+ * \brief Lets the Group's curved children adapt their tessellation to their size on screen.
+ * \details Passes the camera position on to each child in the Group's own space.
+ * \note This function overrides Drawable::selectDetail()
+ */
+void Group::selectDetail(const glm::vec3& eye, float pixelsPerUnit) {
+    glm::vec3 localEye = glm::vec3(glm::inverse(modelMatrix()) * glm::vec4(eye, 1.0f));
+    myChildMutex.lock();
+    for (unsigned i = 0; i < myChildren.size(); i++)
+        myChildren[i].drawable->selectDetail(localEye, pixelsPerUnit);
+    myChildMutex.unlock();
+}
+
+/*!
+ * \brief Mutator for the RenderSignal notified when the Group or any of its children changes.
+ * \details Called by Canvas::add() and Canvas::remove(); there is no need to call this directly.
+ * \note This function overrides Drawable::setRenderSignal()
+ */
+void Group::setRenderSignal(RenderSignal * signal) {
+    Drawable::setRenderSignal(signal);
+    myChildMutex.lock();
+    for (unsigned i = 0; i < myChildren.size(); i++)
+        myChildren[i].drawable->setRenderSignal(signal);
+    myChildMutex.unlock();
+}
+
+}
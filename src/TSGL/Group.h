@@ -0,0 +1,76 @@
+/*
+ * Group.h extends Drawable and provides a node for building objects out of other Drawables.
+ */
+
+#ifndef GROUP_H_
+#define GROUP_H_
+
+#include "Drawable.h"         // For extending our Drawable object
+#include "GpuBuffer.h"        // For keeping the batched vertices on the GPU
+#include "InstrumentedMutex.h" // For locking the children
+#include <algorithm>          // For std::copy
+#include <vector>             // For the children and the batch
+
+namespace tsgl {
+
+/*! \class Group
+ *  \brief Draw several Drawables as one object, which can be moved and rotated as a whole.
+ *  \details The centers and rotations of a Group's children are relative to the Group: a child centered at
+ *    (0,0,0) with no rotation sits at the Group's center, and turns with it.
+ *  \details Children that draw plain vertices with the shape shader (Shapes that keep their own vertices,
+ *    ConcavePolygons and Polylines) are transformed into the Group's space once and kept in a single vertex
+ *    buffer, which is drawn with one glMultiDrawArrays() per run of children with the same primitive mode.
+ *    Moving or rotating the Group itself only changes the model matrix; a child's vertices are transformed
+ *    again only after that child changes.
+ *  \details Other children, including Shapes drawn from a SharedMesh and nested Groups, are drawn one by one
+ *    with their world matrix, which is cached and only rebuilt when the child or the Group moves.
+ *  \details Children must use the shape shader, so Text, Image and DrawableStore cannot be added.
+ *  \note A Group does not own its children: they must outlive the Group, or be removed first, and the caller
+ *    deletes them. A child must not be added to a Canvas or to another Group as well.
+ */
+class Group : public Drawable {
+ private:
+    struct Child {
+        Drawable * drawable;
+        unsigned version;           // Drawable::getVersion() when last cached; NEVER_CACHED if never
+        bool batched;
+        unsigned firstVertex, numVertices, firstRange, numRanges;  // Where the child is in the batch
+        unsigned worldSerial;       // myWorldSerial when world was last built
+        glm::mat4 world;            // Cached world matrix of a child drawn by itself
+    };
+
+    static const unsigned NEVER_CACHED = ~0u;
+
+    InstrumentedMutex myChildMutex{"Group::childMutex"};
+    std::vector<Child> myChildren;
+    std::vector<PackedVertex> myBatch;             // Vertices of every batched child, in the Group's space
+    std::vector<BatchRange> myRanges;
+    GpuBuffer myBatchBuffer{GL_DYNAMIC_DRAW};
+    bool myBatchStale = true;                      // Whether the batch must be rebuilt from scratch
+    glm::mat4 myWorld;                             // World matrix of the Group when last drawn
+    unsigned myWorldSerial = 0;                    // Incremented whenever myWorld changes
+
+    bool updateBatch();
+    void rebuildBatch();
+    void drawBatch(Shader * shader);
+ public:
+    Group(float x, float y, float z, float yaw, float pitch, float roll);
+
+    virtual void draw(Shader * shader);
+
+    void add(Drawable * child);
+
+    void remove(Drawable * child);
+
+    void clear();
+
+    int getSize();
+
+    virtual void selectDetail(const glm::vec3& eye, float pixelsPerUnit);
+
+    virtual void setRenderSignal(RenderSignal * signal);
+};
+
+}
+
+#endif /* GROUP_H_ */
@@ -0,0 +1,119 @@
+#include "HandleTable.h"
+
+namespace tsgl {
+
+/*!
+ * \brief Appends an element to the dense array.
+ * \return A Handle to the new element, whose index is the old size() of the array.
+ */
+Handle HandleTable::push() {
+    uint32_t slot;
+    if (myFreeHead != UINT32_MAX) {
+        slot = myFreeHead;
+        myFreeHead = myEntries[slot].index;
+    } else {
+        slot = myEntries.size();
+        myEntries.push_back(Entry{ 0, 0 });
+    }
+    myEntries[slot].index = myOwners.size();
+    myOwners.push_back(slot);
+    Handle h;
+    h.slot = slot;
+    h.generation = myEntries[slot].generation;
+    return h;
+}
+
+/*!
+ * \brief Records that the element at one index was moved to another.
+ * \details Whatever was at <code>to</code> must already have been moved elsewhere or released.
+ * \param from The index the element was at.
+ * \param to The index it is at now.
+ */
+void HandleTable::move(uint32_t from, uint32_t to) {
+    myOwners[to] = myOwners[from];
+    myEntries[myOwners[to]].index = to;
+}
+
+/*!
+ * \brief Records that the elements at two indices were swapped.
+ * \param a The index of one element.
+ * \param b The index of the other.
+ */
+void HandleTable::swap(uint32_t a, uint32_t b) {
+    uint32_t owner = myOwners[a];
+    myOwners[a] = myOwners[b];
+    myOwners[b] = owner;
+    myEntries[myOwners[a]].index = a;
+    myEntries[myOwners[b]].index = b;
+}
+
+/*!
+ * \brief Removes an element by moving the last element of the array into its place.
+ * \details The owner must mirror the move in its own arrays and then shrink them by one.
+ * \param h A Handle to the element to remove; it must not be stale.
+ * \return The index of the removed element, which the last element now occupies unless it was the last.
+ */
+uint32_t HandleTable::swapRemove(Handle h) {
+    uint32_t index = indexOf(h);
+    uint32_t last = myOwners.size() - 1;
+    release(h);
+    if (index != last)
+        move(last, index);
+    popBack();
+    return index;
+}
+
+/*!
+ * \brief Makes a Handle, and every copy of it, stale.
+ * \details The element's index is left in the array, for the owner to fill by moving another element into it
+ *   or to drop with popBack().
+ * \param h A Handle to the element being removed; it must not be stale.
+ */
+void HandleTable::release(Handle h) {
+    Entry& e = myEntries[h.slot];
+    e.generation++;
+    e.index = myFreeHead;
+    myFreeHead = h.slot;
+}
+
+/*!
+ * \brief Whether a Handle still refers to an element.
+ * \param h The Handle to check.
+ * \return False if the Handle is null or stale.
+ */
+bool HandleTable::contains(Handle h) const {
+    return h.slot < myEntries.size() && myEntries[h.slot].generation == h.generation;
+}
+
+/*!
+ * \brief Accessor for the index of an element.
+ * \param h A Handle to the element.
+ * \return The element's index in the dense array, or UINT32_MAX if the Handle is null or stale.
+ */
+uint32_t HandleTable::indexOf(Handle h) const {
+    return contains(h) ? myEntries[h.slot].index : UINT32_MAX;
+}
+
+/*!
+ * \brief Accessor for the Handle of the element at an index.
+ * \param index An index less than size().
+ * \return A Handle to the element there.
+ */
+Handle HandleTable::handleAt(uint32_t index) const {
+    Handle h;
+    h.slot = myOwners[index];
+    h.generation = myEntries[h.slot].generation;
+    return h;
+}
+
+/*!
+ * \brief Releases every element, making every Handle issued so far stale.
+ */
+void HandleTable::clear() {
+    while (!myOwners.empty()) {
+        release(handleAt(myOwners.size() - 1));
+        myOwners.pop_back();
+    }
+}
+
+}
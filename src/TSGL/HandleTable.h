@@ -0,0 +1,81 @@
+/*
+ * HandleTable.h provides stable, generational handles to the elements of a dense array.
+ */
+
+#ifndef HANDLETABLE_H_
+#define HANDLETABLE_H_
+
+#include <cstdint>       // For fixed-width handle fields
+#include <vector>        // For the entry and owner tables
+
+namespace tsgl {
+
+/*! \struct Handle
+ *  \brief A stable reference to an element of a dense array managed by a HandleTable.
+ *  \details A Handle stays valid while its element is moved around the array. Once the element is removed,
+ *    the Handle is stale: its slot may be reused, but with a new generation, so a stale Handle never refers
+ *    to the new element.
+ *  \details A default-constructed Handle refers to nothing.
+ */
+struct Handle {
+    uint32_t slot = UINT32_MAX;   // Entry in the HandleTable
+    uint32_t generation = 0;      // Generation of the entry when the Handle was issued
+
+    /*!
+     * \brief Whether the Handle was ever issued; says nothing about whether it is stale.
+     */
+    bool isNull() const { return slot == UINT32_MAX; }
+
+    bool operator==(const Handle& h) const { return slot == h.slot && generation == h.generation; }
+    bool operator!=(const Handle& h) const { return !(*this == h); }
+};
+
+/*! \class HandleTable
+ *  \brief Maps Handles to the indices of a dense array and back.
+ *  \details HandleTable does not hold the array itself. Its owner keeps one or more arrays of the same length,
+ *    and tells the table whenever it appends, moves or removes an element, so that every operation, including
+ *    removal by swapping in the last element, stays O(1).
+ *  \details HandleTable is not thread-safe; its owner must lock around it.
+ */
+class HandleTable {
+ private:
+    struct Entry {
+        uint32_t generation;
+        uint32_t index;           // Dense index of the element, or the next free entry if the entry is free
+    };
+    std::vector<Entry> myEntries;
+    std::vector<uint32_t> myOwners; // Entry of each dense index
+    uint32_t myFreeHead = UINT32_MAX;
+ public:
+    Handle push();
+
+    void move(uint32_t from, uint32_t to);
+
+    void swap(uint32_t a, uint32_t b);
+
+    uint32_t swapRemove(Handle h);
+
+    void release(Handle h);
+
+    /*!
+     * \brief Shrinks the dense array by one, after its last element has been moved or released.
+     */
+    void popBack() { myOwners.pop_back(); }
+
+    bool contains(Handle h) const;
+
+    uint32_t indexOf(Handle h) const;
+
+    Handle handleAt(uint32_t index) const;
+
+    void clear();
+
+    /*!
+     * \brief Accessor for the length of the dense array.
+     */
+    uint32_t size() const { return myOwners.size(); }
+};
+
+}
+
+#endif /* HANDLETABLE_H_ */
@@ -38,8 +38,9 @@ Image::Image(float x, float y, float z, std::string filename, GLfloat width, GLf
     stbi_set_flip_vertically_on_load(true);
     data = stbi_load(filename.c_str(), &pixelWidth, &pixelHeight, 0, 4);
     tsglAssert(data, "stbi_load(filename) failed.");
-    // vertex allocation and assignment
-    vertices = new GLfloat[30];
+    // vertex assignment (the vertices are stored inline)
+    vertices = myVertexStorage;
+    myVerticesInline = true;
 
     // positions (x,y,z)    texture coords
     // 0.5f,  0.5f, 0.0f,   1.0f, 1.0f, // top right
@@ -68,13 +69,7 @@ void Image::draw(Shader * shader) {
         return;
     }
 
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(myRotationPointX, myRotationPointY, myRotationPointZ));
-    model = glm::rotate(model, glm::radians(myCurrentYaw), glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::rotate(model, glm::radians(myCurrentPitch), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(myCurrentRoll), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::translate(model, glm::vec3(myCenterX - myRotationPointX, myCenterY - myRotationPointY, myCenterZ - myRotationPointZ));
-    model = glm::scale(model, glm::vec3(myXScale, myYScale, myZScale));
+    glm::mat4 model = modelMatrix();
 
     unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
     glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
@@ -119,6 +114,7 @@ void Image::setWidth(GLfloat width) {
     myWidth = width;
     myXScale = width;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -134,6 +130,7 @@ void Image::changeWidthBy(GLfloat delta) {
     myWidth += delta;
     myXScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -149,6 +146,7 @@ void Image::setHeight(GLfloat height) {
     myWidth = height;
     myYScale = height;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -164,6 +162,7 @@ void Image::changeHeightBy(GLfloat delta) {
     myHeight += delta;
     myYScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
@@ -183,6 +182,7 @@ void Image::changeFile(std::string filename) {
     tsglAssert(data, "stbi_load(filename) failed.");
     init = true;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -198,6 +198,7 @@ void Image::setAlpha(float alpha) {
     attribMutex.lock();
     myAlpha = alpha;
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
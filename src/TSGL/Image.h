@@ -29,6 +29,7 @@ class Image : public Drawable {
     GLint pixelWidth, pixelHeight;
     std::string myFile;
     GLuint myTexture;
+    GLfloat myVertexStorage[30];            // Inline storage for the two textured triangles
  public:
     Image(float x, float y, float z, std::string filename, GLfloat width, GLfloat height, float yaw, float pitch, float roll, float alpha = 1.0f);
 
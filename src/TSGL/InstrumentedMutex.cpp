@@ -0,0 +1,185 @@
+#include "InstrumentedMutex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <map>
+
+namespace tsgl {
+
+// Statistics shared by every InstrumentedMutex with the same name
+struct LockCounters {
+    std::atomic<unsigned long long> acquisitions;
+    std::atomic<unsigned long long> contended;
+    std::atomic<long long>          waitTotal;    // Nanoseconds
+    std::atomic<long long>          waitMax;
+    std::atomic<long long>          holdTotal;
+    std::atomic<long long>          holdMax;
+
+    LockCounters() { reset(); }
+
+    void reset() {
+        acquisitions = 0;
+        contended = 0;
+        waitTotal = waitMax = holdTotal = holdMax = 0;
+    }
+};
+
+namespace {
+    typedef std::map<std::string, LockCounters*> counterMap;
+
+    // The registry is never destroyed, so that mutexes in static objects can still report on exit
+    std::mutex& registryMutex() {
+        static std::mutex* m = new std::mutex();
+        return *m;
+    }
+
+    counterMap& registry() {
+        static counterMap* r = new counterMap();
+        return *r;
+    }
+
+  #ifdef TSGL_LOCK_STATS
+    long long nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void updateMax(std::atomic<long long>& max, long long value) {
+        long long current = max.load(std::memory_order_relaxed);
+        while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+  #endif
+}
+
+/*!
+ * \brief Explicit InstrumentedMutex constructor method.
+ *   \param name The name under which this mutex's statistics are reported. It is not copied, so it must
+ *     outlive the mutex.
+ * \return A new, unlocked InstrumentedMutex.
+ */
+#ifdef TSGL_LOCK_STATS
+InstrumentedMutex::InstrumentedMutex(const char* name) : myName(name), myCounters(nullptr), myAcquiredAt(0) {}
+
+// Finds or creates the statistics for this mutex's name, on its first lock
+LockCounters* InstrumentedMutex::counters() {
+    LockCounters* counters = myCounters.load(std::memory_order_acquire);
+    if (counters)
+      return counters;
+    std::lock_guard<std::mutex> lock(registryMutex());
+    LockCounters*& shared = registry()[myName];
+    if (!shared)
+      shared = new LockCounters();
+    myCounters.store(shared, std::memory_order_release);
+    return shared;
+}
+
+void InstrumentedMutex::lockInstrumented() {
+    LockCounters* stats = counters();
+    long long start = 0;
+    bool contended = !myMutex.try_lock();
+    if (contended) {
+      start = nowNanos();
+      myMutex.lock();
+    }
+    myAcquiredAt = nowNanos();
+    stats->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    if (contended) {
+      long long wait = myAcquiredAt - start;
+      stats->contended.fetch_add(1, std::memory_order_relaxed);
+      stats->waitTotal.fetch_add(wait, std::memory_order_relaxed);
+      updateMax(stats->waitMax, wait);
+    }
+}
+
+bool InstrumentedMutex::tryLockInstrumented() {
+    LockCounters* stats = counters();
+    if (!myMutex.try_lock())
+      return false;
+    myAcquiredAt = nowNanos();
+    stats->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void InstrumentedMutex::unlockInstrumented() {
+    LockCounters* stats = myCounters.load(std::memory_order_relaxed);
+    long long hold = nowNanos() - myAcquiredAt;
+    myMutex.unlock();
+    stats->holdTotal.fetch_add(hold, std::memory_order_relaxed);
+    updateMax(stats->holdMax, hold);
+}
+#else
+InstrumentedMutex::InstrumentedMutex(const char*) {}
+#endif
+
+/*!
+ * \brief Accessor for whether lock statistics are being kept.
+ * \return True if TSGL was built with <code>TSGL_LOCK_STATS</code> defined, false otherwise.
+ */
+bool InstrumentedMutex::isEnabled() {
+  #ifdef TSGL_LOCK_STATS
+    return true;
+  #else
+    return false;
+  #endif
+}
+
+/*!
+ * \brief Accessor for the statistics of every named lock.
+ * \return A LockStats for every name whose mutexes have been locked so far, sorted by decreasing total wait time.
+ *   The vector is empty if lock statistics are disabled.
+ */
+std::vector<LockStats> InstrumentedMutex::getLockStats() {
+    std::vector<LockStats> stats;
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for (counterMap::const_iterator it = registry().begin(); it != registry().end(); ++it) {
+      LockStats s;
+      s.name = it->first;
+      s.acquisitions = it->second->acquisitions.load();
+      s.contended = it->second->contended.load();
+      s.waitTotal = it->second->waitTotal.load() / 1e9;
+      s.waitMax = it->second->waitMax.load() / 1e9;
+      s.holdTotal = it->second->holdTotal.load() / 1e9;
+      s.holdMax = it->second->holdMax.load() / 1e9;
+      stats.push_back(s);
+    }
+    std::sort(stats.begin(), stats.end(), [](const LockStats& a, const LockStats& b) {
+      return a.waitTotal > b.waitTotal;
+    });
+    return stats;
+}
+
+/*!
+ * \brief Prints a table of the statistics of every named lock.
+ *   \param out The stream to print to (defaults to std::cout).
+ */
+void InstrumentedMutex::printLockStats(std::ostream& out) {
+    if (!isEnabled()) {
+      out << "Lock statistics are disabled; rebuild TSGL with TSGL_LOCK_STATS defined." << std::endl;
+      return;
+    }
+    std::vector<LockStats> stats = getLockStats();
+    out << std::left << std::setw(32) << "lock" << std::right
+        << std::setw(12) << "acquired" << std::setw(12) << "contended"
+        << std::setw(14) << "wait (ms)" << std::setw(14) << "max wait"
+        << std::setw(14) << "hold (ms)" << std::setw(14) << "max hold" << std::endl;
+    out << std::fixed << std::setprecision(3);
+    for (unsigned int i = 0; i < stats.size(); ++i) {
+      out << std::left << std::setw(32) << stats[i].name << std::right
+          << std::setw(12) << stats[i].acquisitions << std::setw(12) << stats[i].contended
+          << std::setw(14) << stats[i].waitTotal * 1000 << std::setw(14) << stats[i].waitMax * 1000
+          << std::setw(14) << stats[i].holdTotal * 1000 << std::setw(14) << stats[i].holdMax * 1000 << std::endl;
+    }
+    out.unsetf(std::ios_base::floatfield);
+}
+
+/*!
+ * \brief Resets the statistics of every named lock to 0.
+ */
+void InstrumentedMutex::resetLockStats() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for (counterMap::iterator it = registry().begin(); it != registry().end(); ++it)
+      it->second->reset();
+}
+
+}
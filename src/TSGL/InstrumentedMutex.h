@@ -0,0 +1,93 @@
+/*
+ * InstrumentedMutex.h provides a mutex that can keep contention statistics about itself.
+ */
+
+#ifndef INSTRUMENTEDMUTEX_H_
+#define INSTRUMENTEDMUTEX_H_
+
+#include <atomic>        // For looking up statistics lazily
+#include <chrono>        // For timing waits and holds
+#include <iostream>      // For printing reports
+#include <mutex>         // For the underlying mutex
+#include <string>        // For lock names
+#include <vector>        // For returning reports
+
+namespace tsgl {
+
+struct LockCounters;
+
+/*! \struct LockStats
+ *  \brief Contention statistics for every InstrumentedMutex sharing a name.
+ *  \details Times are in seconds.
+ */
+struct LockStats {
+    std::string         name;          // Name of the lock(s)
+    unsigned long long  acquisitions;  // Number of times the lock was acquired
+    unsigned long long  contended;     // Number of acquisitions that had to wait for another thread
+    double              waitTotal;     // Total time spent waiting to acquire the lock
+    double              waitMax;       // Longest single wait
+    double              holdTotal;     // Total time the lock was held
+    double              holdMax;       // Longest single hold
+};
+
+/*! \class InstrumentedMutex
+ *  \brief A named mutex that records how long threads wait for it and hold it.
+ *  \details InstrumentedMutex can be used anywhere a std::mutex is locked with lock() and unlock(), including
+ *    with std::lock_guard and std::unique_lock.
+ *  \details Statistics are only kept when TSGL is built with <code>TSGL_LOCK_STATS</code> defined
+ *    (e.g. <code>make LOCK_STATS=1</code>), and programs using that build must define it as well.
+ *    Otherwise the mutex is exactly a std::mutex, with the same size and no extra work per lock() and unlock().
+ *  \details All mutexes constructed with the same name share one set of statistics; for instance, the
+ *    attribMutex of every Drawable is reported as "Drawable::attribMutex". A mutex looks up its statistics
+ *    the first time it is locked, so constructing one never touches the shared registry.
+ */
+class InstrumentedMutex {
+ private:
+    std::mutex      myMutex;
+  #ifdef TSGL_LOCK_STATS
+    const char *    myName;          // Must outlive the mutex; in practice always a string literal
+    std::atomic<LockCounters*> myCounters;  // NULL until the mutex is first locked
+    long long       myAcquiredAt;    // When the current owner acquired the lock, in nanoseconds
+
+    LockCounters* counters();
+    void lockInstrumented();
+    bool tryLockInstrumented();
+    void unlockInstrumented();
+  #endif
+ public:
+    explicit InstrumentedMutex(const char* name);
+
+  #ifdef TSGL_LOCK_STATS
+    /*!
+     * \brief Locks the mutex, blocking until it is available.
+     */
+    void lock() { lockInstrumented(); }
+
+    /*!
+     * \brief Attempts to lock the mutex without blocking.
+     * \return True if the mutex was locked, false if another thread owns it.
+     */
+    bool try_lock() { return tryLockInstrumented(); }
+
+    /*!
+     * \brief Unlocks the mutex.
+     */
+    void unlock() { unlockInstrumented(); }
+  #else
+    void lock() { myMutex.lock(); }
+    bool try_lock() { return myMutex.try_lock(); }
+    void unlock() { myMutex.unlock(); }
+  #endif
+
+    static bool isEnabled();
+
+    static std::vector<LockStats> getLockStats();
+
+    static void printLockStats(std::ostream& out = std::cout);
+
+    static void resetLockStats();
+};
+
+}
+
+#endif /* INSTRUMENTEDMUTEX_H_ */
@@ -0,0 +1,56 @@
+#include "LevelOfDetail.h"
+
+#include <cmath>
+
+namespace tsgl {
+
+namespace {
+    const double HALF_TURN = 3.14159265358979323846;
+}
+
+const int LevelOfDetail::SEGMENTS[LevelOfDetail::LEVELS] = { 8, 12, 16, 24, 36, 48, 64, 96, 128 };
+const float LevelOfDetail::MAX_ERROR = 0.5f;
+const float LevelOfDetail::HYSTERESIS = 0.2f;
+
+/*!
+ * \brief Finds the coarsest level that draws a circle of the given size accurately.
+ *   \param radius The radius of the circle on screen, in pixels.
+ * \return The index into SEGMENTS of the first level whose segments stray less than MAX_ERROR pixels from the
+ *   circle, or the finest level if none do.
+ */
+int LevelOfDetail::levelFor(float radius) {
+    for (int i = 0; i < LEVELS; i++) {
+      // Distance between the middle of a chord and the arc it cuts off
+      if (radius * (1 - cos(HALF_TURN / SEGMENTS[i])) <= MAX_ERROR)
+        return i;
+    }
+    return LEVELS - 1;
+}
+
+/*!
+ * \brief Chooses the level for a Shape, with hysteresis.
+ *   \param current The Shape's current level.
+ *   \param radius The radius of the Shape on screen, in pixels.
+ * \return <code>current</code>, unless the Shape would need a different level even if it were
+ *   HYSTERESIS larger or smaller; then the level levelFor() gives.
+ */
+int LevelOfDetail::select(int current, float radius) {
+    if (levelFor(radius * (1 - HYSTERESIS)) > current || levelFor(radius * (1 + HYSTERESIS)) < current)
+      return levelFor(radius);
+    return current;
+}
+
+/*!
+ * \brief Estimates the radius on screen of a sphere.
+ *   \param radius The radius of the sphere in world units.
+ *   \param distance The distance from the camera to the sphere's center.
+ *   \param pixelsPerUnit The number of pixels a world unit spans at distance 1 from the camera.
+ * \return The radius in pixels. A sphere around the camera is treated as infinitely large.
+ */
+float LevelOfDetail::projectedRadius(float radius, float distance, float pixelsPerUnit) {
+    if (distance <= radius)
+      return HUGE_VALF;
+    return radius * pixelsPerUnit / distance;
+}
+
+}
@@ -0,0 +1,37 @@
+/*
+ * LevelOfDetail.h provides the tessellation levels chosen for curved Shapes from their size on screen.
+ */
+
+#ifndef LEVELOFDETAIL_H_
+#define LEVELOFDETAIL_H_
+
+namespace tsgl {
+
+/*! \class LevelOfDetail
+ *  \brief Picks how finely a curved Shape is tessellated, from how large it appears on screen.
+ *  \details Curved Shapes (Circle, Ellipse, Sphere, Ellipsoid, Cylinder and Cone) approximate their curves with
+ *    a number of straight segments chosen from a fixed list of levels, so that each level's mesh can be shared.
+ *    The level chosen is the coarsest whose segments stray less than <code>MAX_ERROR</code> pixels from the
+ *    true curve, so a shape spanning the whole screen is capped at <code>SEGMENTS[LEVELS-1]</code> segments
+ *    and a distant one drops to a handful.
+ *  \details Canvas calls Drawable::selectDetail() on each Drawable every frame it is drawn. To avoid flickering
+ *    between two levels when a Shape's size hovers around a threshold, select() only changes level once the
+ *    Shape is <code>HYSTERESIS</code> (as a fraction) past it.
+ */
+class LevelOfDetail {
+ public:
+    static const int LEVELS = 9;
+    static const int SEGMENTS[LEVELS];      // Segments around a full circle at each level
+    static const float MAX_ERROR;           // Largest allowed distance between a segment and the curve, in pixels
+    static const float HYSTERESIS;          // How far past a threshold a Shape must be before changing level
+
+    static int levelFor(float radius);
+
+    static int select(int current, float radius);
+
+    static float projectedRadius(float radius, float distance, float pixelsPerUnit);
+};
+
+}
+
+#endif /* LEVELOFDETAIL_H_ */
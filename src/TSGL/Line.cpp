@@ -16,7 +16,7 @@ namespace tsgl {
  * \return A new Line with the specified length and color.
  * \note At 0,0,0 yaw,pitch,roll, the line will be drawn directly parallel to the x-axis.
  */
-Line::Line(float x, float y, float z, GLfloat length, float yaw, float pitch, float roll, ColorFloat color) : Polyline(x,y,z,2,yaw,pitch,roll) {
+Line::Line(float x, float y, float z, GLfloat length, float yaw, float pitch, float roll, ColorFloat color) : Polyline(x,y,z,2,yaw,pitch,roll,myVertexStorage) {
     if (length <= 0)
         TsglDebug("Cannot have a line with length less than or equal to 0.");
     attribMutex.lock();
@@ -46,7 +46,7 @@ Line::Line(float x, float y, float z, GLfloat length, float yaw, float pitch, fl
  * \return A new Line with the specified length and color.
  * \note At 0,0,0 yaw,pitch,roll, the line will be drawn directly parallel to the x-axis.
  */
-Line::Line(float x, float y, float z, GLfloat length, float yaw, float pitch, float roll, ColorFloat color[]) : Polyline(x,y,z,2,yaw,pitch,roll) {
+Line::Line(float x, float y, float z, GLfloat length, float yaw, float pitch, float roll, ColorFloat color[]) : Polyline(x,y,z,2,yaw,pitch,roll,myVertexStorage) {
     if (length <= 0)
         TsglDebug("Cannot have a line with length less than or equal to 0.");
     attribMutex.lock();
@@ -77,7 +77,7 @@ Line::Line(float x, float y, float z, GLfloat length, float yaw, float pitch, fl
  *      \param color The reference variable to the color of the Line.
  * \return A new Line with the specified length and color.
  */
-Line::Line(GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2, float yaw, float pitch, float roll, ColorFloat color) : Polyline((x2 + x1) / 2, (y2 + y1) / 2, (z2 + z1) / 2, 2, yaw, pitch, roll) {
+Line::Line(GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2, float yaw, float pitch, float roll, ColorFloat color) : Polyline((x2 + x1) / 2, (y2 + y1) / 2, (z2 + z1) / 2, 2, yaw, pitch, roll, myVertexStorage) {
     attribMutex.lock();
     myLength = sqrt(pow(x2 - x1, 2) + pow(y2 - y1, 2) + pow(z2 - z1, 2));   
     myEndpointX1 = x1;
@@ -106,7 +106,7 @@ Line::Line(GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z
  *      \param color The reference variable to the colors of the Line.
  * \return A new Line with the specified length and color.
  */
-Line::Line(GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2, float yaw, float pitch, float roll, ColorFloat color[]) : Polyline((x2 + x1) / 2, (y2 + y1) / 2, (z2 + z1) / 2, 2, yaw, pitch, roll) {
+Line::Line(GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2, float yaw, float pitch, float roll, ColorFloat color[]) : Polyline((x2 + x1) / 2, (y2 + y1) / 2, (z2 + z1) / 2, 2, yaw, pitch, roll, myVertexStorage) {
     attribMutex.lock();
     myLength = sqrt(pow(x2 - x1, 2) + pow(y2 - y1, 2) + pow(z2 - z1, 2));  
     myEndpointX1 = x1;
@@ -154,7 +154,9 @@ void Line::setFirstEndpoint(float x, float y, float z) {
     vertices[7] = myEndpointX2 - myCenterX;
     vertices[8] = myEndpointY2 - myCenterY;
     vertices[9] = myEndpointZ2 - myCenterZ;
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -191,7 +193,9 @@ void Line::setSecondEndpoint(float x, float y, float z) {
     vertices[7] = myEndpointX2 - myCenterX;
     vertices[8] = myEndpointY2 - myCenterY;
     vertices[9] = myEndpointZ2 - myCenterZ;
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -212,7 +216,9 @@ void Line::setLength(GLfloat length) {
     vertices[7] *= ratio;
     vertices[8] *= ratio;
     vertices[9] *= ratio;
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -234,7 +240,9 @@ void Line::changeLengthBy(GLfloat delta) {
     vertices[7] *= ratio;
     vertices[8] *= ratio;
     vertices[9] *= ratio;
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
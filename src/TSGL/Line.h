@@ -17,6 +17,7 @@ class Line : public Polyline {
  private:
     GLfloat myLength;
     GLfloat myEndpointX1, myEndpointY1, myEndpointZ1, myEndpointX2, myEndpointY2, myEndpointZ2;
+    GLfloat myVertexStorage[2 * 7];         // Inline storage for the endpoints
  public:
     Line(float x, float y, float z, GLfloat length, float yaw, float pitch, float roll, ColorFloat color);
 
@@ -0,0 +1,275 @@
+#include "LineSet.h"
+
+#include <algorithm>
+
+namespace tsgl {
+
+ /*!
+  * \brief Explicitly constructs a new monocolored LineSet.
+  * \details Explicit constructor for a LineSet object.
+  *   \param x The x coordinate of the LineSet's center.
+  *   \param y The y coordinate of the LineSet's center.
+  *   \param z The z coordinate of the LineSet's center.
+  *   \param numSegments The number of segments; may be 0 if segments are added later with addSegment().
+  *   \param endpoints An array of 6 * numSegments floats, the x-y-z of both endpoints of each segment.
+  *     If it is NULL, the LineSet starts out empty.
+  *   \param yaw The LineSet's yaw.
+  *   \param pitch The LineSet's pitch.
+  *   \param roll The LineSet's roll.
+  *   \param color The color of every segment.
+  * \return A new LineSet with the specified segments and color.
+  */
+LineSet::LineSet(float x, float y, float z, int numSegments, const GLfloat endpoints[], float yaw, float pitch, float roll, ColorFloat color) : Drawable(x,y,z,yaw,pitch,roll) {
+    if (numSegments > 0 && endpoints == NULL) {
+        TsglDebug("Cannot build a LineSet from a NULL array of endpoints.");
+        numSegments = 0;
+    }
+    attribMutex.lock();
+    myXScale = myYScale = myZScale = 1;
+    myVertices.resize(std::max(numSegments, 0) * 2);
+    for (unsigned i = 0; i < myVertices.size(); i++) {
+        myVertices[i].x = endpoints[i*3];
+        myVertices[i].y = endpoints[i*3 + 1];
+        myVertices[i].z = endpoints[i*3 + 2];
+        VertexFormat::packColor(color, myVertices[i].color);
+    }
+    myAlphaTotal = color.A * (myVertices.size() / 2);
+    myAlpha = color.A;
+    invalidateSegments(0, myVertices.size() / 2);
+    init = true;
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Explicitly constructs a new multicolored LineSet.
+  * \details Explicit constructor for a LineSet object.
+  *   \param x The x coordinate of the LineSet's center.
+  *   \param y The y coordinate of the LineSet's center.
+  *   \param z The z coordinate of the LineSet's center.
+  *   \param numSegments The number of segments.
+  *   \param endpoints An array of 6 * numSegments floats, the x-y-z of both endpoints of each segment.
+  *   \param yaw The LineSet's yaw.
+  *   \param pitch The LineSet's pitch.
+  *   \param roll The LineSet's roll.
+  *   \param color An array of numSegments ColorFloats, one per segment.
+  * \return A new LineSet with the specified segments and colors.
+  */
+LineSet::LineSet(float x, float y, float z, int numSegments, const GLfloat endpoints[], float yaw, float pitch, float roll, ColorFloat color[]) : Drawable(x,y,z,yaw,pitch,roll) {
+    if (numSegments > 0 && (endpoints == NULL || color == NULL)) {
+        TsglDebug("Cannot build a LineSet from a NULL array of endpoints or colors.");
+        numSegments = 0;
+    }
+    attribMutex.lock();
+    myXScale = myYScale = myZScale = 1;
+    myVertices.resize(std::max(numSegments, 0) * 2);
+    for (unsigned i = 0; i < myVertices.size(); i++) {
+        myVertices[i].x = endpoints[i*3];
+        myVertices[i].y = endpoints[i*3 + 1];
+        myVertices[i].z = endpoints[i*3 + 2];
+        VertexFormat::packColor(color[i / 2], myVertices[i].color);
+    }
+    for (int i = 0; i < numSegments; i++)
+        myAlphaTotal += color[i].A;
+    if (numSegments > 0)
+        myAlpha = myAlphaTotal / numSegments;
+    invalidateSegments(0, myVertices.size() / 2);
+    init = true;
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Draw the LineSet.
+ * \details This function actually draws the LineSet to the Canvas, from its own vertex buffer rather than the
+ *   Canvas' one. Only the segments changed since the last frame are copied and uploaded, and
+ *   <code>attribMutex</code> is not locked.
+ * \note This function overrides Drawable::draw()
+ */
+void LineSet::draw(Shader * shader) {
+    if (!init) {
+        TsglDebug("Vertex buffer is not full.");
+        return;
+    }
+    glm::mat4 model = modelMatrix();
+
+    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+    GLint canvasBuffer;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &canvasBuffer);
+    GLint posAttrib = glGetAttribLocation(shader->ID, "aPos");
+    GLint colAttrib = glGetAttribLocation(shader->ID, "aColor");
+
+    myChanges.receive(myDrawn, myBuffer);
+    myBuffer.bind(GL_ARRAY_BUFFER, myDrawn.data(), myDrawn.size() * sizeof(PackedVertex));
+    VertexFormat::setLayout(posAttrib, colAttrib);
+    glDrawArrays(GL_LINES, 0, myDrawn.size());
+
+    glBindBuffer(GL_ARRAY_BUFFER, canvasBuffer);
+    VertexFormat::setLayout(posAttrib, colAttrib);
+}
+
+// Hands changed segments to the render thread; called with attribMutex held
+void LineSet::invalidateSegments(int first, int count) {
+    myChanges.post(myVertices, first * 2, count * 2);
+}
+
+/**
+ * \brief Adds a segment to the end of the LineSet.
+ * \details Only the new segment is uploaded the next time the LineSet is drawn, unless the GPU buffer is full,
+ *   in which case it is reallocated at twice the size and the whole set is uploaded.
+ * \param x1 The x coordinate of the first endpoint.
+ * \param y1 The y coordinate of the first endpoint.
+ * \param z1 The z coordinate of the first endpoint.
+ * \param x2 The x coordinate of the second endpoint.
+ * \param y2 The y coordinate of the second endpoint.
+ * \param z2 The z coordinate of the second endpoint.
+ * \param color The color of the segment.
+ * \return The index of the new segment.
+ */
+int LineSet::addSegment(GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2, ColorFloat color) {
+    PackedVertex v[2] = { { x1, y1, z1, {0, 0, 0, 0} }, { x2, y2, z2, {0, 0, 0, 0} } };
+    VertexFormat::packColor(color, v[0].color);
+    VertexFormat::packColor(color, v[1].color);
+    attribMutex.lock();
+    int index = myVertices.size() / 2;
+    myVertices.push_back(v[0]);
+    myVertices.push_back(v[1]);
+    myAlphaTotal += color.A;
+    myAlpha = myAlphaTotal / (index + 1);
+    invalidateSegments(index, 1);
+    attribMutex.unlock();
+    markDirty();
+    return index;
+}
+
+/**
+ * \brief Moves one segment.
+ * \param index The index of the segment.
+ * \param x1 The new x coordinate of the first endpoint.
+ * \param y1 The new y coordinate of the first endpoint.
+ * \param z1 The new z coordinate of the first endpoint.
+ * \param x2 The new x coordinate of the second endpoint.
+ * \param y2 The new y coordinate of the second endpoint.
+ * \param z2 The new z coordinate of the second endpoint.
+ */
+void LineSet::setSegment(int index, GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2) {
+    GLfloat endpoints[6] = { x1, y1, z1, x2, y2, z2 };
+    updateSegments(index, 1, endpoints);
+}
+
+/**
+ * \brief Moves a range of segments.
+ * \details Only the given range is uploaded to the GPU the next time the LineSet is drawn.
+ * \param first The index of the first segment to move.
+ * \param count The number of segments to move.
+ * \param endpoints An array of 6 * count floats, the new x-y-z of both endpoints of each segment.
+ */
+void LineSet::updateSegments(int first, int count, const GLfloat endpoints[]) {
+    attribMutex.lock();
+    if (first < 0 || count < 0 || (first + count) * 2 > (int)myVertices.size()) {
+        attribMutex.unlock();
+        TsglDebug("Cannot update segments outside of the LineSet.");
+        return;
+    }
+    for (int i = 0; i < count * 2; i++) {
+        myVertices[first*2 + i].x = endpoints[i*3];
+        myVertices[first*2 + i].y = endpoints[i*3 + 1];
+        myVertices[first*2 + i].z = endpoints[i*3 + 2];
+    }
+    invalidateSegments(first, count);
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Recolors one segment.
+ * \param index The index of the segment.
+ * \param color The new color of the segment.
+ */
+void LineSet::setSegmentColor(int index, ColorFloat color) {
+    attribMutex.lock();
+    if (index < 0 || index * 2 >= (int)myVertices.size()) {
+        attribMutex.unlock();
+        TsglDebug("Cannot recolor a segment outside of the LineSet.");
+        return;
+    }
+    myAlphaTotal += color.A - myVertices[index*2].color[3] / 255.0f;
+    myAlpha = myAlphaTotal / (myVertices.size() / 2);
+    VertexFormat::packColor(color, myVertices[index*2].color);
+    VertexFormat::packColor(color, myVertices[index*2 + 1].color);
+    invalidateSegments(index, 1);
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Sets the LineSet to a new color.
+ * \param c The new ColorFloat.
+ */
+void LineSet::setColor(ColorFloat c) {
+    attribMutex.lock();
+    for (unsigned i = 0; i < myVertices.size(); i++)
+        VertexFormat::packColor(c, myVertices[i].color);
+    myAlphaTotal = c.A * (myVertices.size() / 2);
+    myAlpha = c.A;
+    invalidateSegments(0, myVertices.size() / 2);
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Sets the LineSet to a new array of colors.
+ * \param c The new array of ColorFloats, one per segment.
+ */
+void LineSet::setColor(ColorFloat c[]) {
+    attribMutex.lock();
+    int segments = myVertices.size() / 2;
+    myAlphaTotal = 0;
+    for (int i = 0; i < segments; i++) {
+        VertexFormat::packColor(c[i], myVertices[i*2].color);
+        VertexFormat::packColor(c[i], myVertices[i*2 + 1].color);
+        myAlphaTotal += c[i].A;
+    }
+    if (segments > 0)
+        myAlpha = myAlphaTotal / segments;
+    invalidateSegments(0, myVertices.size() / 2);
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Accessor for LineSet's color.
+ * \details Returns the color of LineSet's first segment.
+ * \note For multicolored LineSets, use getColors() to access a vector of all relevant colors.
+ */
+ColorFloat LineSet::getColor() {
+    attribMutex.lock();
+    ColorFloat c = myVertices.empty() ? ColorFloat() : VertexFormat::unpackColor(myVertices[0].color);
+    attribMutex.unlock();
+    return c;
+}
+
+/**
+ * \brief Accessor for LineSet's colors.
+ * \details Populates the reference parameter vector with a ColorFloat for each segment of LineSet.
+ * \param colorVec A vector of ColorFloats to which the ColorFloats associated with LineSet will be pushed.
+ */
+void LineSet::getColors(std::vector<ColorFloat> &colorVec) {
+    attribMutex.lock();
+    for (unsigned i = 0; i < myVertices.size(); i += 2)
+        colorVec.push_back(VertexFormat::unpackColor(myVertices[i].color));
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Accessor for the number of segments.
+ * \return The number of segments in the LineSet.
+ */
+int LineSet::getNumSegments() {
+    attribMutex.lock();
+    int n = myVertices.size() / 2;
+    attribMutex.unlock();
+    return n;
+}
+
+}
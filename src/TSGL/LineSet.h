@@ -0,0 +1,61 @@
+/*
+ * LineSet.h extends Drawable and provides a class for drawing many separate line segments at once.
+ */
+
+#ifndef LINESET_H_
+#define LINESET_H_
+
+#include "Drawable.h"      // For extending our Drawable object
+#include "GpuBuffer.h"     // For keeping the segments on the GPU between frames
+#include "VertexFormat.h"  // For the compact format the shape shader reads
+#include "VertexMailbox.h" // For handing changed segments to the render thread
+#include <vector>          // For segment storage
+
+namespace tsgl {
+
+/*! \class LineSet
+ *  \brief Draw a large set of independent line segments, each with its own color.
+ *  \details LineSet is a class for holding the edges of a graph or network as a single Drawable, where drawing
+ *   each edge as a Line would cost a mutex, a vertex array, a model matrix and a draw call per edge.
+ *  \details All of the segments are kept in one GPU buffer and drawn with one glDrawArrays(GL_LINES). Changing
+ *   segments by index only uploads the segments that changed. Adding segments only uploads the new ones, except
+ *   when the buffer has to grow, which doubles its size.
+ *  \details The render thread draws from its own copy of the segments, which it brings up to date from the
+ *   changed ranges, so drawing never waits for a thread that is changing the LineSet.
+ *  \details Endpoints are relative to the LineSet's center, six floats (x1, y1, z1, x2, y2, z2) per segment.
+ */
+class LineSet : public Drawable {
+ private:
+    std::vector<PackedVertex> myVertices;  // Two per segment
+    std::vector<PackedVertex> myDrawn;     // The render thread's copy of myVertices
+    VertexMailbox myChanges;               // Ranges of myVertices changed since the render thread's copy
+    GpuBuffer myBuffer{GL_DYNAMIC_DRAW};
+    float myAlphaTotal = 0;                // Sum of the segments' alphas, for myAlpha
+
+    void invalidateSegments(int first, int count);
+ public:
+    LineSet(float x, float y, float z, int numSegments, const GLfloat endpoints[], float yaw, float pitch, float roll, ColorFloat color);
+
+    LineSet(float x, float y, float z, int numSegments, const GLfloat endpoints[], float yaw, float pitch, float roll, ColorFloat color[]);
+
+    virtual void draw(Shader * shader);
+
+    int addSegment(GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2, ColorFloat color);
+
+    void setSegment(int index, GLfloat x1, GLfloat y1, GLfloat z1, GLfloat x2, GLfloat y2, GLfloat z2);
+
+    void updateSegments(int first, int count, const GLfloat endpoints[]);
+
+    void setSegmentColor(int index, ColorFloat color);
+
+    virtual void setColor(ColorFloat c);
+    virtual void setColor(ColorFloat c[]);
+    virtual ColorFloat getColor();
+    virtual void getColors(std::vector<ColorFloat> &colorVec);
+
+    int getNumSegments();
+};
+
+}
+
+#endif /* LINESET_H_ */
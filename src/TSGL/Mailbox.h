@@ -0,0 +1,54 @@
+/*
+ * Mailbox.h provides a single slot through which other threads hand the render thread their latest state.
+ */
+
+#ifndef MAILBOX_H_
+#define MAILBOX_H_
+
+#include <atomic>        // For the slot
+
+namespace tsgl {
+
+/*! \class Mailbox
+ *  \brief Hands the render thread the latest copy of some state, without either side locking.
+ *  \details A writer builds a new copy of the state on the heap and post()s it. The render thread take()s it,
+ *    keeps it, and draws from its own copy until a newer one is posted. A copy posted before the previous one
+ *    was taken replaces it, so the render thread only ever sees the latest state.
+ *  \details Writers that need to add to a copy that has not been taken yet, rather than replace it, can take()
+ *    it themselves and post() it again. Writers must be serialized among themselves, usually by the lock that
+ *    protects the state they copy.
+ */
+template <typename T>
+class Mailbox {
+ private:
+    std::atomic<T*> mySlot{nullptr};  // Latest state posted and not yet taken, or NULL
+ public:
+    /*!
+     * \brief Constructs a new, empty Mailbox.
+     */
+    Mailbox() { }
+
+    /*!
+     * \brief Destroys the Mailbox, and any state still waiting in it.
+     */
+    ~Mailbox() { delete mySlot.load(std::memory_order_acquire); }
+
+    Mailbox(const Mailbox&) = delete;
+    Mailbox& operator=(const Mailbox&) = delete;
+
+    /**
+     * \brief Posts a new state, deleting any state still waiting to be taken.
+     * \param state The new state, allocated with new. The Mailbox owns it until it is taken.
+     */
+    void post(T* state) { delete mySlot.exchange(state, std::memory_order_acq_rel); }
+
+    /*!
+     * \brief Takes the state waiting in the Mailbox.
+     * \return The latest state posted since the last take(), which the caller must delete, or NULL if there is none.
+     */
+    T* take() { return mySlot.exchange(nullptr, std::memory_order_acq_rel); }
+};
+
+}
+
+#endif /* MAILBOX_H_ */
@@ -0,0 +1,237 @@
+#include "Mesh.h"
+
+namespace tsgl {
+
+ /*!
+  * \brief Explicitly constructs a new monocolored Mesh.
+  * \details Explicit constructor for a Mesh object.
+  *   \param x The x coordinate of the Mesh's center.
+  *   \param y The y coordinate of the Mesh's center.
+  *   \param z The z coordinate of the Mesh's center.
+  *   \param numVertices The number of vertices in the Mesh.
+  *   \param positions An array of 3 * numVertices floats, the x-y-z of each vertex relative to the center.
+  *   \param numIndices The number of indices, a multiple of 3; 0 to draw every three vertices as a triangle.
+  *   \param indices An array of numIndices indices into the vertices, or NULL.
+  *   \param yaw The Mesh's yaw.
+  *   \param pitch The Mesh's pitch.
+  *   \param roll The Mesh's roll.
+  *   \param color The color of every vertex.
+  * \return A new Mesh with the specified vertices, indices and color.
+  */
+Mesh::Mesh(float x, float y, float z, int numVertices, const GLfloat positions[], int numIndices, const GLuint indices[], float yaw, float pitch, float roll, ColorFloat color) : Drawable(x,y,z,yaw,pitch,roll) {
+    attribMutex.lock();
+    setGeometry(numVertices, positions, numIndices, indices);
+    for (unsigned i = 0; i < myVertices.size(); i++)
+        VertexFormat::packColor(color, myVertices[i].color);
+    myAlphaTotal = color.A * myVertices.size();
+    myAlpha = color.A;
+    myChanges.post(myVertices, 0, myVertices.size());
+    attribMutex.unlock();
+}
+
+ /*!
+  * \brief Explicitly constructs a new multicolored Mesh.
+  * \details Explicit constructor for a Mesh object.
+  *   \param x The x coordinate of the Mesh's center.
+  *   \param y The y coordinate of the Mesh's center.
+  *   \param z The z coordinate of the Mesh's center.
+  *   \param numVertices The number of vertices in the Mesh.
+  *   \param positions An array of 3 * numVertices floats, the x-y-z of each vertex relative to the center.
+  *   \param numIndices The number of indices, a multiple of 3; 0 to draw every three vertices as a triangle.
+  *   \param indices An array of numIndices indices into the vertices, or NULL.
+  *   \param yaw The Mesh's yaw.
+  *   \param pitch The Mesh's pitch.
+  *   \param roll The Mesh's roll.
+  *   \param color An array of numVertices ColorFloats, one per vertex.
+  * \return A new Mesh with the specified vertices, indices and colors.
+  */
+Mesh::Mesh(float x, float y, float z, int numVertices, const GLfloat positions[], int numIndices, const GLuint indices[], float yaw, float pitch, float roll, ColorFloat color[]) : Drawable(x,y,z,yaw,pitch,roll) {
+    attribMutex.lock();
+    setGeometry(numVertices, positions, numIndices, indices);
+    if (color == NULL && !myVertices.empty()) {
+        TsglDebug("Cannot color a Mesh from a NULL array of colors.");
+        myVertices.clear();
+        myIndices.clear();
+        init = false;
+    }
+    for (unsigned i = 0; i < myVertices.size(); i++) {
+        VertexFormat::packColor(color[i], myVertices[i].color);
+        myAlphaTotal += color[i].A;
+    }
+    if (!myVertices.empty())
+        myAlpha = myAlphaTotal / myVertices.size();
+    myChanges.post(myVertices, 0, myVertices.size());
+    attribMutex.unlock();
+}
+
+// Copies the positions and indices shared by both constructors; leaves the Mesh empty, and reports why, if they are invalid
+void Mesh::setGeometry(int numVertices, const GLfloat positions[], int numIndices, const GLuint indices[]) {
+    myXScale = myYScale = myZScale = 1;
+    if (numVertices < 3) {
+        TsglDebug("Cannot have a Mesh with fewer than 3 vertices.");
+        return;
+    }
+    if (positions == NULL) {
+        TsglDebug("Cannot build a Mesh from a NULL array of positions.");
+        return;
+    }
+    if (numIndices < 0) {
+        TsglDebug("Cannot have a Mesh with a negative number of indices.");
+        return;
+    }
+    if (numIndices > 0) {
+        if (numIndices % 3 != 0 || !indices) {
+            TsglDebug("A Mesh's number of indices must be a multiple of 3.");
+            return;
+        }
+        for (int i = 0; i < numIndices; i++) {
+            if (indices[i] >= (GLuint)numVertices) {
+                TsglDebug("A Mesh's indices must be less than its number of vertices.");
+                return;
+            }
+        }
+        myIndices.assign(indices, indices + numIndices);
+    }
+    myVertices.resize(numVertices);
+    for (int i = 0; i < numVertices; i++) {
+        myVertices[i].x = positions[i*3];
+        myVertices[i].y = positions[i*3 + 1];
+        myVertices[i].z = positions[i*3 + 2];
+    }
+    init = true;
+}
+
+/*!
+ * \brief Draw the Mesh.
+ * \details This function actually draws the Mesh to the Canvas, from its own vertex buffer rather than the
+ *   Canvas' one. Only the vertices changed since the last frame are copied and uploaded, and
+ *   <code>attribMutex</code> is not locked.
+ * \note This function overrides Drawable::draw()
+ */
+void Mesh::draw(Shader * shader) {
+    if (!init) {
+        TsglDebug("Vertex buffer is not full.");
+        return;
+    }
+    glm::mat4 model = modelMatrix();
+
+    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+    GLint canvasBuffer;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &canvasBuffer);
+    GLint posAttrib = glGetAttribLocation(shader->ID, "aPos");
+    GLint colAttrib = glGetAttribLocation(shader->ID, "aColor");
+
+    myChanges.receive(myDrawn, myVertexBuffer);
+    myVertexBuffer.bind(GL_ARRAY_BUFFER, myDrawn.data(), myDrawn.size() * sizeof(PackedVertex));
+    VertexFormat::setLayout(posAttrib, colAttrib);
+    if (!myIndices.empty()) {
+        myIndexBuffer.bind(GL_ELEMENT_ARRAY_BUFFER, myIndices.data(), myIndices.size() * sizeof(GLuint));
+        glDrawElements(GL_TRIANGLES, myIndices.size(), GL_UNSIGNED_INT, (void*)0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    } else {
+        glDrawArrays(GL_TRIANGLES, 0, myDrawn.size() / 3 * 3);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, canvasBuffer);
+    VertexFormat::setLayout(posAttrib, colAttrib);
+}
+
+/**
+ * \brief Moves a range of the Mesh's vertices.
+ * \details Only the given range is uploaded to the GPU the next time the Mesh is drawn.
+ * \param first The index of the first vertex to move.
+ * \param count The number of vertices to move.
+ * \param positions An array of 3 * count floats, the new x-y-z of each vertex relative to the center.
+ */
+void Mesh::updateVertices(int first, int count, const GLfloat positions[]) {
+    attribMutex.lock();
+    if (first < 0 || count < 0 || first + count > (int)myVertices.size()) {
+        attribMutex.unlock();
+        TsglDebug("Cannot update vertices outside of the Mesh.");
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        myVertices[first + i].x = positions[i*3];
+        myVertices[first + i].y = positions[i*3 + 1];
+        myVertices[first + i].z = positions[i*3 + 2];
+    }
+    myChanges.post(myVertices, first, count);
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Recolors a range of the Mesh's vertices.
+ * \details Only the given range is uploaded to the GPU the next time the Mesh is drawn.
+ * \param first The index of the first vertex to recolor.
+ * \param count The number of vertices to recolor.
+ * \param colors An array of count ColorFloats, one per vertex.
+ */
+void Mesh::updateColors(int first, int count, const ColorFloat colors[]) {
+    attribMutex.lock();
+    if (first < 0 || count < 0 || first + count > (int)myVertices.size()) {
+        attribMutex.unlock();
+        TsglDebug("Cannot update colors outside of the Mesh.");
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        myAlphaTotal -= myVertices[first + i].color[3] / 255.0f;
+        VertexFormat::packColor(colors[i], myVertices[first + i].color);
+        myAlphaTotal += colors[i].A;
+    }
+    myAlpha = myAlphaTotal / myVertices.size();
+    myChanges.post(myVertices, first, count);
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Sets the Mesh to a new color.
+ * \param c The new ColorFloat.
+ */
+void Mesh::setColor(ColorFloat c) {
+    attribMutex.lock();
+    for (unsigned i = 0; i < myVertices.size(); i++)
+        VertexFormat::packColor(c, myVertices[i].color);
+    myAlphaTotal = c.A * myVertices.size();
+    myAlpha = c.A;
+    myChanges.post(myVertices, 0, myVertices.size());
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Sets the Mesh to a new array of colors.
+ * \param c The new array of ColorFloats, one per vertex.
+ */
+void Mesh::setColor(ColorFloat c[]) {
+    updateColors(0, myVertices.size(), c);
+}
+
+/**
+ * \brief Accessor for Mesh's color.
+ * \details Returns the color of Mesh's first vertex.
+ * \note For multicolored Meshes, use getColors() to access a vector of all relevant colors.
+ */
+ColorFloat Mesh::getColor() {
+    attribMutex.lock();
+    ColorFloat c = myVertices.empty() ? ColorFloat() : VertexFormat::unpackColor(myVertices[0].color);
+    attribMutex.unlock();
+    return c;
+}
+
+/**
+ * \brief Accessor for Mesh's colors.
+ * \details Populates the reference parameter vector with a ColorFloat for each vertex of Mesh.
+ * \param colorVec A vector of ColorFloats to which the ColorFloats associated with Mesh will be pushed.
+ */
+void Mesh::getColors(std::vector<ColorFloat> &colorVec) {
+    attribMutex.lock();
+    for (unsigned i = 0; i < myVertices.size(); i++)
+        colorVec.push_back(VertexFormat::unpackColor(myVertices[i].color));
+    attribMutex.unlock();
+}
+
+}
@@ -0,0 +1,68 @@
+/*
+ * Mesh.h extends Drawable and provides a class for drawing a large custom mesh that stays on the GPU.
+ */
+
+#ifndef MESH_H_
+#define MESH_H_
+
+#include "Drawable.h"      // For extending our Drawable object
+#include "GpuBuffer.h"     // For keeping the vertices on the GPU between frames
+#include "VertexFormat.h"  // For the compact format the shape shader reads
+#include "VertexMailbox.h" // For handing changed vertices to the render thread
+#include <vector>          // For vertex and index storage
+
+namespace tsgl {
+
+/*! \class Mesh
+ *  \brief Draw an arbitrary triangle mesh with colored vertices, optionally indexed.
+ *  \details Mesh is a class for holding vertex data for a large mesh, such as a terrain or a deforming surface,
+ *   as a single Drawable.
+ *  \details Vertex positions are given relative to the Mesh's center, three floats (x, y, z) per vertex. If indices
+ *   are given, every three indices make up a triangle; otherwise every three vertices do.
+ *  \details The vertices are uploaded to the GPU the first time the Mesh is drawn and are kept there. Changing part
+ *   of the Mesh with updateVertices() or updateColors() only uploads the vertices that changed, so a surface that
+ *   moves 1% of its vertices per frame only sends 1% of them to the GPU.
+ *  \details The render thread draws from its own copy of the vertices, which it brings up to date from the
+ *   changed ranges, so drawing never waits for a thread that is changing the Mesh.
+ */
+class Mesh : public Drawable {
+ private:
+    std::vector<PackedVertex> myVertices;
+    std::vector<PackedVertex> myDrawn;     // The render thread's copy of myVertices
+    VertexMailbox myChanges;               // Ranges of myVertices changed since the render thread's copy
+    std::vector<GLuint> myIndices;         // Empty if the Mesh is drawn straight from its vertices; never changes after construction
+    GpuBuffer myVertexBuffer{GL_DYNAMIC_DRAW};
+    GpuBuffer myIndexBuffer{GL_STATIC_DRAW};
+    float myAlphaTotal = 0;                // Sum of the vertices' alphas, for myAlpha
+
+    void setGeometry(int numVertices, const GLfloat positions[], int numIndices, const GLuint indices[]);
+ public:
+    Mesh(float x, float y, float z, int numVertices, const GLfloat positions[], int numIndices, const GLuint indices[], float yaw, float pitch, float roll, ColorFloat color);
+
+    Mesh(float x, float y, float z, int numVertices, const GLfloat positions[], int numIndices, const GLuint indices[], float yaw, float pitch, float roll, ColorFloat color[]);
+
+    virtual void draw(Shader * shader);
+
+    void updateVertices(int first, int count, const GLfloat positions[]);
+
+    void updateColors(int first, int count, const ColorFloat colors[]);
+
+    virtual void setColor(ColorFloat c);
+    virtual void setColor(ColorFloat c[]);
+    virtual ColorFloat getColor();
+    virtual void getColors(std::vector<ColorFloat> &colorVec);
+
+    /*!
+     * \brief Accessor for the number of vertices in the Mesh.
+     */
+    int getVertexCount() { return myVertices.size(); }
+
+    /*!
+     * \brief Accessor for the number of indices in the Mesh (0 if it is not indexed).
+     */
+    int getIndexCount() { return myIndices.size(); }
+};
+
+}
+
+#endif /* MESH_H_ */
@@ -0,0 +1,47 @@
+#include "ObjectPool.h"
+
+namespace tsgl {
+
+/*!
+ * \brief Destroys the pool, freeing every chunk.
+ * \warning Any objects still living in the pool's blocks must have been destroyed first.
+ */
+ObjectPool::~ObjectPool() {
+    for (unsigned i = 0; i < myChunks.size(); i++)
+        ::operator delete(myChunks[i]);
+}
+
+/*!
+ * \brief Hands out a block of memory.
+ * \details Reuses a freed block of the same size if there is one; otherwise carves one from a new chunk of
+ *   BLOCKS_PER_CHUNK blocks.
+ * \param bytes The size of the object to be stored.
+ * \return A block of at least <code>bytes</code> bytes.
+ */
+void* ObjectPool::allocate(size_t bytes) {
+    size_t size = (bytes + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+    std::lock_guard<std::mutex> lock(myMutex);
+    std::vector<void*>& free = myFreeBlocks[size];
+    if (free.empty()) {
+        char* chunk = (char*) ::operator new(size * BLOCKS_PER_CHUNK);
+        myChunks.push_back(chunk);
+        for (size_t i = BLOCKS_PER_CHUNK; i > 0; i--)
+            free.push_back(chunk + (i - 1) * size);
+    }
+    void* block = free.back();
+    free.pop_back();
+    return block;
+}
+
+/*!
+ * \brief Takes back a block for reuse.
+ * \param block A block from allocate(), whose object has already been destroyed.
+ * \param bytes The size passed to allocate().
+ */
+void ObjectPool::deallocate(void* block, size_t bytes) {
+    size_t size = (bytes + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+    std::lock_guard<std::mutex> lock(myMutex);
+    myFreeBlocks[size].push_back(block);
+}
+
+}
@@ -0,0 +1,47 @@
+/*
+ * ObjectPool.h provides recycled storage for objects that are created and destroyed at a high rate.
+ */
+
+#ifndef OBJECTPOOL_H_
+#define OBJECTPOOL_H_
+
+#include <cstddef>       // For size_t
+#include <map>           // For the free blocks of each size
+#include <mutex>         // For locking the pool
+#include <vector>        // For the free lists and chunks
+
+namespace tsgl {
+
+/*! \class ObjectPool
+ *  \brief Hands out blocks of memory carved from large chunks, and keeps freed blocks for reuse.
+ *  \details Blocks are rounded up to a multiple of 64 bytes and grouped by that size, so objects of the same
+ *    class always reuse each other's blocks. Freed blocks are never returned to the system until the pool is
+ *    destroyed, so spawning and despawning objects every frame costs no calls to the global allocator once the
+ *    pool has warmed up.
+ *  \details Blocks are aligned for any fundamental type.
+ *  \note ObjectPool only manages memory; its user constructs and destroys objects in the blocks.
+ */
+class ObjectPool {
+ private:
+    std::map<size_t, std::vector<void*> > myFreeBlocks;  // Free blocks of each block size
+    std::vector<void*> myChunks;
+    std::mutex myMutex;
+ public:
+    static const size_t BLOCK_ALIGNMENT = 64;
+    static const size_t BLOCKS_PER_CHUNK = 64;
+
+    ObjectPool() { }
+
+    ~ObjectPool();
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    void* allocate(size_t bytes);
+
+    void deallocate(void* block, size_t bytes);
+};
+
+}
+
+#endif /* OBJECTPOOL_H_ */
@@ -0,0 +1,382 @@
+#include "ParticleSystem.h"
+
+namespace tsgl {
+
+namespace {
+    // Two triangles forming a square one unit wide, scaled by each particle's size
+    const GLfloat QUAD[] = {
+        -0.5f, -0.5f, 0.0f,   0.5f, -0.5f, 0.0f,   0.5f, 0.5f, 0.0f,
+        -0.5f, -0.5f, 0.0f,   0.5f,  0.5f, 0.0f,  -0.5f, 0.5f, 0.0f
+    };
+
+    // Longest step the simulation takes at once, so that a stalled frame does not fling particles
+    const float MAX_STEP = 0.1f;
+}
+
+ /*!
+  * \brief Explicitly constructs a new, empty ParticleSystem.
+  * \details Explicit constructor for a ParticleSystem object. Every array is allocated here, for the whole capacity.
+  *   \param x The x coordinate of the ParticleSystem's center.
+  *   \param y The y coordinate of the ParticleSystem's center.
+  *   \param z The z coordinate of the ParticleSystem's center.
+  *   \param capacity The largest number of particles alive at once.
+  *   \param yaw The ParticleSystem's yaw.
+  *   \param pitch The ParticleSystem's pitch.
+  *   \param roll The ParticleSystem's roll.
+  * \return A new ParticleSystem with no emitters or particles, a downward gravity of 100 units per second squared,
+  *   no drag, and particles that fade from white to transparent.
+  */
+ParticleSystem::ParticleSystem(float x, float y, float z, unsigned capacity, float yaw, float pitch, float roll)
+: Drawable(x,y,z,yaw,pitch,roll) {
+    attribMutex.lock();
+    myXScale = myYScale = myZScale = 1;
+    shaderType = INSTANCE_SHADER_TYPE;
+    attribMutex.unlock();
+    myCapacity = capacity;
+    for (int a = 0; a < FLOAT_ARRAYS; a++)
+        myFloats[a].resize(capacity);
+    myColors.resize(capacity * 4);
+    myVisible.resize(capacity);
+    myFree.reserve(capacity);
+    setColorRamp(WHITE, ColorFloat(1, 1, 1, 0));
+    init = true;
+}
+
+/*!
+ * \brief Draw the ParticleSystem.
+ * \details This function actually draws the ParticleSystem to the Canvas. It first advances the simulation by
+ *   the time since the last frame, then draws every particle slot in use with one glDrawArraysInstanced() call;
+ *   dead particles are clipped by the shader.
+ * \note This function overrides Drawable::draw()
+ */
+void ParticleSystem::draw(Shader * shader) {
+    if (!init) {
+        TsglDebug("Vertex buffer is not full.");
+        return;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    float dt = myRunning ? std::chrono::duration<float>(now - myLastStep).count() : 0;
+    myLastStep = now;
+
+    glm::mat4 model = modelMatrix();
+    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+    myArrayMutex.lock();
+    step((dt < MAX_STEP) ? dt : MAX_STEP);
+    myRunning = myAlive > 0;
+    for (unsigned i = 0; i < myEmitters.size(); i++)
+        myRunning = myRunning || myEmitters[i].rate > 0;
+    unsigned n = myUsed;
+    if (n > 0) {
+        GLint canvasBuffer;
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &canvasBuffer);
+        GLint posAttrib = glGetAttribLocation(shader->ID, "aPos");
+        GLint xAttrib = glGetAttribLocation(shader->ID, "aX");
+        GLint yAttrib = glGetAttribLocation(shader->ID, "aY");
+        GLint zAttrib = glGetAttribLocation(shader->ID, "aZ");
+        GLint scaleAttrib = glGetAttribLocation(shader->ID, "aScale");
+        GLint colAttrib = glGetAttribLocation(shader->ID, "aColor");
+        GLint visAttrib = glGetAttribLocation(shader->ID, "aVisible");
+        const char* const rotations[] = { "aYaw", "aPitch", "aRoll" };
+        for (int r = 0; r < 3; r++)
+            glVertexAttrib1f(glGetAttribLocation(shader->ID, rotations[r]), 0.0f);
+
+        myMeshBuffer.bind(GL_ARRAY_BUFFER, QUAD, sizeof(QUAD));
+        glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (void*)0);
+        GLint instanced[] = { xAttrib, yAttrib, zAttrib, scaleAttrib, colAttrib, visAttrib };
+        for (int a = 0; a < 6; a++) {
+            glEnableVertexAttribArray(instanced[a]);
+            glVertexAttribDivisor(instanced[a], 1);
+        }
+        myXBuffer.bind(GL_ARRAY_BUFFER, myFloats[X].data(), n * sizeof(GLfloat));
+        glVertexAttribPointer(xAttrib, 1, GL_FLOAT, GL_FALSE, 0, (void*)0);
+        myYBuffer.bind(GL_ARRAY_BUFFER, myFloats[Y].data(), n * sizeof(GLfloat));
+        glVertexAttribPointer(yAttrib, 1, GL_FLOAT, GL_FALSE, 0, (void*)0);
+        myZBuffer.bind(GL_ARRAY_BUFFER, myFloats[Z].data(), n * sizeof(GLfloat));
+        glVertexAttribPointer(zAttrib, 1, GL_FLOAT, GL_FALSE, 0, (void*)0);
+        mySizeBuffer.bind(GL_ARRAY_BUFFER, myFloats[SIZE].data(), n * sizeof(GLfloat));
+        glVertexAttribPointer(scaleAttrib, 1, GL_FLOAT, GL_FALSE, 0, (void*)0);
+        myColorBuffer.bind(GL_ARRAY_BUFFER, myColors.data(), n * 4);
+        glVertexAttribPointer(colAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, (void*)0);
+        myVisibleBuffer.bind(GL_ARRAY_BUFFER, myVisible.data(), n);
+        glVertexAttribPointer(visAttrib, 1, GL_UNSIGNED_BYTE, GL_FALSE, 0, (void*)0);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 6, n);
+
+        for (int a = 0; a < 6; a++) {
+            glVertexAttribDivisor(instanced[a], 0);
+            glDisableVertexAttribArray(instanced[a]);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, canvasBuffer);
+    }
+    myArrayMutex.unlock();
+    if (myRunning)
+        markDirty();                             // Keep the Canvas drawing while anything moves
+}
+
+// A uniformly distributed random number between min and max
+float ParticleSystem::random(float min, float max) {
+    float u = (float)(myRandom() - myRandom.min()) / (float)(myRandom.max() - myRandom.min());
+    return min + (max - min) * u;
+}
+
+// Emits a particle from an emitter into a free slot, if there is one; called with myArrayMutex held
+void ParticleSystem::spawn(const ParticleEmitter& e) {
+    unsigned i;
+    if (!myFree.empty()) {
+        i = myFree.back();
+        myFree.pop_back();
+    } else if (myUsed < myCapacity) {
+        i = myUsed++;
+    } else {
+        return;
+    }
+    float angle = (e.direction + random(-e.spread, e.spread)) * PI / 180;
+    float speed = random(e.minSpeed, e.maxSpeed);
+    float life = random(e.minLife, e.maxLife);
+    myFloats[X][i] = e.x;
+    myFloats[Y][i] = e.y;
+    myFloats[Z][i] = e.z;
+    myFloats[VX][i] = speed * cos(angle);
+    myFloats[VY][i] = speed * sin(angle);
+    myFloats[VZ][i] = 0;
+    myFloats[AGE][i] = 0;
+    myFloats[LIFE][i] = (life > 0.001f) ? life : 0.001f;
+    myFloats[SIZE][i] = e.size;
+    for (int c = 0; c < 4; c++)
+        myColors[i*4 + c] = myRamp[c];
+    myVisible[i] = 1;
+    mySizeBuffer.invalidate(i * sizeof(GLfloat), sizeof(GLfloat));
+    myAlive++;
+}
+
+/*!
+ * \brief Advances the simulation; called with myArrayMutex held.
+ * \details Emits from each emitter, then integrates every slot in use, alive or not, in one branch-free pass
+ *   that OpenMP splits across threads and vectorizes, and finally frees the slots of particles that died.
+ * \param dt The time to advance by, in seconds.
+ */
+void ParticleSystem::step(float dt) {
+    for (unsigned e = 0; e < myEmitters.size(); e++) {
+        myEmitDebt[e] += myEmitters[e].rate * dt;
+        int count = (int) myEmitDebt[e];
+        myEmitDebt[e] -= count;
+        for (int i = 0; i < count; i++)
+            spawn(myEmitters[e]);
+    }
+
+    int n = myUsed;
+    GLfloat *x = myFloats[X].data(), *y = myFloats[Y].data(), *z = myFloats[Z].data();
+    GLfloat *vx = myFloats[VX].data(), *vy = myFloats[VY].data(), *vz = myFloats[VZ].data();
+    GLfloat *age = myFloats[AGE].data();
+    const GLfloat *life = myFloats[LIFE].data();
+    GLubyte *colors = myColors.data();
+    const GLubyte *ramp = myRamp;
+    float drag = exp(-myDrag * dt);
+    float gx = myGravity[0] * dt, gy = myGravity[1] * dt, gz = myGravity[2] * dt;
+    #pragma omp parallel for simd schedule(static, STEP_CHUNK) if (n > STEP_CHUNK)
+    for (int i = 0; i < n; i++) {
+        vx[i] = vx[i] * drag + gx;
+        vy[i] = vy[i] * drag + gy;
+        vz[i] = vz[i] * drag + gz;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        z[i] += vz[i] * dt;
+        age[i] += dt;
+        int r = (int) (age[i] / life[i] * (RAMP_SIZE - 1));
+        r = (r < RAMP_SIZE - 1) ? r : RAMP_SIZE - 1;
+        colors[i*4 + 0] = ramp[r*4 + 0];
+        colors[i*4 + 1] = ramp[r*4 + 1];
+        colors[i*4 + 2] = ramp[r*4 + 2];
+        colors[i*4 + 3] = ramp[r*4 + 3];
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (myVisible[i] && age[i] >= life[i]) {
+            myVisible[i] = 0;
+            myFree.push_back(i);
+            myAlive--;
+        }
+    }
+    if (myAlive == 0) {
+        myUsed = 0;
+        myFree.clear();
+    }
+
+    myXBuffer.invalidate(0, n * sizeof(GLfloat));
+    myYBuffer.invalidate(0, n * sizeof(GLfloat));
+    myZBuffer.invalidate(0, n * sizeof(GLfloat));
+    myColorBuffer.invalidate(0, n * 4);
+    myVisibleBuffer.invalidate(0, n);
+}
+
+/**
+ * \brief Adds an emitter.
+ * \param emitter Where and how the emitter emits particles.
+ * \return The ID of the emitter, for emit() and setEmitter().
+ */
+int ParticleSystem::addEmitter(const ParticleEmitter& emitter) {
+    myArrayMutex.lock();
+    myEmitters.push_back(emitter);
+    myEmitDebt.push_back(0);
+    int id = myEmitters.size() - 1;
+    myArrayMutex.unlock();
+    markDirty();
+    return id;
+}
+
+/**
+ * \brief Changes an emitter, for instance to move it or to turn its rate up or down.
+ * \details Particles already emitted are not affected.
+ * \param id The ID returned by addEmitter().
+ * \param emitter The new settings of the emitter.
+ */
+void ParticleSystem::setEmitter(int id, const ParticleEmitter& emitter) {
+    myArrayMutex.lock();
+    if (id < 0 || id >= (int) myEmitters.size()) {
+        myArrayMutex.unlock();
+        TsglDebug("No emitter with that ID.");
+        return;
+    }
+    myEmitters[id] = emitter;
+    myArrayMutex.unlock();
+    markDirty();
+}
+
+/*!
+ * \brief Accessor for the settings of an emitter.
+ * \param id The ID returned by addEmitter().
+ * \return A copy of the emitter's settings, or a default ParticleEmitter if there is no such emitter.
+ */
+ParticleEmitter ParticleSystem::getEmitter(int id) {
+    myArrayMutex.lock();
+    ParticleEmitter e;
+    if (id >= 0 && id < (int) myEmitters.size())
+        e = myEmitters[id];
+    myArrayMutex.unlock();
+    return e;
+}
+
+/**
+ * \brief Emits a burst of particles at once.
+ * \details Particles that do not fit in the ParticleSystem are dropped.
+ * \param id The ID returned by addEmitter().
+ * \param count The number of particles.
+ */
+void ParticleSystem::emit(int id, int count) {
+    myArrayMutex.lock();
+    if (id < 0 || id >= (int) myEmitters.size()) {
+        myArrayMutex.unlock();
+        TsglDebug("No emitter with that ID.");
+        return;
+    }
+    for (int i = 0; i < count; i++)
+        spawn(myEmitters[id]);
+    myArrayMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Mutator for the acceleration of every particle.
+ * \param x The acceleration along the x axis, in units per second squared.
+ * \param y The acceleration along the y axis.
+ * \param z The acceleration along the z axis.
+ */
+void ParticleSystem::setGravity(float x, float y, float z) {
+    myArrayMutex.lock();
+    myGravity[0] = x;
+    myGravity[1] = y;
+    myGravity[2] = z;
+    myArrayMutex.unlock();
+}
+
+/**
+ * \brief Mutator for how quickly particles slow down.
+ * \param drag The rate at which velocity decays: each second, velocity is multiplied by <code>exp(-drag)</code>.
+ */
+void ParticleSystem::setDrag(float drag) {
+    myArrayMutex.lock();
+    myDrag = drag;
+    myArrayMutex.unlock();
+}
+
+/**
+ * \brief Mutator for the colors particles go through over their lifetime.
+ * \details The ramp is sampled into a lookup table of RAMP_SIZE colors, so that the integrator only has to index it.
+ * \param times Array of count fractions of a particle's lifetime, from 0 to 1, in increasing order.
+ * \param colors Array of count colors, the color of particles at the matching time. Colors in between are blended.
+ * \param count The number of colors; at least one.
+ */
+void ParticleSystem::setColorRamp(const float times[], const ColorFloat colors[], int count) {
+    if (count < 1) {
+        TsglDebug("A color ramp needs at least one color.");
+        return;
+    }
+    myArrayMutex.lock();
+    int k = 0;
+    for (int r = 0; r < RAMP_SIZE; r++) {
+        float f = (float) r / (RAMP_SIZE - 1);
+        while (k < count - 1 && times[k + 1] <= f)
+            k++;
+        ColorFloat c = colors[k];
+        if (k < count - 1 && f > times[k]) {
+            float u = (f - times[k]) / (times[k + 1] - times[k]);
+            const ColorFloat& d = colors[k + 1];
+            c = ColorFloat(c.R + (d.R - c.R) * u, c.G + (d.G - c.G) * u, c.B + (d.B - c.B) * u, c.A + (d.A - c.A) * u);
+        }
+        VertexFormat::packColor(c, &myRamp[r * 4]);
+    }
+    myArrayMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Mutator for the colors particles go through over their lifetime, blending from one to another.
+ * \param start The color of newly emitted particles.
+ * \param end The color of particles about to die.
+ */
+void ParticleSystem::setColorRamp(ColorFloat start, ColorFloat end) {
+    const float times[] = { 0, 1 };
+    const ColorFloat colors[] = { start, end };
+    setColorRamp(times, colors, 2);
+}
+
+/**
+ * \brief Advances the simulation at once, on top of the stepping done every frame.
+ * \details Useful for starting a steady effect, such as a fountain, already in full flow.
+ * \param dt The time to advance by, in seconds. Long times are taken in steps of at most 0.1 seconds.
+ */
+void ParticleSystem::update(float dt) {
+    myArrayMutex.lock();
+    for (; dt > 0; dt -= MAX_STEP)
+        step((dt < MAX_STEP) ? dt : MAX_STEP);
+    myArrayMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Kills every particle.
+ */
+void ParticleSystem::clear() {
+    myArrayMutex.lock();
+    for (unsigned i = 0; i < myUsed; i++)
+        myVisible[i] = 0;
+    myVisibleBuffer.invalidate(0, myUsed);
+    myUsed = 0;
+    myAlive = 0;
+    myFree.clear();
+    myArrayMutex.unlock();
+    markDirty();
+}
+
+/*!
+ * \brief Accessor for the number of particles alive.
+ */
+unsigned ParticleSystem::getAliveCount() {
+    myArrayMutex.lock();
+    unsigned alive = myAlive;
+    myArrayMutex.unlock();
+    return alive;
+}
+
+}
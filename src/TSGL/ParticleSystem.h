@@ -0,0 +1,116 @@
+/*
+ * ParticleSystem.h extends Drawable and provides emitters of large numbers of short-lived particles.
+ */
+
+#ifndef PARTICLESYSTEM_H_
+#define PARTICLESYSTEM_H_
+
+#include "Drawable.h"         // For extending our Drawable object
+#include "GpuBuffer.h"        // For keeping the particle arrays on the GPU
+#include "InstrumentedMutex.h" // For locking the particle arrays
+#include "VertexFormat.h"     // For packing colors
+#include <chrono>             // For timing the simulation steps
+#include <random>             // For spreading out emitted particles
+#include <vector>             // For the particle arrays
+
+namespace tsgl {
+
+/*! \struct ParticleEmitter
+ *  \brief Where, how fast and in which directions a ParticleSystem emits particles.
+ *  \details The default emitter sits at the system's center and emits nothing on its own, every way at 50 to 100
+ *    units per second, with particles that live 1 to 2 seconds and are 2 units wide; change the fields as needed.
+ */
+struct ParticleEmitter {
+    float x = 0, y = 0, z = 0;    // Position, relative to the ParticleSystem's center
+    float rate = 0;               // Particles emitted per second, besides those from ParticleSystem::emit()
+    float direction = 90;         // Angle of the velocity in degrees in the xy plane, counterclockwise from +x
+    float spread = 180;           // Largest difference from direction in degrees, either way; 180 is every way
+    float minSpeed = 50, maxSpeed = 100;
+    float minLife = 1, maxLife = 2; // Seconds
+    float size = 2;               // Width of each particle
+};
+
+/*! \class ParticleSystem
+ *  \brief Simulate and draw hundreds of thousands of particles.
+ *  \details Particles are emitted by ParticleEmitters, fly under gravity and drag, change color over their
+ *    lifetime along a ramp, and die when their lifetime is up.
+ *  \details Each attribute of the particles (x coordinates, x velocities, ages, and so on) is kept in its own
+ *    array, allocated once for the capacity given to the constructor. Every frame, the render thread advances
+ *    all particles in a single OpenMP <code>parallel for simd</code> loop over the arrays, and draws them all
+ *    with one instanced draw call of a small square. Dead particles are hidden and their slots are kept on a free
+ *    list to be reused by the next ones emitted, so emitting and dying never allocate memory. Once the system is
+ *    full, new particles are dropped.
+ *  \details The simulation is advanced by the time between frames, so it runs at the same speed whatever the
+ *    frame rate, and needs no thread of its own. Positions are relative to the ParticleSystem's center, and
+ *    the whole system can be moved and rotated like any other Drawable.
+ *  \note ParticleSystems are drawn with Canvas' instanced shader.
+ */
+class ParticleSystem : public Drawable {
+ private:
+    enum { X, Y, Z, VX, VY, VZ, AGE, LIFE, SIZE, FLOAT_ARRAYS };
+    static const int RAMP_SIZE = 256;             // Entries in the color lookup table
+
+    InstrumentedMutex myArrayMutex{"ParticleSystem::arrayMutex"};
+    unsigned myCapacity;
+    unsigned myUsed = 0;                          // Slots below this have held a particle at some point
+    unsigned myAlive = 0;
+    std::vector<GLfloat> myFloats[FLOAT_ARRAYS];
+    std::vector<GLubyte> myColors;                // Four per particle
+    std::vector<GLubyte> myVisible;               // 1 while a particle is alive
+    std::vector<unsigned> myFree;                 // Dead slots below myUsed
+    GLubyte myRamp[RAMP_SIZE * 4];                // Color at each fraction of a particle's life
+
+    std::vector<ParticleEmitter> myEmitters;
+    std::vector<float> myEmitDebt;                // Fraction of a particle each emitter is due
+    float myGravity[3] = { 0, -100, 0 };
+    float myDrag = 0;
+    std::minstd_rand myRandom;
+
+    GpuBuffer myMeshBuffer{GL_STATIC_DRAW};
+    GpuBuffer myXBuffer{GL_STREAM_DRAW}, myYBuffer{GL_STREAM_DRAW}, myZBuffer{GL_STREAM_DRAW};
+    GpuBuffer mySizeBuffer{GL_STREAM_DRAW}, myColorBuffer{GL_STREAM_DRAW}, myVisibleBuffer{GL_STREAM_DRAW};
+    std::chrono::steady_clock::time_point myLastStep;
+    bool myRunning = false;                       // Whether the last step had particles or emitters to simulate
+
+    float random(float min, float max);
+    void spawn(const ParticleEmitter& e);
+    void step(float dt);
+ public:
+    // Particles per OpenMP chunk in the integrator
+    static const int STEP_CHUNK = 4096;
+
+    ParticleSystem(float x, float y, float z, unsigned capacity, float yaw, float pitch, float roll);
+
+    virtual void draw(Shader * shader);
+
+    int addEmitter(const ParticleEmitter& emitter);
+
+    void setEmitter(int id, const ParticleEmitter& emitter);
+
+    ParticleEmitter getEmitter(int id);
+
+    void emit(int id, int count);
+
+    void setGravity(float x, float y, float z);
+
+    void setDrag(float drag);
+
+    void setColorRamp(const float times[], const ColorFloat colors[], int count);
+
+    void setColorRamp(ColorFloat start, ColorFloat end);
+
+    void update(float dt);
+
+    void clear();
+
+    unsigned getAliveCount();
+
+    /*!
+     * \brief Accessor for the largest number of particles alive at once.
+     */
+    unsigned getCapacity() { return myCapacity; }
+};
+
+}
+
+#endif /* PARTICLESYSTEM_H_ */
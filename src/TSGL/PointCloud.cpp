@@ -0,0 +1,196 @@
+#include "PointCloud.h"
+
+namespace tsgl {
+
+namespace {
+    // A point as uploaded: a PackedVertex followed by its size in pixels
+    struct PointVertex {
+        PackedVertex vertex;
+        GLfloat size;
+    };
+}
+
+ /*!
+  * \brief Explicitly constructs a new PointCloud.
+  * \details Explicit constructor for a PointCloud object. The arrays are not copied.
+  *   \param x The x coordinate of the PointCloud's center.
+  *   \param y The y coordinate of the PointCloud's center.
+  *   \param z The z coordinate of the PointCloud's center.
+  *   \param numPoints The number of points.
+  *   \param xs An array of numPoints x coordinates, relative to the center.
+  *   \param ys An array of numPoints y coordinates, relative to the center.
+  *   \param zs An array of numPoints z coordinates, relative to the center, or NULL to put every point at z = 0.
+  *   \param yaw The PointCloud's yaw.
+  *   \param pitch The PointCloud's pitch.
+  *   \param roll The PointCloud's roll.
+  *   \param color The color of every point, until setColors() is called.
+  *   \param size The size of every point in pixels, until setSizes() is called.
+  * \return A new PointCloud drawing the given arrays.
+  */
+PointCloud::PointCloud(float x, float y, float z, int numPoints, const GLfloat xs[], const GLfloat ys[], const GLfloat zs[], float yaw, float pitch, float roll, ColorFloat color, GLfloat size) : Drawable(x,y,z,yaw,pitch,roll) {
+    attribMutex.lock();
+    myXScale = myYScale = myZScale = 1;
+    myNumPoints = 0;
+    myXs = myYs = myZs = mySizes = nullptr;
+    myColors = nullptr;
+    myColor = color;
+    myAlpha = color.A;
+    mySize = size;
+    attribMutex.unlock();
+    setPositions(numPoints, xs, ys, zs);
+}
+
+/*!
+ * \brief Draw the PointCloud.
+ * \details This function actually draws the PointCloud to the Canvas. The caller's arrays are interleaved
+ *   straight into a mapped buffer, in a single pass, and drawn as GL_POINTS. The arrays and settings are read
+ *   through <code>attribMutex</code>'s sequence counter rather than by locking it.
+ * \note This function overrides Drawable::draw()
+ */
+void PointCloud::draw(Shader * shader) {
+    if (!init) {
+        TsglDebug("Vertex buffer is not full.");
+        return;
+    }
+    glm::mat4 model = modelMatrix();
+
+    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+    GLint canvasBuffer;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &canvasBuffer);
+    GLint posAttrib = glGetAttribLocation(shader->ID, "aPos");
+    GLint colAttrib = glGetAttribLocation(shader->ID, "aColor");
+    GLint sizeAttrib = glGetAttribLocation(shader->ID, "aSize");
+
+    // Copy the settings through the lock's sequence counter, so a thread changing them never holds up the frame
+    int n;
+    const GLfloat * xs, * ys, * zs, * sizes;
+    const ColorFloat * colors;
+    ColorFloat pointColor;
+    GLfloat pointSize;
+    unsigned seq;
+    do {
+        seq = attribMutex.readBegin();
+        n = myNumPoints;
+        xs = myXs; ys = myYs; zs = myZs;
+        colors = myColors;
+        sizes = mySizes;
+        pointColor = myColor;
+        pointSize = mySize;
+    } while (attribMutex.readRetry(seq));
+
+    PointVertex * out = (PointVertex *) myBuffer.map(GL_ARRAY_BUFFER, n * sizeof(PointVertex));
+    if (!out) {
+        glBindBuffer(GL_ARRAY_BUFFER, canvasBuffer);
+        return;
+    }
+    GLubyte color[4];
+    VertexFormat::packColor(pointColor, color);
+    for (int i = 0; i < n; i++) {
+        out[i].vertex.x = xs[i];
+        out[i].vertex.y = ys[i];
+        out[i].vertex.z = zs ? zs[i] : 0;
+        if (colors) {
+            VertexFormat::packColor(colors[i], out[i].vertex.color);
+        } else {
+            out[i].vertex.color[0] = color[0]; out[i].vertex.color[1] = color[1];
+            out[i].vertex.color[2] = color[2]; out[i].vertex.color[3] = color[3];
+        }
+        out[i].size = sizes ? sizes[i] : pointSize;
+    }
+    myBuffer.unmap(GL_ARRAY_BUFFER);
+
+    glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, sizeof(PointVertex), (void*)0);
+    glVertexAttribPointer(colAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(PointVertex), (void*)(3 * sizeof(GLfloat)));
+    glVertexAttribPointer(sizeAttrib, 1, GL_FLOAT, GL_FALSE, sizeof(PointVertex), (void*)sizeof(PackedVertex));
+    glEnableVertexAttribArray(sizeAttrib);
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    glDrawArrays(GL_POINTS, 0, n);
+    glDisable(GL_PROGRAM_POINT_SIZE);
+    glDisableVertexAttribArray(sizeAttrib);
+
+    glBindBuffer(GL_ARRAY_BUFFER, canvasBuffer);
+    VertexFormat::setLayout(posAttrib, colAttrib);
+}
+
+/**
+ * \brief Points the PointCloud at new position arrays.
+ * \param numPoints The number of points.
+ * \param xs An array of numPoints x coordinates, relative to the center.
+ * \param ys An array of numPoints y coordinates, relative to the center.
+ * \param zs An array of numPoints z coordinates, relative to the center, or NULL to put every point at z = 0.
+ * \note Per-point color and size arrays, if any, must hold at least numPoints elements too.
+ */
+void PointCloud::setPositions(int numPoints, const GLfloat xs[], const GLfloat ys[], const GLfloat zs[]) {
+    if (numPoints < 0 || (numPoints > 0 && (!xs || !ys))) {
+        TsglDebug("Cannot have a PointCloud without x and y coordinates for every point.");
+        return;
+    }
+    attribMutex.lock();
+    myNumPoints = numPoints;
+    myXs = xs;
+    myYs = ys;
+    myZs = zs;
+    init = true;
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Gives every point its own color.
+ * \param colors An array of ColorFloats, one per point, or NULL to draw every point in the color from setColor().
+ */
+void PointCloud::setColors(const ColorFloat colors[]) {
+    attribMutex.lock();
+    myColors = colors;
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Gives every point its own size.
+ * \param sizes An array of sizes in pixels, one per point, or NULL to draw every point at the size from setSize().
+ */
+void PointCloud::setSizes(const GLfloat sizes[]) {
+    attribMutex.lock();
+    mySizes = sizes;
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Sets the size of every point without a size of its own.
+ * \param size The new size in pixels.
+ */
+void PointCloud::setSize(GLfloat size) {
+    attribMutex.lock();
+    mySize = size;
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Sets the color of every point without a color of its own.
+ * \param c The new ColorFloat.
+ */
+void PointCloud::setColor(ColorFloat c) {
+    attribMutex.lock();
+    myColor = c;
+    myAlpha = c.A;
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Accessor for the PointCloud's color.
+ * \return The color of every point without a color of its own.
+ */
+ColorFloat PointCloud::getColor() {
+    attribMutex.lock();
+    ColorFloat c = myColor;
+    attribMutex.unlock();
+    return c;
+}
+
+}
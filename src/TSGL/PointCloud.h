@@ -0,0 +1,70 @@
+/*
+ * PointCloud.h extends Drawable and provides a class for drawing many points read from arrays the caller owns.
+ */
+
+#ifndef POINTCLOUD_H_
+#define POINTCLOUD_H_
+
+#include "Drawable.h"      // For extending our Drawable object
+#include "GpuBuffer.h"     // For writing the points straight into GPU memory
+#include "VertexFormat.h"  // For packing colors
+
+namespace tsgl {
+
+/*! \class PointCloud
+ *  \brief Draw a large number of points with one Drawable.
+ *  \details PointCloud draws N points as GL_POINTS in a single draw call, for particle systems and agent
+ *   simulations that would otherwise need a Dot or Circle per point.
+ *  \details The PointCloud does not copy the points. It keeps pointers to the caller's arrays, in
+ *   structure-of-arrays form (one array of x coordinates, one of y, ...), and reads them every time it is drawn,
+ *   writing them straight into a mapped GPU buffer. Positions are relative to the PointCloud's center.
+ *  \details Colors and sizes (in pixels) may be given per point, or set once for every point.
+ *  \details After changing the arrays, call update() so the Canvas draws a new frame.
+ *  \note The arrays must stay alive, and hold at least as many elements as there are points, until the
+ *   PointCloud is destroyed, or until the frame after it is pointed at other arrays: drawing does not lock the
+ *   PointCloud, so a frame already in progress may still read the old arrays. Canvas::waitForRedraw() waits for
+ *   that frame.
+ *  \warning The arrays are read while the Canvas draws, so a point written at the same time may be drawn half
+ *   updated for a frame.
+ */
+class PointCloud : public Drawable {
+ private:
+    int myNumPoints;
+    const GLfloat * myXs, * myYs, * myZs;  // Caller's positions; myZs may be NULL for a flat cloud
+    const ColorFloat * myColors;           // Caller's colors, or NULL for myColor
+    const GLfloat * mySizes;               // Caller's sizes, or NULL for mySize
+    ColorFloat myColor;
+    GLfloat mySize;
+    GpuBuffer myBuffer{GL_STREAM_DRAW};
+ public:
+    PointCloud(float x, float y, float z, int numPoints, const GLfloat xs[], const GLfloat ys[], const GLfloat zs[], float yaw, float pitch, float roll, ColorFloat color, GLfloat size = 1);
+
+    virtual void draw(Shader * shader);
+
+    void setPositions(int numPoints, const GLfloat xs[], const GLfloat ys[], const GLfloat zs[]);
+
+    void setColors(const ColorFloat colors[]);
+
+    void setSizes(const GLfloat sizes[]);
+
+    void setSize(GLfloat size);
+
+    virtual void setColor(ColorFloat c);
+
+    virtual ColorFloat getColor();
+
+    /*!
+     * \brief Tells the PointCloud that the caller changed its arrays.
+     * \details The points are read again when the next frame is drawn.
+     */
+    void update() { markDirty(); }
+
+    /*!
+     * \brief Accessor for the number of points.
+     */
+    int getNumPoints() { return myNumPoints; }
+};
+
+}
+
+#endif /* POINTCLOUD_H_ */
@@ -12,16 +12,19 @@ namespace tsgl {
   *   \param yaw The Polyline's yaw.
   *   \param pitch The Polyline's pitch.
   *   \param roll The Polyline's roll.
+  *   \param vertexStorage An array of <code>numVertices * 7</code> floats for the vertices, owned by the subclass
+  *     (as in Line), or NULL to allocate one.
   * \warning An invariant is held where if v is less than 2 then an error message is given.
   * \return A new Polyline with a buffer for storing the specified numbered of vertices.
   */
-Polyline::Polyline(float x, float y, float z, int numVertices, float yaw, float pitch, float roll) : Drawable(x,y,z,yaw,pitch,roll) {
+Polyline::Polyline(float x, float y, float z, int numVertices, float yaw, float pitch, float roll, GLfloat vertexStorage[]) : Drawable(x,y,z,yaw,pitch,roll) {
     if (numVertices < 2)
       TsglDebug("Cannot have a line with fewer than 2 vertices.");
     attribMutex.lock();
     numberOfVertices = numVertices;
     myXScale = myYScale = myZScale = 1;
-    vertices = new GLfloat[numberOfVertices * 7];
+    myVerticesInline = (vertexStorage != nullptr);
+    vertices = myVerticesInline ? vertexStorage : new GLfloat[numberOfVertices * 7];
     attribMutex.unlock();
 }
 
@@ -93,19 +96,53 @@ void Polyline::draw(Shader * shader) {
         TsglDebug("Vertex buffer is not full.");
         return;
     }
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(myRotationPointX, myRotationPointY, myRotationPointZ));
-    model = glm::rotate(model, glm::radians(myCurrentYaw), glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::rotate(model, glm::radians(myCurrentPitch), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(myCurrentRoll), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::translate(model, glm::vec3(myCenterX - myRotationPointX, myCenterY - myRotationPointY, myCenterZ - myRotationPointZ));
-    model = glm::scale(model, glm::vec3(myXScale, myYScale, myZScale));
+    if (std::vector<PackedVertex> * posted = myPosted.take()) {
+        myPacked.swap(*posted);
+        delete posted;
+        myBuffer.invalidateAll();
+    }
+    glm::mat4 model = modelMatrix();
 
     unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
     glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
 
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfVertices * 7, vertices, GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_LINE_STRIP, 0, numberOfVertices);
+    GLint canvasBuffer;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &canvasBuffer);
+    GLint posAttrib = glGetAttribLocation(shader->ID, "aPos");
+    GLint colAttrib = glGetAttribLocation(shader->ID, "aColor");
+
+    myBuffer.bind(GL_ARRAY_BUFFER, myPacked.data(), myPacked.size() * sizeof(PackedVertex));
+    VertexFormat::setLayout(posAttrib, colAttrib);
+    glDrawArrays(GL_LINE_STRIP, 0, myPacked.size());
+
+    glBindBuffer(GL_ARRAY_BUFFER, canvasBuffer);
+    VertexFormat::setLayout(posAttrib, colAttrib);
+}
+
+/*!
+ * \brief Packs the vertices, and hands them to the render thread.
+ * \details Every function that changes the vertices or their colors calls this once it is done, so that draw()
+ *   only binds the packed copy, which is uploaded again the next time it is drawn, without locking
+ *   <code>attribMutex</code>.
+ * \note The caller must hold <code>attribMutex</code>.
+ */
+void Polyline::repack() {
+    std::vector<PackedVertex> * packed = new std::vector<PackedVertex>;
+    VertexFormat::pack(vertices, NULL, numberOfVertices, *packed);
+    myPosted.post(packed);
+}
+
+/*!
+ * \brief Appends the Polyline to a Group's batch.
+ * \note This function overrides Drawable::appendBatch()
+ */
+bool Polyline::appendBatch(std::vector<PackedVertex>& out, std::vector<BatchRange>& ranges) {
+    glm::mat4 model = modelMatrix();
+    attribMutex.lock();
+    ranges.push_back(BatchRange{ GL_LINE_STRIP, (GLint) out.size(), numberOfVertices });
+    appendVertices(model, vertices, NULL, numberOfVertices, out);
+    attribMutex.unlock();
+    return true;
 }
 
  /*!
@@ -136,6 +173,7 @@ void Polyline::addVertex(GLfloat x, GLfloat y, GLfloat z, const ColorFloat &colo
     if (currentVertex == numberOfVertices*7) {
         myAlpha /= numberOfVertices;
         init = true;
+        repack();
     }
     attribMutex.unlock();
 }
@@ -153,7 +191,9 @@ void Polyline::setColor(ColorFloat c) {
         vertices[i*7 + 6] = c.A;
     }
     myAlpha = c.A;
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -171,7 +211,9 @@ void Polyline::setColor(ColorFloat c[]) {
         myAlpha += c[i].A;
     }
     myAlpha /= numberOfVertices;
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
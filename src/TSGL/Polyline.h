@@ -6,6 +6,9 @@
 #define POLYLINE_H_
 
 #include "Drawable.h"  // For extending our Drawable object
+#include "GpuBuffer.h" // For keeping the packed vertices on the GPU between frames
+#include "Mailbox.h"   // For handing the packed vertices to the render thread
+#include "VertexFormat.h" // For packing vertices in the compact format the shape shader reads
 
 namespace tsgl {
 
@@ -22,9 +25,13 @@ class Polyline : public Drawable {
  protected:
     int numberOfVertices;
     int currentVertex = 0;
+    Mailbox<std::vector<PackedVertex> > myPosted; // Vertices packed by repack() that draw() has not taken yet
+    std::vector<PackedVertex> myPacked;    // Vertices being drawn; only used by the render thread
+    GpuBuffer myBuffer{GL_DYNAMIC_DRAW};
     virtual void addVertex(GLfloat x, GLfloat y, GLfloat z, const ColorFloat &color = WHITE);
+    void repack();
 
-    Polyline(float x, float y, float z, int numVertices, float yaw, float pitch, float roll);
+    Polyline(float x, float y, float z, int numVertices, float yaw, float pitch, float roll, GLfloat vertexStorage[] = nullptr);
  public:
 
     Polyline(float x, float y, float z, int numVertices, float lineVertices[], float yaw, float pitch, float roll, ColorFloat color);
@@ -33,6 +40,8 @@ class Polyline : public Drawable {
 
     virtual void draw(Shader * shader);
 
+    virtual bool appendBatch(std::vector<PackedVertex>& out, std::vector<BatchRange>& ranges);
+
     virtual void setColor(ColorFloat c);
     virtual void setColor(ColorFloat c[]);
     virtual ColorFloat getColor();
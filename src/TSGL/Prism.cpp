@@ -30,43 +30,10 @@ Prism::Prism(float x, float y, float z, int sides, GLfloat height, GLfloat radiu
     myYScale = height;
     mySides = sides;
     geometryType = GL_TRIANGLES;
-    numberOfVertices = mySides * 12;
-    vertices = new GLfloat[numberOfVertices * 7];
     outlineGeometryType = GL_LINES;
-    numberOfOutlineVertices = mySides * 6;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
     attribMutex.unlock();
-    for (int i = 0; i < mySides; i++) {
-        addVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), c);
-        addVertex(0,0.5,0, c);
-        addVertex(cos(TWOPI * (i + 1) / mySides), 0.5, sin(TWOPI * (i + 1) / mySides), c);
-
-        addVertex(cos(TWOPI * (i + 1) / mySides), 0.5, sin(TWOPI * (i + 1) / mySides), c);
-        addVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), c);
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c);
-
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c);
-        addVertex(cos(TWOPI * (i + 1) / mySides), 0.5, sin(TWOPI * (i + 1) / mySides), c);
-        addVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), c);
-
-        addVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), c);
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c);
-        addVertex(0,-0.5,0, c);
-    }
-
-    for (int i = 0; i < mySides; i++) {
-        addOutlineVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), GRAY);
-        addOutlineVertex(cos(TWOPI * (i + 1) / mySides), 0.5, sin(TWOPI * (i + 1) / mySides), GRAY);
-        currentOutlineVertex += numberOfOutlineVertices * 7 / 3 - 14;
-
-        addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
-        addOutlineVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), GRAY);
-        currentOutlineVertex += numberOfOutlineVertices * 7 / 3 - 14;
-
-        addOutlineVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), GRAY);
-        addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
-        currentOutlineVertex -= numberOfOutlineVertices * 7 * 2 / 3;
-    }
+    useMesh(SharedMesh::acquire(MESH_PRISM, mySides, 0, buildMesh));
+    setColor(c);
 }
 
  /*!
@@ -97,42 +64,63 @@ Prism::Prism(float x, float y, float z, int sides, GLfloat height, GLfloat radiu
     myYScale = height;
     mySides = sides;
     geometryType = GL_TRIANGLES;
-    numberOfVertices = mySides * 12;
-    vertices = new GLfloat[numberOfVertices * 7];
     outlineGeometryType = GL_LINES;
-    numberOfOutlineVertices = mySides * 6;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
     attribMutex.unlock();
-    for (int i = 0; i < mySides; i++) {
-        addVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), c[1]);
-        addVertex(0,0.5,0, c[0]);
-        addVertex(cos(TWOPI * (i + 1) / mySides), 0.5, sin(TWOPI * (i + 1) / mySides), c[1]);
-
-        addVertex(cos(TWOPI * (i + 1) / mySides), 0.5, sin(TWOPI * (i + 1) / mySides), c[2]);
-        addVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), c[2]);
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c[2]);
-
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c[2]);
-        addVertex(cos(TWOPI * (i + 1) / mySides), 0.5, sin(TWOPI * (i + 1) / mySides), c[2]);
-        addVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), c[2]);
+    useMesh(SharedMesh::acquire(MESH_PRISM, mySides, 0, buildMesh));
+    setColor(c);
+}
 
-        addVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), c[3]);
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c[3]);
-        addVertex(0,-0.5,0, c[4]);
+ /*!
+  * \brief Builds the unit prism mesh shared by every Prism and Cylinder with the same number of sides.
+  * \details Each corner is stored once and indexed by the triangles that share it.
+  *   The outline is stored as the edges of the top face, then those of the bottom face, then the
+  *   vertical edges, so that Cylinder can draw just the first two thirds.
+  *   \param sides The number of sides of the Prism's base.
+  *   \param unused Ignored; Prisms only have one tessellation parameter.
+  * \return A new SharedMesh of radius 1 and height 1.
+  */
+SharedMesh * Prism::buildMesh(int sides, int unused) {
+    SharedMesh * mesh = new SharedMesh(sides * 2 + 2, sides * 6, sides * 12);
+    const GLfloat * t = TrigTable::unitCircle(sides);
+    int topCenter = sides * 2, bottomCenter = sides * 2 + 1;
+    for (int i = 0; i < sides; i++) {
+        mesh->setVertex(i, t[i*2], 0.5, t[i*2 + 1]);
+        mesh->setVertex(sides + i, t[i*2], -0.5, t[i*2 + 1]);
     }
+    mesh->setVertex(topCenter, 0,0.5,0);
+    mesh->setVertex(bottomCenter, 0,-0.5,0);
+
+    for (int i = 0; i < sides; i++) {
+        int top0 = i, top1 = (i + 1) % sides, bottom0 = sides + top0, bottom1 = sides + top1;
+        const int corners[12] = { top0, topCenter, top1,
+                                  top1, top0, bottom0,
+                                  bottom0, top1, bottom1,
+                                  bottom1, bottom0, bottomCenter };
+        for (int j = 0; j < 12; j++)
+            mesh->setIndex(i*12 + j, corners[j]);
+    }
+    mesh->setOutlineBuilder(buildOutline, sides, unused);
+    return mesh;
+}
 
-    for (int i = 0; i < mySides; i++) {
-        addOutlineVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), GRAY);
-        addOutlineVertex(cos(TWOPI * (i + 1) / mySides), 0.5, sin(TWOPI * (i + 1) / mySides), GRAY);
-        currentOutlineVertex += numberOfOutlineVertices * 7 / 3 - 14;
-
-        addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
-        addOutlineVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), GRAY);
-        currentOutlineVertex += numberOfOutlineVertices * 7 / 3 - 14;
-
-        addOutlineVertex(cos(TWOPI * i / mySides), 0.5, sin(TWOPI * i / mySides), GRAY);
-        addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
-        currentOutlineVertex -= numberOfOutlineVertices * 7 * 2 / 3;
+ /*!
+  * \brief Fills in the outline of a unit prism mesh, the first time a Prism or Cylinder using it is outlined.
+  *   \param mesh The mesh made by buildMesh().
+  *   \param sides The number of sides of the Prism's base.
+  *   \param unused Ignored; Prisms only have one tessellation parameter.
+  */
+void Prism::buildOutline(SharedMesh& mesh, int sides, int unused) {
+    const GLfloat * t = TrigTable::unitCircle(sides);
+    for (int i = 0; i < sides; i++) {
+        GLfloat x0 = t[i*2], z0 = t[i*2 + 1], x1 = t[i*2 + 2], z1 = t[i*2 + 3];
+        mesh.setOutlineVertex(i*2, x0, 0.5, z0);
+        mesh.setOutlineVertex(i*2 + 1, x1, 0.5, z1);
+
+        mesh.setOutlineVertex(sides*2 + i*2, x0, -0.5, z0);
+        mesh.setOutlineVertex(sides*2 + i*2 + 1, x1, -0.5, z1);
+
+        mesh.setOutlineVertex(sides*4 + i*2, x0, 0.5, z0);
+        mesh.setOutlineVertex(sides*4 + i*2 + 1, x0, -0.5, z0);
     }
 }
 
@@ -149,6 +137,7 @@ void Prism::setHeight(GLfloat height) {
     myHeight = height;
     myYScale = height;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -164,6 +153,7 @@ void Prism::changeHeightBy(GLfloat delta) {
     myHeight += delta;
     myYScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -180,6 +170,7 @@ void Prism::setRadius(GLfloat radius) {
     myXScale = radius;
     myZScale = radius;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -196,6 +187,7 @@ void Prism::changeRadiusBy(GLfloat delta) {
     myXScale += delta;
     myZScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -204,43 +196,25 @@ void Prism::changeRadiusBy(GLfloat delta) {
  * \details The array should have 5 ColorFloats minimum: for the top middle, top outside, sides, bottom outside, and bottom middle respectively.
  */
 void Prism::setColor(ColorFloat c[]) {
+    disableDetail();
     attribMutex.lock();
     myAlpha = 0.0;
     for (int i = 0; i < mySides; i++) {
-        vertices[i*84+3] = c[1].R;
-        vertices[i*84+4] = c[1].G;
-        vertices[i*84+5] = c[1].B;
-        vertices[i*84+6] = c[1].A;
-
-        vertices[i*84+10] = c[0].R;
-        vertices[i*84+11] = c[0].G;
-        vertices[i*84+12] = c[0].B;
-        vertices[i*84+13] = c[0].A;
-
-        vertices[i*84+17] = c[1].R;
-        vertices[i*84+18] = c[1].G;
-        vertices[i*84+19] = c[1].B;
-        vertices[i*84+20] = c[1].A;
-
-        vertices[i*84+24] = vertices[i*84+31] = vertices[i*84+38] = vertices[i*84+45] = vertices[i*84+52] = vertices[i*84+59] = c[2].R;
-        vertices[i*84+25] = vertices[i*84+32] = vertices[i*84+39] = vertices[i*84+46] = vertices[i*84+53] = vertices[i*84+60] = c[2].G;
-        vertices[i*84+26] = vertices[i*84+33] = vertices[i*84+40] = vertices[i*84+47] = vertices[i*84+54] = vertices[i*84+61] = c[2].B;
-        vertices[i*84+27] = vertices[i*84+34] = vertices[i*84+41] = vertices[i*84+48] = vertices[i*84+55] = vertices[i*84+62] = c[2].A;
-
-        vertices[i*84+66] = vertices[i*84+73] = c[3].R;
-        vertices[i*84+67] = vertices[i*84+74] = c[3].G;
-        vertices[i*84+68] = vertices[i*84+75] = c[3].B;
-        vertices[i*84+69] = vertices[i*84+76] = c[3].A;
-
-        vertices[i*84+80] = c[4].R;
-        vertices[i*84+81] = c[4].G;
-        vertices[i*84+82] = c[4].B;
-        vertices[i*84+83] = c[4].A;
+        setVertexColor(i*12, c[1]);
+        setVertexColor(i*12 + 1, c[0]);
+        setVertexColor(i*12 + 2, c[1]);
+        for (int j = 3; j < 9; j++)
+            setVertexColor(i*12 + j, c[2]);
+        setVertexColor(i*12 + 9, c[3]);
+        setVertexColor(i*12 + 10, c[3]);
+        setVertexColor(i*12 + 11, c[4]);
 
         myAlpha += c[0].A + c[1].A * 2 + c[2].A * 6 + c[3].A * 2 + c[4].A;
     }
     myAlpha /= numberOfVertices;
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -251,11 +225,11 @@ void Prism::setColor(ColorFloat c[]) {
  */
 void Prism::getColors(std::vector<ColorFloat> &colorVec) {
     attribMutex.lock();
-    colorVec.push_back(ColorFloat(vertices[10],vertices[11],vertices[12],vertices[13]));
-    colorVec.push_back(ColorFloat(vertices[3],vertices[4],vertices[5],vertices[6]));
-    colorVec.push_back(ColorFloat(vertices[24],vertices[25],vertices[26],vertices[27]));
-    colorVec.push_back(ColorFloat(vertices[66],vertices[67],vertices[68],vertices[69]));
-    colorVec.push_back(ColorFloat(vertices[80],vertices[81],vertices[82],vertices[83]));
+    colorVec.push_back(getVertexColor(1));
+    colorVec.push_back(getVertexColor(0));
+    colorVec.push_back(getVertexColor(3));
+    colorVec.push_back(getVertexColor(9));
+    colorVec.push_back(getVertexColor(11));
     attribMutex.unlock();
 }
 
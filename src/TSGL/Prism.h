@@ -49,6 +49,10 @@ public:
     virtual void setColor(ColorFloat c[]);
 
     virtual void getColors(std::vector<ColorFloat> &colorVec);
+
+    static SharedMesh * buildMesh(int sides, int unused);
+
+    static void buildOutline(SharedMesh& mesh, int sides, int unused);
 };
 
 }
@@ -15,8 +15,7 @@ namespace tsgl {
   * \return A new ProgressBar with the specified coordinates, maximum dimensions, value range, and segments.
   */
 ProgressBar::ProgressBar(float x, float y, float z, float width, float height, float minValue, float maxValue, unsigned numSegments, float yaw, float pitch, float roll)
-: Drawable(x, y, z, yaw, pitch, roll) {
-    shaderType = SHAPE_SHADER_TYPE;
+: Group(x, y, z, yaw, pitch, roll) {
     segRecs = new Rectangle*[numSegments];
     segBorders = new Polyline*[numSegments];
     startX = new float[numSegments];
@@ -30,7 +29,7 @@ ProgressBar::ProgressBar(float x, float y, float z, float width, float height, f
       endX[i] = startX[i] + myWidth/segs;
     }
 
-    // all Polylines can have the same vertices; different locations will be handled with draw()
+    // all Polylines can have the same vertices; they are placed relative to the Group's center
     vertices = new float[15];
     vertices[0] = -(myWidth/segs)/2; vertices[1] = myHeight/2; vertices[2] = 0;
     vertices[3] = -(myWidth/segs)/2; vertices[4] = -myHeight/2; vertices[5] = 0;
@@ -38,12 +37,13 @@ ProgressBar::ProgressBar(float x, float y, float z, float width, float height, f
     vertices[9] = (myWidth/segs)/2; vertices[10] = myHeight/2; vertices[11] = 0;
     vertices[12] = -(myWidth/segs)/2; vertices[13] = myHeight/2; vertices[14] = 0;
     for (int i = 0; i < segs; i++) {
-        segBorders[i] = new Polyline(0,0,0,5,vertices,yaw,pitch,roll,BLACK);
-        segRecs[i] = new Rectangle(0,0,0,myWidth/segs,myHeight,yaw,pitch,roll,Colors::highContrastColor(i));
+        segBorders[i] = new Polyline(0,0,0,5,vertices,0,0,0,BLACK);
+        segBorders[i]->setCenterX((myWidth/segs) * ( (float)i - (float)(segs-1)/2));
+        segRecs[i] = new Rectangle(startX[i] + (myWidth/segs)/2,0,0,myWidth/segs,myHeight,0,0,0,Colors::highContrastColor(i));
         segRecs[i]->setIsOutlined(false);
+        add(segRecs[i]);
+        add(segBorders[i]);
     }
-
-    init = true;
 }
 
  /*!
@@ -52,6 +52,7 @@ ProgressBar::ProgressBar(float x, float y, float z, float width, float height, f
   * \details Frees up memory that was allocated to a ProgressBar instance.
   */
 ProgressBar::~ProgressBar() {
+  clear();
   delete [] startX; delete [] endX;
   for (int i = 0; i < segs; i++) {
       delete segBorders[i];
@@ -60,19 +61,6 @@ ProgressBar::~ProgressBar() {
   delete [] segBorders; delete [] segRecs;
 }
 
-void ProgressBar::draw(Shader * shader) {
-    for (int i = 0; i < segs; i++) {
-        segBorders[i]->setCenter(myCenterX + (myWidth/segs) * ( (float)i - (float)(segs-1)/2), myCenterY, myCenterZ);
-        segRecs[i]->setCenter(myCenterX + (myWidth/segs) * ( (float)i - (float)(segs)/2) + segRecs[i]->getWidth()/2, myCenterY, myCenterZ);
-        segBorders[i]->setRotationPoint(myCenterX, myCenterY, myCenterZ);
-        segRecs[i]->setRotationPoint(myCenterX, myCenterY, myCenterZ);
-        segBorders[i]->setYawPitchRoll(myCurrentYaw, myCurrentPitch, myCurrentRoll);
-        segRecs[i]->setYawPitchRoll(myCurrentYaw, myCurrentPitch, myCurrentRoll);
-        segRecs[i]->draw(shader);
-        segBorders[i]->draw(shader);
-    }
-}
-
  /*!
   * \brief Updates a ProgressBar segment with a new value.
   * \details This function updates the segment <code>seg</code> of the ProgressBar to represent
@@ -93,6 +81,8 @@ void ProgressBar::update(float newValue, int segnum) {
   clamp(newValue,start,end);
   float percent = (newValue-start) / (end-start);
   segRecs[segnum]->setWidth(percent*(myWidth/segs));
+  segRecs[segnum]->setCenterX(startX[segnum] + segRecs[segnum]->getWidth()/2);
+  markDirty();
 }
 
 
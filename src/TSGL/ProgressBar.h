@@ -1,5 +1,5 @@
 /*
- * ProgressBar.h extends Shape and provides a class for drawing a progress bar to a Canvas.
+ * ProgressBar.h extends Group and provides a class for drawing a progress bar to a Canvas.
  */
 
 #ifndef PROGRESSBAR_H
@@ -7,9 +7,9 @@
 
 #include <omp.h>
 
+#include "Group.h"
 #include "Polyline.h"
 #include "Rectangle.h"
-#include "Drawable.h"
 
 namespace tsgl {
 
@@ -18,8 +18,9 @@ namespace tsgl {
  *  \details ProgressBar is a class for holding vertex data for multiple rectangles forming a progress bar.
  *    ProgressBar is formed of multiple segments, each of which is thread-safe and updated individually
  *    with the update() method.  A ProgressBar can be drawn to the screen using Canvas::drawProgress().
+ *  \details The segments are children of a Group, so moving or rotating the ProgressBar does not touch them.
  */
-class ProgressBar : public Drawable {
+class ProgressBar : public Group {
  private:
     Rectangle ** segRecs;
     Polyline ** segBorders;
@@ -34,8 +35,6 @@ class ProgressBar : public Drawable {
 
     ~ProgressBar();
 
-    void draw(Shader * shader);
-
     void update(float newValue, int segnum = -1);
 
     /*!
@@ -34,31 +34,10 @@ Pyramid::Pyramid(float x, float y, float z, int sides, GLfloat height, GLfloat r
     myZScale = radius;
     mySides = sides;
     geometryType = GL_TRIANGLES;
-    numberOfVertices = mySides * 6;
-    vertices = new GLfloat[numberOfVertices * 7];
     outlineGeometryType = GL_LINES;
-    numberOfOutlineVertices = mySides * 4;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
     attribMutex.unlock();
-    for (int i = 0; i < mySides; i++) {
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c);
-        addVertex(0,-0.5,0, c);
-        addVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), c);
-
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c);    
-        addVertex(0,0.5,0, ColorFloat(c.R*.5,c.G*.5,c.B*.5,c.A));
-        addVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), c);
-    }
-
-    for (int i = 0; i < mySides; i++) {
-        addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
-        addOutlineVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), GRAY);
-        currentOutlineVertex += numberOfOutlineVertices * 7 / 2 - 14;
-
-        addOutlineVertex(0, 0.5, 0, GRAY);
-        addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
-        currentOutlineVertex -= numberOfOutlineVertices * 7 / 2;
-    }
+    useMesh(SharedMesh::acquire(MESH_PYRAMID, mySides, 0, buildMesh));
+    setColor(c);
 }
 
  /*!
@@ -93,30 +72,56 @@ Pyramid::Pyramid(float x, float y, float z, int sides, GLfloat height, GLfloat r
     myZScale = radius;
     mySides = sides;
     geometryType = GL_TRIANGLES;
-    numberOfVertices = mySides * 6;
-    vertices = new GLfloat[numberOfVertices * 7];
     outlineGeometryType = GL_LINES;
-    numberOfOutlineVertices = mySides * 4;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
     attribMutex.unlock();
-    for (int i = 0; i < mySides; i++) {
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c[i+1]);
-        addVertex(0,-0.5,0, c[mySides+1]);
-        addVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), c[(i+1) % mySides + 1]);
+    useMesh(SharedMesh::acquire(MESH_PYRAMID, mySides, 0, buildMesh));
+    setColor(c);
+}
 
-        addVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), c[i+1]);    
-        addVertex(0,0.5,0, c[0]);
-        addVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), c[(i+1) % mySides + 1]);
+ /*!
+  * \brief Builds the unit pyramid mesh shared by every Pyramid and Cone with the same number of sides.
+  * \details Each corner is stored once and indexed by the triangles that share it.
+  *   The apex is shaded at half brightness, so that single-colored Pyramids show their sides. The outline is
+  *   stored as the edges of the base followed by the edges to the apex, so that Cone can draw just the base.
+  *   \param sides The number of sides of the Pyramid's base.
+  *   \param unused Ignored; Pyramids only have one tessellation parameter.
+  * \return A new SharedMesh of radius 1 and height 1.
+  */
+SharedMesh * Pyramid::buildMesh(int sides, int unused) {
+    SharedMesh * mesh = new SharedMesh(sides + 2, sides * 4, sides * 6);
+    const GLfloat * t = TrigTable::unitCircle(sides);
+    int center = sides, apex = sides + 1;
+    for (int i = 0; i < sides; i++)
+        mesh->setVertex(i, t[i*2], -0.5, t[i*2 + 1]);
+    mesh->setVertex(center, 0,-0.5,0);
+    mesh->setVertex(apex, 0,0.5,0, .5);
+
+    for (int i = 0; i < sides; i++) {
+        int next = (i + 1) % sides;
+        const int corners[6] = { i, center, next,
+                                 i, apex, next };
+        for (int j = 0; j < 6; j++)
+            mesh->setIndex(i*6 + j, corners[j]);
     }
+    mesh->setOutlineBuilder(buildOutline, sides, unused);
+    return mesh;
+}
 
-    for (int i = 0; i < mySides; i++) {
-        addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
-        addOutlineVertex(cos(TWOPI * (i + 1) / mySides), -0.5, sin(TWOPI * (i + 1) / mySides), GRAY);
-        currentOutlineVertex += numberOfOutlineVertices * 7 / 2 - 14;
-
-        addOutlineVertex(0, 0.5, 0, GRAY);
-        addOutlineVertex(cos(TWOPI * i / mySides), -0.5, sin(TWOPI * i / mySides), GRAY);
-        currentOutlineVertex -= numberOfOutlineVertices * 7 / 2;
+ /*!
+  * \brief Fills in the outline of a unit pyramid mesh, the first time a Pyramid or Cone using it is outlined.
+  *   \param mesh The mesh made by buildMesh().
+  *   \param sides The number of sides of the Pyramid's base.
+  *   \param unused Ignored; Pyramids only have one tessellation parameter.
+  */
+void Pyramid::buildOutline(SharedMesh& mesh, int sides, int unused) {
+    const GLfloat * t = TrigTable::unitCircle(sides);
+    for (int i = 0; i < sides; i++) {
+        GLfloat x0 = t[i*2], z0 = t[i*2 + 1], x1 = t[i*2 + 2], z1 = t[i*2 + 3];
+        mesh.setOutlineVertex(i*2, x0, -0.5, z0);
+        mesh.setOutlineVertex(i*2 + 1, x1, -0.5, z1);
+
+        mesh.setOutlineVertex(sides*2 + i*2, 0, 0.5, 0);
+        mesh.setOutlineVertex(sides*2 + i*2 + 1, x0, -0.5, z0);
     }
 }
 
@@ -135,6 +140,7 @@ void Pyramid::setRadius(float radius) {
     myXScale = radius;
     myZScale = radius;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -152,6 +158,7 @@ void Pyramid::changeRadiusBy(float delta) {
     myXScale += delta;
     myZScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -167,6 +174,7 @@ void Pyramid::setHeight(float height) {
     myHeight = height;
     myYScale = height;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -182,27 +190,7 @@ void Pyramid::changeHeightBy(float delta) {
     myHeight += delta;
     myYScale += delta;
     attribMutex.unlock();
-}
-
-/**
- * \brief Sets the Pyramid to a new color.
- * \param c The new ColorFloat.
- */
-void Pyramid::setColor(ColorFloat c) {
-    attribMutex.lock();
-    myAlpha = c.A;
-    for(int i = 0; i < mySides; i++) {
-        vertices[i*42 + 3] = vertices[i*42 + 10] = vertices[i*42 + 17] = vertices[i*42 + 24] = vertices[i*42 + 38] = c.R;
-        vertices[i*42 + 4] = vertices[i*42 + 11] = vertices[i*42 + 18] = vertices[i*42 + 25] = vertices[i*42 + 39] = c.G;
-        vertices[i*42 + 5] = vertices[i*42 + 12] = vertices[i*42 + 19] = vertices[i*42 + 26] = vertices[i*42 + 40] = c.B;
-        vertices[i*42 + 6] = vertices[i*42 + 13] = vertices[i*42 + 20] = vertices[i*42 + 27] = vertices[i*42 + 41] = c.A;
-
-        vertices[i*42 + 31] = c.R *.5;
-        vertices[i*42 + 32] = c.G *.5;
-        vertices[i*42 + 33] = c.B *.5;
-        vertices[i*42 + 34] = c.A;
-    }
-    attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -211,43 +199,23 @@ void Pyramid::setColor(ColorFloat c) {
  * \details The array should have mySides+2 ColorFloats minimum.
  */
 void Pyramid::setColor(ColorFloat c[]) {
+    disableDetail();
     attribMutex.lock();
     myAlpha = 0.0;
     for(int i = 0; i < mySides; i++) {
-        vertices[i*42 + 3] = c[i+1].R;
-        vertices[i*42 + 4] = c[i+1].G;
-        vertices[i*42 + 5] = c[i+1].B;
-        vertices[i*42 + 6] = c[i+1].A;
-
-        vertices[i*42 + 10] = c[mySides+1].R;
-        vertices[i*42 + 11] = c[mySides+1].G;
-        vertices[i*42 + 12] = c[mySides+1].B;
-        vertices[i*42 + 13] = c[mySides+1].A;
-
-        vertices[i*42 + 17] = c[(i+1) % mySides + 1].R;
-        vertices[i*42 + 18] = c[(i+1) % mySides + 1].G;
-        vertices[i*42 + 19] = c[(i+1) % mySides + 1].B;
-        vertices[i*42 + 20] = c[(i+1) % mySides + 1].A;
-        
-        vertices[i*42 + 24] = c[i+1].R;
-        vertices[i*42 + 25] = c[i+1].G;
-        vertices[i*42 + 26] = c[i+1].B;
-        vertices[i*42 + 27] = c[i+1].A;
-
-        vertices[i*42 + 31] = c[0].R;
-        vertices[i*42 + 32] = c[0].G;
-        vertices[i*42 + 33] = c[0].B;
-        vertices[i*42 + 34] = c[0].A;
-
-        vertices[i*42 + 38] = c[(i+1) % mySides + 1].R;
-        vertices[i*42 + 39] = c[(i+1) % mySides + 1].G;
-        vertices[i*42 + 40] = c[(i+1) % mySides + 1].B;
-        vertices[i*42 + 41] = c[(i+1) % mySides + 1].A;
-
-        myAlpha += c[i+1].A * 2 + c[0].A + c[(i+1) % mySides + 1].A * 2 + c[mySides+2].A; 
+        setVertexColor(i*6, c[i+1]);
+        setVertexColor(i*6 + 1, c[mySides+1]);
+        setVertexColor(i*6 + 2, c[(i+1) % mySides + 1]);
+        setVertexColor(i*6 + 3, c[i+1]);
+        setVertexColor(i*6 + 4, c[0]);
+        setVertexColor(i*6 + 5, c[(i+1) % mySides + 1]);
+
+        myAlpha += c[i+1].A * 2 + c[0].A + c[(i+1) % mySides + 1].A * 2 + c[mySides+1].A;
     }
     myAlpha /= numberOfVertices;
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -258,11 +226,11 @@ void Pyramid::setColor(ColorFloat c[]) {
  */
 void Pyramid::getColors(std::vector<ColorFloat> &colorVec) {
     attribMutex.lock();
-    colorVec.push_back(ColorFloat(vertices[31],vertices[32],vertices[33],vertices[34]));
+    colorVec.push_back(getVertexColor(4));
     for (int i = 0; i < mySides; i++) {
-        colorVec.push_back(ColorFloat(vertices[42*i+3],vertices[42*i+4],vertices[42*i+5],vertices[42*i+6]));
+        colorVec.push_back(getVertexColor(6*i));
     }
-    colorVec.push_back(ColorFloat(vertices[10],vertices[11],vertices[12],vertices[13]));
+    colorVec.push_back(getVertexColor(1));
     attribMutex.unlock();
 }
 
@@ -44,11 +44,15 @@ public:
     */
     virtual GLfloat getRadius() { return myRadius; }    
 
-    virtual void setColor(ColorFloat c);
+    virtual void setColor(ColorFloat c) { Shape::setColor(c); }
 
     virtual void setColor(ColorFloat c[]);
 
     virtual void getColors(std::vector<ColorFloat> &colorVec);
+
+    static SharedMesh * buildMesh(int sides, int unused);
+
+    static void buildOutline(SharedMesh& mesh, int sides, int unused);
 };
 
 }
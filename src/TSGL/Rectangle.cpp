@@ -16,7 +16,7 @@ namespace tsgl {
  *   \param color The color of the Rectangle.
  * \return A new Rectangle with the specified top left corner, dimensions, and color.
  */
-Rectangle::Rectangle(float x, float y, float z, GLfloat width, GLfloat height, float yaw, float pitch, float roll, ColorFloat color) : ConvexPolygon(x,y,z,4,yaw,pitch,roll) {
+Rectangle::Rectangle(float x, float y, float z, GLfloat width, GLfloat height, float yaw, float pitch, float roll, ColorFloat color) : ConvexPolygon(x,y,z,4,yaw,pitch,roll,myVertexStorage,myOutlineStorage) {
     if (height <= 0 || width <= 0) {
         TsglDebug("Cannot have a Rectangle with height less than or equal to 0.");
         return;
@@ -26,15 +26,8 @@ Rectangle::Rectangle(float x, float y, float z, GLfloat width, GLfloat height, f
     myYScale = myHeight = height;
     myZScale = 1;
     attribMutex.unlock();
-    addVertex(-0.5, 0.5, 0, color);
-    addVertex(-0.5, -0.5, 0, color);
-    addVertex(0.5, -0.5, 0, color);
-    addVertex(0.5, 0.5, 0, color);
-
-    addOutlineVertex(-0.5, 0.5, 0, GRAY);
-    addOutlineVertex(-0.5, -0.5, 0, GRAY);
-    addOutlineVertex(0.5, -0.5, 0, GRAY);
-    addOutlineVertex(0.5, 0.5, 0, GRAY);
+    addVertices(UNIT_SQUARE, 4, color);
+    addOutlineVertices(UNIT_SQUARE, 4, GRAY);
 }
 
 /*!
@@ -51,7 +44,7 @@ Rectangle::Rectangle(float x, float y, float z, GLfloat width, GLfloat height, f
  *   \param color An array of colors for the vertices of the Rectangle.
  * \return A new Rectangle with the specified top left corner, dimensions, and colors.
  */
-Rectangle::Rectangle(float x, float y, float z, GLfloat width, GLfloat height, float yaw, float pitch, float roll, ColorFloat color[]) : ConvexPolygon(x,y,z,4,yaw,pitch,roll) {
+Rectangle::Rectangle(float x, float y, float z, GLfloat width, GLfloat height, float yaw, float pitch, float roll, ColorFloat color[]) : ConvexPolygon(x,y,z,4,yaw,pitch,roll,myVertexStorage,myOutlineStorage) {
     if (height <= 0 || width <= 0) {
         TsglDebug("Cannot have a Rectangle with height less than or equal to 0.");
         return;
@@ -61,15 +54,8 @@ Rectangle::Rectangle(float x, float y, float z, GLfloat width, GLfloat height, f
     myYScale = myHeight = height;
     myZScale = 1;
     attribMutex.unlock();
-    addVertex(-0.5, 0.5, 0, color[0]);
-    addVertex(-0.5, -0.5, 0, color[1]);
-    addVertex(0.5, -0.5, 0, color[2]);
-    addVertex(0.5, 0.5, 0, color[3]);
-
-    addOutlineVertex(-0.5, 0.5, 0, GRAY);
-    addOutlineVertex(-0.5, -0.5, 0, GRAY);
-    addOutlineVertex(0.5, -0.5, 0, GRAY);
-    addOutlineVertex(0.5, 0.5, 0, GRAY);
+    addVertices(UNIT_SQUARE, 4, color);
+    addOutlineVertices(UNIT_SQUARE, 4, GRAY);
 }
 
 /**
@@ -85,6 +71,7 @@ void Rectangle::setWidth(GLfloat width) {
     myWidth = width;
     myXScale = width;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -100,6 +87,7 @@ void Rectangle::changeWidthBy(GLfloat delta) {
     myWidth += delta;
     myXScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -115,6 +103,7 @@ void Rectangle::setHeight(GLfloat height) {
     myHeight = height;
     myYScale = height;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -130,6 +119,7 @@ void Rectangle::changeHeightBy(GLfloat delta) {
     myHeight += delta;
     myYScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 
 }
@@ -16,6 +16,8 @@ namespace tsgl {
 class Rectangle : public ConvexPolygon {
  private:
     GLfloat myWidth, myHeight;
+    GLfloat myVertexStorage[4 * 7];         // Inline storage for the fill vertices
+    GLfloat myOutlineStorage[4 * 7];        // Inline storage for the outline vertices
  public:
     Rectangle(float x, float y, float z, GLfloat width, GLfloat height, float yaw, float pitch, float roll, ColorFloat color);
 
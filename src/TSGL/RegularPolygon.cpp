@@ -21,11 +21,15 @@ RegularPolygon::RegularPolygon(float x, float y, float z, GLfloat radius, int si
     myXScale = myYScale = myRadius = radius;
     myZScale = 1;
     attribMutex.unlock();
-    float delta = 2.0f / sides * PI;
+    const GLfloat * t = TrigTable::unitCircle(sides);
+    std::vector<GLfloat> positions(sides * 3);
     for (int i = 0; i < sides; ++i) {
-        addVertex(cos(i*delta), sin(i*delta), 0, color);
-        addOutlineVertex(cos(i*delta), sin(i*delta), 0, GRAY);
+        positions[i*3] = t[i*2];
+        positions[i*3 + 1] = t[i*2 + 1];
+        positions[i*3 + 2] = 0;
     }
+    addVertices(positions.data(), sides, color);
+    addOutlineVertices(positions.data(), sides, GRAY);
 }
 
 /*!
@@ -48,11 +52,15 @@ RegularPolygon::RegularPolygon(float x, float y, float z, GLfloat radius, int si
     myZScale = 1;
     mySides = sides;
     attribMutex.unlock();
-    float delta = 2.0f / sides * PI;
+    const GLfloat * t = TrigTable::unitCircle(sides);
+    std::vector<GLfloat> positions(sides * 3);
     for (int i = 0; i < sides; ++i) {
-        addVertex(cos(i*delta), sin(i*delta), 0, color[i]);
-        addOutlineVertex(cos(i*delta), sin(i*delta), 0, GRAY);
+        positions[i*3] = t[i*2];
+        positions[i*3 + 1] = t[i*2 + 1];
+        positions[i*3 + 2] = 0;
     }
+    addVertices(positions.data(), sides, color);
+    addOutlineVertices(positions.data(), sides, GRAY);
 }
 
 /**
@@ -69,6 +77,7 @@ void RegularPolygon::setRadius(GLfloat radius) {
     myXScale = radius;
     myYScale = radius;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -85,6 +94,7 @@ void RegularPolygon::changeRadiusBy(GLfloat delta) {
     myXScale += delta;
     myYScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 
 }
\ No newline at end of file
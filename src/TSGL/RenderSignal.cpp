@@ -0,0 +1,77 @@
+#include "RenderSignal.h"
+
+namespace tsgl {
+
+/*!
+ * \brief Default RenderSignal constructor method.
+ * \details The signal starts out dirty, so that the first frame is always rendered.
+ * \return A new, dirty RenderSignal.
+ */
+RenderSignal::RenderSignal() {
+    dirty.store(true);
+}
+
+/*!
+ * \brief Marks the scene as changed.
+ * \details Sets the dirty flag and wakes up any thread blocked in waitForDirty().
+ * \note Only the call that switches the flag from clean to dirty takes the internal mutex;
+ *   every following call until the next consume() only reads the flag.
+ */
+void RenderSignal::markDirty() {
+    if (dirty.load(std::memory_order_relaxed))
+        return;
+    if (!dirty.exchange(true)) {
+        std::lock_guard<std::mutex> lock(waitMutex);
+        waitCondition.notify_all();
+    }
+}
+
+/*!
+ * \brief Clears the dirty flag.
+ * \details Called by the rendering thread at the start of a frame, so that any change made while the frame
+ *   is being drawn marks the signal dirty again. Also counts the frame as started, for waitForRedraw().
+ * \return True if the signal was dirty, false otherwise.
+ */
+bool RenderSignal::consume() {
+    framesStarted++;
+    return dirty.exchange(false);
+}
+
+/*!
+ * \brief Blocks the calling thread until the scene changes.
+ * \details Returns as soon as markDirty() is called, or once <code>seconds</code> seconds have passed.
+ *   \param seconds The maximum number of seconds to wait for.
+ * \return True if the signal is dirty, false if the wait timed out.
+ */
+bool RenderSignal::waitForDirty(double seconds) {
+    std::unique_lock<std::mutex> lock(waitMutex);
+    return waitCondition.wait_for(lock, std::chrono::duration<double>(seconds), [this]() { return dirty.load(); });
+}
+
+/*!
+ * \brief Reports that the frame started by the last consume() is on screen.
+ * \details Called by the rendering thread once it has swapped the frame's buffers. Wakes up any thread
+ *   blocked in waitForRedraw().
+ */
+void RenderSignal::markDrawn() {
+    framesDrawn.store(framesStarted.load());
+    std::lock_guard<std::mutex> lock(waitMutex);
+    waitCondition.notify_all();
+}
+
+/*!
+ * \brief Marks the scene as changed, and blocks until it has been drawn.
+ * \details Returns once a frame started after this call has been drawn, so every change made before the
+ *   call is on screen, or once <code>seconds</code> seconds have passed.
+ *   \param seconds The maximum number of seconds to wait for.
+ * \return True if the frame was drawn, false if the wait timed out.
+ */
+bool RenderSignal::waitForRedraw(double seconds) {
+    unsigned long started = framesStarted.load();      // Whatever frame is in progress may predate our changes
+    markDirty();
+    std::unique_lock<std::mutex> lock(waitMutex);
+    return waitCondition.wait_for(lock, std::chrono::duration<double>(seconds),
+                                  [this, started]() { return framesDrawn.load() > started; });
+}
+
+}
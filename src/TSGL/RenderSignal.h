@@ -0,0 +1,55 @@
+/*
+ * RenderSignal.h provides a thread-safe flag for telling a Canvas that its scene has changed.
+ */
+
+#ifndef RENDERSIGNAL_H_
+#define RENDERSIGNAL_H_
+
+#include <atomic>              // For the lock-free dirty flag
+#include <chrono>              // For timed waits
+#include <condition_variable>  // For waking the rendering thread
+#include <mutex>               // Needed by the condition variable
+
+namespace tsgl {
+
+/*! \class RenderSignal
+ *  \brief A thread-safe "the scene has changed" flag shared between a Canvas and what it renders.
+ *  \details Each Canvas owns a RenderSignal. Drawables added to the Canvas, its Background and its Camera
+ *    keep a pointer to it and call markDirty() whenever one of their attributes changes.
+ *  \details The Canvas' rendering thread only redraws the scene and swaps buffers on frames where the signal
+ *    is dirty. While the scene is clean, the rendering thread blocks in waitForDirty(), and the first call to
+ *    markDirty() wakes it immediately instead of at the next timer tick.
+ *  \details The rendering thread also reports each frame it finishes with markDrawn(), so that other threads can
+ *    wait in waitForRedraw() until their changes are on screen.
+ *  \note Marking an already dirty signal is a single relaxed atomic load, so it is cheap to call from hot loops.
+ */
+class RenderSignal {
+ private:
+    std::atomic<bool>       dirty;
+    std::atomic<unsigned long> framesStarted{0};     // Frames whose changes have been consumed
+    std::atomic<unsigned long> framesDrawn{0};       // Frames whose buffers have been swapped
+    std::mutex              waitMutex;
+    std::condition_variable waitCondition;
+ public:
+    RenderSignal();
+
+    void markDirty();
+
+    bool consume();
+
+    bool waitForDirty(double seconds);
+
+    void markDrawn();
+
+    bool waitForRedraw(double seconds);
+
+    /*!
+     * \brief Accessor for the state of the RenderSignal.
+     * \return True if the scene has changed since the last call to consume(), false otherwise.
+     */
+    bool isDirty() const { return dirty.load(); }
+};
+
+}
+
+#endif /* RENDERSIGNAL_H_ */
@@ -0,0 +1,217 @@
+#include "ScrollingPlot.h"
+
+#include <algorithm>
+
+namespace tsgl {
+
+ /*!
+  * \brief Explicitly constructs a new ScrollingPlot.
+  * \details Explicit constructor for a ScrollingPlot object.
+  *   \param x The x coordinate of the ScrollingPlot's center.
+  *   \param y The y coordinate of the ScrollingPlot's center.
+  *   \param z The z coordinate of the ScrollingPlot's center.
+  *   \param width The width of the ScrollingPlot; it has one column per unit.
+  *   \param height The height of the ScrollingPlot.
+  *   \param window The number of most recent samples shown.
+  *   \param yMin The sample value at the bottom edge.
+  *   \param yMax The sample value at the top edge.
+  *   \param yaw The ScrollingPlot's yaw.
+  *   \param pitch The ScrollingPlot's pitch.
+  *   \param roll The ScrollingPlot's roll.
+  *   \param color The color of the trace.
+  * \return A new, empty ScrollingPlot.
+  */
+ScrollingPlot::ScrollingPlot(float x, float y, float z, GLfloat width, GLfloat height, int window, GLfloat yMin, GLfloat yMax, float yaw, float pitch, float roll, ColorFloat color) : Drawable(x,y,z,yaw,pitch,roll) {
+    if (width < 1 || height <= 0 || window < 1 || yMax <= yMin) {
+        TsglDebug("Cannot have a ScrollingPlot without a positive size, window and range.");
+        return;
+    }
+    attribMutex.lock();
+    myXScale = myYScale = myZScale = 1;
+    myWidth = width;
+    myHeight = height;
+    myYMin = yMin;
+    myYMax = yMax;
+    int columns = (int) width;
+    mySamplesPerColumn = (window + columns - 1) / columns;
+    myColumns = (window + mySamplesPerColumn - 1) / mySamplesPerColumn;
+    mySampleCount = 0;
+    myVertices.resize((myColumns + 1) * 2);
+    VertexFormat::packColor(color, myColor);
+    myAlpha = color.A;
+    for (int slot = 0; slot <= myColumns; slot++)
+        writeSlot(slot, 0, 0);
+    init = true;
+    attribMutex.unlock();
+}
+
+// Sets the minimum and maximum of a ring slot; called with attribMutex held
+void ScrollingPlot::writeSlot(int slot, GLfloat low, GLfloat high) {
+    GLfloat columnWidth = myWidth / myColumns;
+    PackedVertex * v = &myVertices[slot * 2];
+    v[0].x = v[1].x = slot * columnWidth;
+    v[0].y = low;
+    v[1].y = high;
+    v[0].z = v[1].z = 0;
+    for (int i = 0; i < 4; i++)
+        v[0].color[i] = v[1].color[i] = myColor[i];
+}
+
+/*!
+ * \brief Draw the ScrollingPlot.
+ * \details This function actually draws the ScrollingPlot to the Canvas, uploading only the columns that changed
+ *   since the last frame. When the visible columns wrap around the end of the ring, they are drawn in two parts,
+ *   each shifted so that the oldest column is at the left edge.
+ * \note This function overrides Drawable::draw()
+ */
+void ScrollingPlot::draw(Shader * shader) {
+    if (!init) {
+        TsglDebug("Vertex buffer is not full.");
+        return;
+    }
+    glm::mat4 model = modelMatrix();
+
+    GLint canvasBuffer;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &canvasBuffer);
+    GLint posAttrib = glGetAttribLocation(shader->ID, "aPos");
+    GLint colAttrib = glGetAttribLocation(shader->ID, "aColor");
+    unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
+
+    attribMutex.lock();
+    if (mySampleCount == 0) {
+        attribMutex.unlock();
+        return;
+    }
+    // Map samples from [yMin, yMax] to the plot's height, with the plot centered on its center
+    model = glm::translate(model, glm::vec3(-myWidth / 2, -myHeight / 2, 0));
+    model = glm::scale(model, glm::vec3(1, myHeight / (myYMax - myYMin), 1));
+    model = glm::translate(model, glm::vec3(0, -myYMin, 0));
+
+    long long last = (mySampleCount - 1) / mySamplesPerColumn;
+    long long first = std::max(0LL, last - myColumns + 1);
+    int start = first % myColumns;
+    int count = last - first + 1;
+    GLfloat columnWidth = myWidth / myColumns;
+
+    myBuffer.bind(GL_ARRAY_BUFFER, myVertices.data(), myVertices.size() * sizeof(PackedVertex));
+    VertexFormat::setLayout(posAttrib, colAttrib);
+    // Oldest columns, from their slot to the end of the ring (including the copy of slot 0, which joins the parts)
+    int firstPart = std::min(count, myColumns + 1 - start);
+    glm::mat4 shifted = glm::translate(model, glm::vec3(-start * columnWidth, 0, 0));
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(shifted));
+    glDrawArrays(GL_LINE_STRIP, start * 2, firstPart * 2);
+    // Newest columns, wrapped around to the start of the ring
+    if (start + count > myColumns + 1) {
+        shifted = glm::translate(model, glm::vec3((myColumns - start) * columnWidth, 0, 0));
+        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(shifted));
+        glDrawArrays(GL_LINE_STRIP, 0, (start + count - myColumns) * 2);
+    }
+    attribMutex.unlock();
+
+    glBindBuffer(GL_ARRAY_BUFFER, canvasBuffer);
+    VertexFormat::setLayout(posAttrib, colAttrib);
+}
+
+/**
+ * \brief Appends a sample to the plot.
+ * \details Safe to call from any thread. The plot scrolls when the next frame is drawn.
+ * \param sample The new sample.
+ */
+void ScrollingPlot::append(GLfloat sample) {
+    append(&sample, 1);
+}
+
+/**
+ * \brief Appends a run of samples to the plot.
+ * \details Safe to call from any thread; takes the lock once for the whole run.
+ * \param samples An array of the new samples, oldest first.
+ * \param count The number of samples.
+ */
+void ScrollingPlot::append(const GLfloat samples[], int count) {
+    if (!init || count <= 0)
+        return;
+    attribMutex.lock();
+    long long firstColumn = mySampleCount / mySamplesPerColumn;
+    for (int i = 0; i < count; i++) {
+        int slot = (mySampleCount / mySamplesPerColumn) % myColumns;
+        PackedVertex * v = &myVertices[slot * 2];
+        if (mySampleCount % mySamplesPerColumn == 0)
+            writeSlot(slot, samples[i], samples[i]);
+        else if (samples[i] < v[0].y)
+            v[0].y = samples[i];
+        else if (samples[i] > v[1].y)
+            v[1].y = samples[i];
+        if (slot == 0) {
+            myVertices[myColumns * 2].y = v[0].y;
+            myVertices[myColumns * 2 + 1].y = v[1].y;
+        }
+        mySampleCount++;
+    }
+    // Upload the slots touched, or the whole ring if the run wrapped around it
+    long long lastColumn = (mySampleCount - 1) / mySamplesPerColumn;
+    int firstSlot = firstColumn % myColumns, lastSlot = lastColumn % myColumns;
+    if (lastColumn - firstColumn + 1 >= myColumns || lastSlot < firstSlot) {
+        myBuffer.invalidateAll();
+    } else {
+        myBuffer.invalidate(firstSlot * 2 * sizeof(PackedVertex), (lastSlot - firstSlot + 1) * 2 * sizeof(PackedVertex));
+        if (firstSlot == 0)
+            myBuffer.invalidate(myColumns * 2 * sizeof(PackedVertex), 2 * sizeof(PackedVertex));
+    }
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Sets the sample values at the bottom and top edges of the plot.
+ * \param yMin The sample value at the bottom edge.
+ * \param yMax The sample value at the top edge.
+ */
+void ScrollingPlot::setRange(GLfloat yMin, GLfloat yMax) {
+    if (yMax <= yMin) {
+        TsglDebug("Cannot have a ScrollingPlot with an empty range.");
+        return;
+    }
+    attribMutex.lock();
+    myYMin = yMin;
+    myYMax = yMax;
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Sets the color of the trace.
+ * \param c The new ColorFloat.
+ */
+void ScrollingPlot::setColor(ColorFloat c) {
+    attribMutex.lock();
+    VertexFormat::packColor(c, myColor);
+    for (unsigned i = 0; i < myVertices.size(); i++)
+        for (int j = 0; j < 4; j++)
+            myVertices[i].color[j] = myColor[j];
+    myAlpha = c.A;
+    myBuffer.invalidateAll();
+    attribMutex.unlock();
+    markDirty();
+}
+
+/**
+ * \brief Accessor for the color of the trace.
+ */
+ColorFloat ScrollingPlot::getColor() {
+    attribMutex.lock();
+    ColorFloat c = VertexFormat::unpackColor(myColor);
+    attribMutex.unlock();
+    return c;
+}
+
+/*!
+ * \brief Accessor for the number of samples appended so far.
+ */
+long long ScrollingPlot::getSampleCount() {
+    attribMutex.lock();
+    long long n = mySampleCount;
+    attribMutex.unlock();
+    return n;
+}
+
+}
@@ -0,0 +1,63 @@
+/*
+ * ScrollingPlot.h extends Drawable and provides a class for plotting a live stream of samples.
+ */
+
+#ifndef SCROLLINGPLOT_H_
+#define SCROLLINGPLOT_H_
+
+#include "Drawable.h"      // For extending our Drawable object
+#include "GpuBuffer.h"     // For uploading only the newest samples
+#include "VertexFormat.h"  // For the compact format the shape shader reads
+#include <vector>          // For column storage
+
+namespace tsgl {
+
+/*! \class ScrollingPlot
+ *  \brief Plot the most recent samples of a stream, scrolling as new ones arrive.
+ *  \details ScrollingPlot is a class for live telemetry: producer threads append() samples, and the plot shows the
+ *   last <code>window</code> of them across its width, newest on the right.
+ *  \details The plot has one column per unit of width (one pixel, with the default camera). When the window holds
+ *   more samples than there are columns, each column covers a fixed run of samples and is drawn as a vertical
+ *   stroke from their minimum to their maximum, so spikes are never lost however far the samples are decimated.
+ *  \details Columns are kept in a ring buffer mirrored on the GPU. Appending a sample only changes the newest
+ *   column, so each frame uploads just the columns appended since the last one, and appending is O(1).
+ *  \details Samples are plotted from <code>yMin</code> (the bottom edge) to <code>yMax</code> (the top edge).
+ */
+class ScrollingPlot : public Drawable {
+ private:
+    GLfloat myWidth, myHeight;
+    GLfloat myYMin, myYMax;
+    int myColumns;                         // Number of columns shown
+    int mySamplesPerColumn;
+    long long mySampleCount;               // Samples appended so far
+    std::vector<PackedVertex> myVertices;  // Minimum and maximum of each ring slot, plus a copy of slot 0 at the end
+    GpuBuffer myBuffer{GL_DYNAMIC_DRAW};
+    GLubyte myColor[4];
+
+    void writeSlot(int slot, GLfloat low, GLfloat high);
+ public:
+    ScrollingPlot(float x, float y, float z, GLfloat width, GLfloat height, int window, GLfloat yMin, GLfloat yMax, float yaw, float pitch, float roll, ColorFloat color);
+
+    virtual void draw(Shader * shader);
+
+    void append(GLfloat sample);
+
+    void append(const GLfloat samples[], int count);
+
+    void setRange(GLfloat yMin, GLfloat yMax);
+
+    virtual void setColor(ColorFloat c);
+
+    virtual ColorFloat getColor();
+
+    long long getSampleCount();
+
+    /*!
+     * \brief Accessor for the number of samples each column covers.
+     */
+    int getSamplesPerColumn() { return mySamplesPerColumn; }
+};
+
+}
+
+#endif /* SCROLLINGPLOT_H_ */
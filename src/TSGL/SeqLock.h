@@ -0,0 +1,95 @@
+/*
+ * SeqLock.h provides a mutex for writers that readers can bypass with a sequence counter.
+ */
+
+#ifndef SEQLOCK_H_
+#define SEQLOCK_H_
+
+#include "InstrumentedMutex.h" // For serializing writers
+#include <atomic>              // For the sequence counter
+#include <thread>              // For yielding while a write is in progress
+
+namespace tsgl {
+
+/*! \class SeqLock
+ *  \brief A mutex whose readers never have to lock it.
+ *  \details Writers lock() and unlock() a SeqLock exactly like a mutex. Each write also bumps a sequence counter
+ *    twice, so the counter is odd while a write is in progress.
+ *  \details A reader that only needs a consistent copy of a few fields can instead call readBegin(), copy the
+ *    fields, and call readRetry() with the value readBegin() returned. If readRetry() returns true, a writer
+ *    changed the fields during the copy and the reader must copy them again:
+ *  \code
+ *    unsigned seq;
+ *    do {
+ *        seq = lock.readBegin();
+ *        x = myX; y = myY;
+ *    } while (lock.readRetry(seq));
+ *  \endcode
+ *  \details Readers never block writers, and only wait for a writer that is inside lock() and unlock().
+ *  \warning A thread must not call readBegin() while it holds the lock itself, or it will wait forever.
+ */
+class SeqLock {
+ private:
+    InstrumentedMutex        myMutex;
+    std::atomic<unsigned>    mySequence{0};  // Odd while a writer holds the lock
+ public:
+    /*!
+     * \brief Constructs a new, unlocked SeqLock.
+     * \param name The name under which lock statistics are reported; see InstrumentedMutex.
+     */
+    explicit SeqLock(const char* name) : myMutex(name) { }
+
+    /*!
+     * \brief Locks the SeqLock for writing, blocking until no other writer holds it.
+     */
+    void lock() {
+        myMutex.lock();
+        mySequence.store(mySequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    /*!
+     * \brief Attempts to lock the SeqLock for writing without blocking.
+     * \return True if the SeqLock was locked, false if another writer holds it.
+     */
+    bool try_lock() {
+        if (!myMutex.try_lock())
+            return false;
+        mySequence.store(mySequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return true;
+    }
+
+    /*!
+     * \brief Unlocks the SeqLock, publishing everything written while it was held.
+     */
+    void unlock() {
+        mySequence.store(mySequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        myMutex.unlock();
+    }
+
+    /*!
+     * \brief Starts a lock-free read, waiting for any write in progress to finish.
+     * \return The sequence number to pass to readRetry().
+     */
+    unsigned readBegin() const {
+        unsigned seq;
+        while ((seq = mySequence.load(std::memory_order_acquire)) & 1)
+            std::this_thread::yield();
+        return seq;
+    }
+
+    /*!
+     * \brief Finishes a lock-free read.
+     * \param seq The value returned by the matching readBegin().
+     * \return True if a writer intervened and the read must be repeated.
+     */
+    bool readRetry(unsigned seq) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return mySequence.load(std::memory_order_relaxed) != seq;
+    }
+};
+
+}
+
+#endif /* SEQLOCK_H_ */
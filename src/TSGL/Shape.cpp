@@ -1,5 +1,7 @@
 #include "Shape.h"
 
+#include <utility>
+
 namespace tsgl {
 
 /*!
@@ -15,7 +17,9 @@ Shape::Shape(float x, float y, float z, float yaw, float pitch, float roll) : Dr
 
 /*!
  * \brief Draw the Shape.
- * \details This function actually draws the Shape to the Canvas.
+ * \details This function actually draws the Shape to the Canvas, from the latest copy of its vertices, colors
+ *   and mesh that repack() handed over. It never locks <code>attribMutex</code>, so it does not wait for threads
+ *   changing the Shape.
  * \note This function does nothing if the vertex buffer is not yet full.
  * \note A message indicating that the Shape cannot be drawn yet will be given
  *   if the above condition is met (vertex buffer = not full).
@@ -25,26 +29,353 @@ void Shape::draw(Shader * shader) {
         TsglDebug("Vertex buffer is not full.");
         return;
     }
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(myRotationPointX, myRotationPointY, myRotationPointZ));
-    model = glm::rotate(model, glm::radians(myCurrentYaw), glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::rotate(model, glm::radians(myCurrentPitch), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(myCurrentRoll), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::translate(model, glm::vec3(myCenterX - myRotationPointX, myCenterY - myRotationPointY, myCenterZ - myRotationPointZ));
-    model = glm::scale(model, glm::vec3(myXScale, myYScale, myZScale));
+    if (DrawState * posted = myPosted.take()) {
+        std::swap(myDrawn, *posted);
+        delete posted;
+        myFillBuffer.invalidateAll();
+        myOutlineBuffer.invalidateAll();
+        myColorBuffer.invalidateAll();
+    }
+    glm::mat4 model = modelMatrix();
 
     unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
     glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
 
-    if (isFilled) {
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfVertices * 7, vertices, GL_DYNAMIC_DRAW);
-        glDrawArrays(geometryType, 0, numberOfVertices);
+    if (myDrawn.mesh) {
+        drawMesh(shader);
+        return;
+    }
+
+    GLint canvasBuffer;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &canvasBuffer);
+    GLint posAttrib = glGetAttribLocation(shader->ID, "aPos");
+    GLint colAttrib = glGetAttribLocation(shader->ID, "aColor");
+
+    if (myDrawn.isFilled && !myDrawn.fill.empty()) {
+        myFillBuffer.bind(GL_ARRAY_BUFFER, myDrawn.fill.data(), myDrawn.fill.size() * sizeof(PackedVertex));
+        VertexFormat::setLayout(posAttrib, colAttrib);
+        glDrawArrays(myDrawn.geometryType, 0, myDrawn.fill.size());
+    }
+
+    if (myDrawn.isOutlined && !myDrawn.outline.empty()) {
+        myOutlineBuffer.bind(GL_ARRAY_BUFFER, myDrawn.outline.data(), myDrawn.outline.size() * sizeof(PackedVertex));
+        VertexFormat::setLayout(posAttrib, colAttrib);
+        glDrawArrays(myDrawn.outlineGeometryType, 0, myDrawn.outline.size());
     }
 
+    glBindBuffer(GL_ARRAY_BUFFER, canvasBuffer);
+    VertexFormat::setLayout(posAttrib, colAttrib);
+}
+
+/*!
+ * \brief Appends the Shape's fill and outline to a Group's batch.
+ * \details Shapes drawn from a SharedMesh keep their vertices on the GPU, and are not batched.
+ * \note This function overrides Drawable::appendBatch()
+ */
+bool Shape::appendBatch(std::vector<PackedVertex>& out, std::vector<BatchRange>& ranges) {
+    glm::mat4 model = modelMatrix();
+    attribMutex.lock();
+    if (myMesh) {
+        attribMutex.unlock();
+        return false;
+    }
+    if (isFilled) {
+        ranges.push_back(BatchRange{ geometryType, (GLint) out.size(), numberOfVertices });
+        appendVertices(model, vertices, NULL, numberOfVertices, out);
+    }
     if (isOutlined) {
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * numberOfOutlineVertices * 7, outlineVertices, GL_DYNAMIC_DRAW);
-        glDrawArrays(outlineGeometryType, 0, numberOfOutlineVertices);
+        ranges.push_back(BatchRange{ outlineGeometryType, (GLint) out.size(), numberOfOutlineVertices });
+        appendVertices(model, outlineVertices, NULL, numberOfOutlineVertices, out);
+    }
+    attribMutex.unlock();
+    return true;
+}
+
+// Moves one channel of a vertex's base color to an animated value: scaled by the same ratio as the first
+// vertex's channel, or shifted by the same amount if the first vertex's channel is 0
+static float animateChannel(float base, float firstBase, float value) {
+    float c = (firstBase > 0) ? base * value / firstBase : base + value - firstBase;
+    return (c < 0) ? 0 : (c > 1) ? 1 : c;
+}
+
+/**
+ * \brief Forgets the vertex colors that color tracks were scaling, so that a new track starts from the current ones.
+ * \param property The AnimatedProperty the new track drives.
+ * \note This function overrides Drawable::startAnimation()
+ */
+void Shape::startAnimation(AnimatedProperty property) {
+    if (property < ANIMATE_RED || property > ANIMATE_ALPHA)
+        return;
+    attribMutex.lock();
+    std::vector<ColorFloat>().swap(myAnimationBase);
+    attribMutex.unlock();
+}
+
+/**
+ * \brief Sets the properties driven by animation tracks, including the Shape's color.
+ * \details The animated color channels follow getColor(), the color of the first vertex. If the vertices have
+ *   their own colors, each frame scales every vertex's color as it was when the track started by the same
+ *   ratio, so the Shape keeps its gradient even after a channel passes through 0 or 1.
+ * \note This function overrides Drawable::applyAnimation()
+ */
+void Shape::applyAnimation(const float values[], unsigned mask) {
+    const unsigned COLOR = (1 << ANIMATE_RED) | (1 << ANIMATE_GREEN) | (1 << ANIMATE_BLUE) | (1 << ANIMATE_ALPHA);
+    if ((mask & COLOR) && numberOfVertices > 0) {
+        bool red = mask & (1 << ANIMATE_RED), green = mask & (1 << ANIMATE_GREEN);
+        bool blue = mask & (1 << ANIMATE_BLUE), alpha = mask & (1 << ANIMATE_ALPHA);
+        attribMutex.lock();
+        if (myMesh && myVertexColors.empty()) {
+            if (red) myMeshColor.R = values[ANIMATE_RED];
+            if (green) myMeshColor.G = values[ANIMATE_GREEN];
+            if (blue) myMeshColor.B = values[ANIMATE_BLUE];
+            if (alpha) myMeshColor.A = values[ANIMATE_ALPHA];
+            myAlpha = myMeshColor.A;
+        } else {
+            if ((int)myAnimationBase.size() != numberOfVertices) {
+                myAnimationBase.resize(numberOfVertices);
+                for (int i = 0; i < numberOfVertices; i++)
+                    myAnimationBase[i] = getVertexColor(i);
+            }
+            const ColorFloat& first = myAnimationBase[0];
+            myAlpha = 0;
+            for (int i = 0; i < numberOfVertices; i++) {
+                ColorFloat c = getVertexColor(i);
+                const ColorFloat& base = myAnimationBase[i];
+                if (red) c.R = animateChannel(base.R, first.R, values[ANIMATE_RED]);
+                if (green) c.G = animateChannel(base.G, first.G, values[ANIMATE_GREEN]);
+                if (blue) c.B = animateChannel(base.B, first.B, values[ANIMATE_BLUE]);
+                if (alpha) c.A = animateChannel(base.A, first.A, values[ANIMATE_ALPHA]);
+                storeVertexColor(i, c);
+                myAlpha += c.A;
+            }
+            myAlpha /= numberOfVertices;
+        }
+        repack();
+        attribMutex.unlock();
+        markDirty();
+    }
+    Drawable::applyAnimation(values, mask);
+}
+
+/*!
+ * \brief Draws a Shape backed by a SharedMesh.
+ * \details Positions come from the mesh's own vertex buffer. Colors come from the Shape's own color buffer if it
+ *   has per-vertex colors or a shaded mesh; otherwise every vertex is given the same constant color.
+ *   A Shape with per-vertex colors draws the mesh's unindexed positions; otherwise an indexed mesh is drawn
+ *   through its element buffer.
+ *   The Canvas' buffer and vertex layout are restored afterwards.
+ * \note Draws <code>myDrawn</code>, so it does not need <code>attribMutex</code>.
+ */
+void Shape::drawMesh(Shader * shader) {
+    const DrawState& d = myDrawn;
+    GLint canvasBuffer;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &canvasBuffer);
+    GLint posAttrib = glGetAttribLocation(shader->ID, "aPos");
+    GLint colAttrib = glGetAttribLocation(shader->ID, "aColor");
+
+    if (d.isFilled) {
+        if (d.vertexColors) {
+            myColorBuffer.bind(GL_ARRAY_BUFFER, d.colors.data(), d.colors.size());
+            glVertexAttribPointer(colAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, 4, (void*)0);
+            d.mesh->bindExpanded();
+            glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+            glDrawArrays(d.geometryType, 0, d.count);
+        } else {
+            if (!d.colors.empty()) {
+                myColorBuffer.bind(GL_ARRAY_BUFFER, d.colors.data(), d.colors.size());
+                glVertexAttribPointer(colAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, 4, (void*)0);
+            } else {
+                glDisableVertexAttribArray(colAttrib);
+                glVertexAttrib4f(colAttrib, d.meshColor.R, d.meshColor.G, d.meshColor.B, d.meshColor.A);
+            }
+            d.mesh->bind();
+            glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+            if (d.mesh->isIndexed())
+                glDrawElements(d.geometryType, d.count, GL_UNSIGNED_INT, (void*)0);
+            else
+                glDrawArrays(d.geometryType, 0, d.count);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+        glEnableVertexAttribArray(colAttrib);
+    }
+
+    if (d.isOutlined) {
+        d.mesh->bindOutline();
+        glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+        glDisableVertexAttribArray(colAttrib);
+        glVertexAttrib4f(colAttrib, d.outlineColor.R, d.outlineColor.G, d.outlineColor.B, d.outlineColor.A);
+        glDrawArrays(d.outlineGeometryType, 0, d.outlineCount);
+        glEnableVertexAttribArray(colAttrib);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, canvasBuffer);
+    VertexFormat::setLayout(posAttrib, colAttrib);
+}
+
+/*!
+ * \brief Copies everything draw() needs from the Shape, and hands the copy to the render thread.
+ * \details Every function that changes the vertices, their colors, the mesh or whether the Shape is filled or
+ *   outlined calls this once it is done. The vertices are packed here, rather than on every draw, and draw()
+ *   uploads them again the next time it runs. Vertices are only packed once every one of them has been added.
+ * \note The caller must hold <code>attribMutex</code>.
+ */
+void Shape::repack() {
+    DrawState * s = new DrawState;
+    s->geometryType = geometryType;
+    s->outlineGeometryType = outlineGeometryType;
+    s->isFilled = isFilled;
+    s->isOutlined = isOutlined;
+    s->mesh = myMesh;
+    if (myMesh) {
+        s->count = numberOfVertices;
+        s->outlineCount = numberOfOutlineVertices;
+        s->meshColor = myMeshColor;
+        s->outlineColor = myOutlineColor;
+        s->vertexColors = !myVertexColors.empty();
+        if (s->vertexColors) {
+            s->colors = myVertexColors;
+        } else if (myMesh->isShaded()) {
+            int count = myMesh->getVertexCount();
+            s->colors.resize(count * 4);
+            for (int i = 0; i < count; i++) {
+                GLfloat shade = myMesh->getShade(i);
+                VertexFormat::packColor(ColorFloat(myMeshColor.R * shade, myMeshColor.G * shade,
+                                                   myMeshColor.B * shade, myMeshColor.A), &s->colors[i*4]);
+            }
+        }
+    } else {
+        if (init)
+            packFill(s->fill);
+        if (outlineInit)
+            VertexFormat::pack(outlineVertices, NULL, numberOfOutlineVertices, s->outline);
+    }
+    myPosted.post(s);
+}
+
+/*!
+ * \brief Makes the Shape draw a SharedMesh instead of its own vertices.
+ * \details Any vertices the Shape allocated are freed, and its vertex counts are taken from the mesh.
+ *   Subclasses may lower <code>numberOfOutlineVertices</code> afterwards to draw only part of the outline.
+ *      \param mesh The SharedMesh, from SharedMesh::acquire().
+ */
+void Shape::useMesh(std::shared_ptr<SharedMesh> mesh) {
+    attribMutex.lock();
+    setMesh(std::move(mesh));
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Does the work of useMesh().
+ * \note The caller must hold <code>attribMutex</code>.
+ *      \param mesh The SharedMesh, from SharedMesh::acquire().
+ */
+void Shape::setMesh(std::shared_ptr<SharedMesh> mesh) {
+    if (!myVerticesInline) {
+        delete [] vertices;
+        delete [] outlineVertices;
+    }
+    vertices = outlineVertices = nullptr;
+    myVerticesInline = false;
+    myMesh = std::move(mesh);
+    numberOfVertices = myMesh->getDrawCount();
+    numberOfOutlineVertices = myMesh->getOutlineVertexCount();
+    init = outlineInit = true;
+    repack();
+    markDirty();
+}
+
+/*!
+ * \brief Lets a curved Shape choose its tessellation from its size on screen.
+ * \details The Shape starts at the level LevelOfDetail gives for <code>radius</code> pixels, and is
+ *   re-tessellated by selectDetail() as its size on screen changes.
+ *      \param radius The Shape's expected radius on screen, in pixels.
+ */
+void Shape::enableDetail(float radius) {
+    attribMutex.lock();
+    myDetailLevel = LevelOfDetail::levelFor(radius);
+    tessellate(LevelOfDetail::SEGMENTS[myDetailLevel]);
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Returns a curved Shape to its fixed tessellation.
+ * \details Called before a Shape is given per-vertex colors, since those are laid out for the fixed tessellation.
+ */
+void Shape::disableDetail() {
+    attribMutex.lock();
+    if (myDetailLevel >= 0) {
+        myDetailLevel = -1;
+        tessellate(myFixedSegments);
+    }
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Re-tessellates a curved Shape if its size on screen has changed enough.
+ * \details Does nothing for Shapes whose tessellation is fixed.
+ * \param eye The position of the camera.
+ * \param pixelsPerUnit The number of pixels one world unit spans at distance 1 from the camera.
+ */
+void Shape::selectDetail(const glm::vec3& eye, float pixelsPerUnit) {
+    if (myDetailLevel < 0)
+        return;
+    float distance = glm::length(glm::vec3(myCenterX, myCenterY, myCenterZ) - eye);
+    int level = LevelOfDetail::select(myDetailLevel, LevelOfDetail::projectedRadius(getDetailRadius(), distance, pixelsPerUnit));
+    if (level == myDetailLevel)
+        return;
+    attribMutex.lock();
+    if (myDetailLevel >= 0) {
+        myDetailLevel = level;
+        tessellate(LevelOfDetail::SEGMENTS[level]);
     }
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Accessor for the color of one of the Shape's vertices.
+ * \note The caller must hold <code>attribMutex</code>.
+ *      \param index The index of the vertex.
+ * \return The color the vertex is drawn with.
+ */
+ColorFloat Shape::getVertexColor(int index) {
+    if (!myMesh)
+        return ColorFloat(vertices[index*7+3], vertices[index*7+4], vertices[index*7+5], vertices[index*7+6]);
+    if (!myVertexColors.empty())
+        return VertexFormat::unpackColor(&myVertexColors[index*4]);
+    GLfloat shade = myMesh->getDrawnShade(index);
+    return ColorFloat(myMeshColor.R * shade, myMeshColor.G * shade, myMeshColor.B * shade, myMeshColor.A);
+}
+
+/*!
+ * \brief Mutator for the color of one of the Shape's vertices.
+ * \details For a mesh-backed Shape, the first call allocates a color for every vertex, starting from the current ones.
+ *   Color tracks running on the Shape start over from the new colors.
+ * \note The caller must hold <code>attribMutex</code>, is responsible for updating <code>myAlpha</code>, and calls
+ *   repack() once it has set every color.
+ *      \param index The index of the vertex.
+ *      \param color The new color of the vertex.
+ */
+void Shape::setVertexColor(int index, const ColorFloat &color) {
+    myAnimationBase.clear();
+    storeVertexColor(index, color);
+}
+
+// Stores the color of one vertex, as setVertexColor() does, without touching the colors animation starts from
+void Shape::storeVertexColor(int index, const ColorFloat &color) {
+    if (!myMesh) {
+        GLfloat * c = vertices + index*7 + 3;
+        c[0] = color.R;
+        c[1] = color.G;
+        c[2] = color.B;
+        c[3] = color.A;
+        return;
+    }
+    if (myVertexColors.empty()) {
+        myVertexColors.resize(numberOfVertices * 4);
+        for (int i = 0; i < numberOfVertices; i++)
+            VertexFormat::packColor(getVertexColor(i), &myVertexColors[i*4]);
+    }
+    VertexFormat::packColor(color, &myVertexColors[index*4]);
 }
 
  /*!
@@ -75,6 +406,7 @@ void Shape::addVertex(GLfloat x, GLfloat y, GLfloat z, const ColorFloat &color)
     if (currentVertex == numberOfVertices*7) {
         myAlpha /= numberOfVertices;
         init = true;
+        repack();
     }
     attribMutex.unlock();
 }
@@ -106,10 +438,127 @@ void Shape::addOutlineVertex(GLfloat x, GLfloat y, GLfloat z, const ColorFloat &
     currentOutlineVertex += 7;
     if (currentOutlineVertex == numberOfOutlineVertices*7) {
         outlineInit = true;
+        repack();
+    }
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Adds several vertices of one color to a Shape.
+ * \details Equivalent to calling addVertex() once per vertex, but locks <code>attribMutex</code> only once.
+ *      \param positions Array of <code>count</code> consecutive (x, y, z) positions.
+ *      \param count The number of vertices to add.
+ *      \param color The color of every vertex.
+ */
+void Shape::addVertices(const GLfloat positions[], int count, const ColorFloat &color) {
+    attribMutex.lock();
+    if (init || currentVertex + count*7 > numberOfVertices*7) {
+        attribMutex.unlock();
+        TsglDebug("Cannot add anymore vertices.");
+        return;
+    }
+    GLfloat * v = vertices + currentVertex;
+    for (int i = 0; i < count; ++i, v += 7) {
+        v[0] = positions[i*3];
+        v[1] = positions[i*3 + 1];
+        v[2] = positions[i*3 + 2];
+        v[3] = color.R;
+        v[4] = color.G;
+        v[5] = color.B;
+        v[6] = color.A;
+    }
+    currentVertex += count*7;
+    myAlpha += color.A * count;
+    if (currentVertex == numberOfVertices*7) {
+        myAlpha /= numberOfVertices;
+        init = true;
+        repack();
+    }
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Adds several vertices, each with its own color, to a Shape.
+ * \details Equivalent to calling addVertex() once per vertex, but locks <code>attribMutex</code> only once.
+ *      \param positions Array of <code>count</code> consecutive (x, y, z) positions.
+ *      \param count The number of vertices to add.
+ *      \param colors Array of <code>count</code> colors, one per vertex.
+ */
+void Shape::addVertices(const GLfloat positions[], int count, const ColorFloat colors[]) {
+    attribMutex.lock();
+    if (init || currentVertex + count*7 > numberOfVertices*7) {
+        attribMutex.unlock();
+        TsglDebug("Cannot add anymore vertices.");
+        return;
+    }
+    GLfloat * v = vertices + currentVertex;
+    for (int i = 0; i < count; ++i, v += 7) {
+        v[0] = positions[i*3];
+        v[1] = positions[i*3 + 1];
+        v[2] = positions[i*3 + 2];
+        v[3] = colors[i].R;
+        v[4] = colors[i].G;
+        v[5] = colors[i].B;
+        v[6] = colors[i].A;
+        myAlpha += colors[i].A;
+    }
+    currentVertex += count*7;
+    if (currentVertex == numberOfVertices*7) {
+        myAlpha /= numberOfVertices;
+        init = true;
+        repack();
+    }
+    attribMutex.unlock();
+}
+
+/*!
+ * \brief Adds several outline vertices of one color to a Shape.
+ * \details Equivalent to calling addOutlineVertex() once per vertex, but locks <code>attribMutex</code> only once.
+ *      \param positions Array of <code>count</code> consecutive (x, y, z) positions.
+ *      \param count The number of outline vertices to add.
+ *      \param color The color of every outline vertex.
+ */
+void Shape::addOutlineVertices(const GLfloat positions[], int count, const ColorFloat &color) {
+    attribMutex.lock();
+    if (outlineInit || currentOutlineVertex + count*7 > numberOfOutlineVertices*7) {
+        attribMutex.unlock();
+        TsglDebug("Cannot add anymore vertices.");
+        return;
+    }
+    GLfloat * v = outlineVertices + currentOutlineVertex;
+    for (int i = 0; i < count; ++i, v += 7) {
+        v[0] = positions[i*3];
+        v[1] = positions[i*3 + 1];
+        v[2] = positions[i*3 + 2];
+        v[3] = color.R;
+        v[4] = color.G;
+        v[5] = color.B;
+        v[6] = color.A;
+    }
+    currentOutlineVertex += count*7;
+    if (currentOutlineVertex == numberOfOutlineVertices*7) {
+        outlineInit = true;
+        repack();
     }
     attribMutex.unlock();
 }
 
+/*! \brief Set whether or not the Shape will be outlined.
+ *  \details Sets the isOutlined instance variable to the value of the parameter. A Shape drawing a SharedMesh
+ *    builds the mesh's outline here the first time it is outlined, rather than on the rendering thread.
+ *  \param status Boolean value to which isOutlined will be set equivalent.
+ *  \warning Disabling outlines on monocolored 3D Shapes can be awkward visually.
+ */
+void Shape::setIsOutlined(bool status) {
+    attribMutex.lock();
+    isOutlined = status;
+    if (status && myMesh)
+        myMesh->buildOutline();
+    repack();
+    attribMutex.unlock();
+    markDirty();
+}
+
 /**
  * \brief Sets the Shape to a new color.
  * \param c The new ColorFloat.
@@ -117,13 +566,24 @@ void Shape::addOutlineVertex(GLfloat x, GLfloat y, GLfloat z, const ColorFloat &
 void Shape::setColor(ColorFloat c) {
     attribMutex.lock();
     myAlpha = c.A;
+    myAnimationBase.clear();
+    if (myMesh) {
+        myMeshColor = c;
+        std::vector<GLubyte>().swap(myVertexColors);
+        repack();
+        attribMutex.unlock();
+        markDirty();
+        return;
+    }
     for(int i = 0; i < numberOfVertices; i++) {
         vertices[i*7 + 3] = c.R;
         vertices[i*7 + 4] = c.G;
         vertices[i*7 + 5] = c.B;
         vertices[i*7 + 6] = c.A;
     }
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -131,17 +591,17 @@ void Shape::setColor(ColorFloat c) {
  * \param c The new array of ColorFloats.
  */
 void Shape::setColor(ColorFloat c[]) {
+    disableDetail();
     attribMutex.lock();
     myAlpha = 0.0;
     for(int i = 0; i < numberOfVertices; i++) {
-        vertices[i*7 + 3] = c[i].R;
-        vertices[i*7 + 4] = c[i].G;
-        vertices[i*7 + 5] = c[i].B;
-        vertices[i*7 + 6] = c[i].A;
+        setVertexColor(i, c[i]);
         myAlpha += c[i].A;
     }
     myAlpha /= numberOfVertices;
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -150,13 +610,16 @@ void Shape::setColor(ColorFloat c[]) {
  */
 void Shape::setOutlineColor(ColorFloat c) {
     attribMutex.lock();
-    for(int i = 0; i < numberOfOutlineVertices; i++) {
+    myOutlineColor = c;
+    for(int i = 0; !myMesh && i < numberOfOutlineVertices; i++) {
         outlineVertices[i*7 + 3] = c.R;
         outlineVertices[i*7 + 4] = c.G;
         outlineVertices[i*7 + 5] = c.B;
         outlineVertices[i*7 + 6] = c.A;
     }
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -166,7 +629,7 @@ void Shape::setOutlineColor(ColorFloat c) {
  */
 ColorFloat Shape::getColor() {
     attribMutex.lock();
-    ColorFloat c = ColorFloat(vertices[3], vertices[4], vertices[5], vertices[6]);
+    ColorFloat c = getVertexColor(0);
     attribMutex.unlock();
     return c;
 }
@@ -179,7 +642,7 @@ ColorFloat Shape::getColor() {
 void Shape::getColors(std::vector<ColorFloat> &colorVec) {
     attribMutex.lock();
     for (int i = 0; i < numberOfVertices; i++) {
-        colorVec.push_back(ColorFloat(vertices[i*7+3],vertices[i*7+4],vertices[i*7+5],vertices[i*7+6]));
+        colorVec.push_back(getVertexColor(i));
     }
     attribMutex.unlock();
 }
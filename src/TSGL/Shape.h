@@ -8,6 +8,14 @@
 #include <GL/glew.h>    // Needed for GL function calls
 #include "Color.h"      // Needed for color type
 #include "Drawable.h"
+#include "GpuBuffer.h"  // For keeping the packed vertices on the GPU between frames
+#include "LevelOfDetail.h" // For choosing curved Shapes' tessellation from their size on screen
+#include "Mailbox.h"    // For handing what draw() needs to the render thread
+#include "SharedMesh.h" // For sharing unit meshes between identical Shapes
+#include "TrigTable.h"  // For points around a circle without calling sin() and cos()
+#include "VertexFormat.h" // For packing vertices in the compact format the shape shader reads
+#include <algorithm>    // For std::max
+#include <memory>       // For holding SharedMeshes
 
 namespace tsgl {
 
@@ -22,6 +30,9 @@ namespace tsgl {
  *  E.g., to draw a triangle, you would need 3 vertices = 18 floats -> vertices should be an array of length 18.
  *  \details <code>numberofvertices</code> should be the actual integer number of vertices to be drawn (e.g., *3* for a triangle).
  *  \details <code>drawingmode</code> should be one of GL's primitive drawing modes.
+ *  \details Shapes whose geometry only depends on their tessellation (Sphere, Ellipsoid, Prism, Cylinder, Pyramid, Cone,
+ *  Circle, Ellipse, Cube and Cuboid) instead call useMesh() with a SharedMesh, and store only their colors: a single color, or an array of
+ *  per-vertex colors allocated the first time a vertex is given its own color.
  *  See https://www.opengl.org/sdk/docs/man2/xhtml/glBegin.xml for further information.
  *  \details Theoretically, you could potentially extend the Shape class so that you can create another Shape class that suits your needs.
  *  \details However, this is not recommended for normal use of the TSGL library.
@@ -32,22 +43,89 @@ class Shape : public Drawable {
     int currentVertex = 0;
     GLenum geometryType;
     virtual void addVertex(GLfloat x, GLfloat y, GLfloat z, const ColorFloat &color = WHITE);  
+    void addVertices(const GLfloat positions[], int count, const ColorFloat &color);
+    void addVertices(const GLfloat positions[], int count, const ColorFloat colors[]);
     bool isFilled = true;  
 
    int numberOfOutlineVertices;
    int currentOutlineVertex = 0;
    GLenum outlineGeometryType;
    virtual void addOutlineVertex(GLfloat x, GLfloat y, GLfloat z, const ColorFloat &color = WHITE);
-   GLfloat * outlineVertices;
+   void addOutlineVertices(const GLfloat positions[], int count, const ColorFloat &color);
+   GLfloat * outlineVertices = nullptr;
    bool isOutlined = true;
 
    bool outlineInit = false;
 
+   std::shared_ptr<SharedMesh> myMesh;     // Shared geometry, or NULL if the Shape stores its own vertices
+   ColorFloat myMeshColor = WHITE;         // Color of every mesh vertex (times its shade) without an override
+   std::vector<GLubyte> myVertexColors;    // RGBA8 of each mesh vertex drawn; empty until a vertex gets its own color
+   ColorFloat myOutlineColor = GRAY;       // Color of every mesh outline vertex
+   std::vector<ColorFloat> myAnimationBase; // Vertex colors that color tracks scale; empty until the first animated frame
+
+   // Everything draw() reads, copied by repack() so that draw() never locks attribMutex
+   struct DrawState {
+       GLenum geometryType = GL_TRIANGLES, outlineGeometryType = GL_LINE_LOOP;
+       bool isFilled = false, isOutlined = false;
+       std::vector<PackedVertex> fill, outline;   // Packed vertices of a Shape that stores its own
+       std::shared_ptr<SharedMesh> mesh;          // Mesh of a mesh-backed Shape, or NULL
+       GLsizei count = 0, outlineCount = 0;       // Mesh vertices and mesh outline vertices drawn
+       ColorFloat meshColor, outlineColor;
+       std::vector<GLubyte> colors;               // RGBA8 of each vertex drawn or each shaded mesh vertex; empty for meshColor
+       bool vertexColors = false;                 // Whether colors has one color per vertex drawn
+   };
+   Mailbox<DrawState> myPosted;            // Latest DrawState from repack() that draw() has not taken yet
+   DrawState myDrawn;                      // DrawState being drawn; only used by the render thread
+   GpuBuffer myFillBuffer{GL_DYNAMIC_DRAW};
+   GpuBuffer myOutlineBuffer{GL_DYNAMIC_DRAW};
+   GpuBuffer myColorBuffer{GL_DYNAMIC_DRAW};  // Colors of a mesh-backed Shape
+
+   int myDetailLevel = -1;                 // Index into LevelOfDetail::SEGMENTS, or -1 if the tessellation is fixed
+   int myFixedSegments = 0;                // Segments used while the tessellation is fixed
+
+   void useMesh(std::shared_ptr<SharedMesh> mesh);
+   void setMesh(std::shared_ptr<SharedMesh> mesh);
+   void enableDetail(float radius);
+   void disableDetail();
+
+   /*!
+    * \brief Switches a curved Shape to the SharedMesh with the given number of segments around.
+    * \details Overridden by Shapes that support LevelOfDetail, which call setMesh(). Called with
+    *   <code>attribMutex</code> held.
+    * \param segments The number of segments around a full circle.
+    */
+   virtual void tessellate(int segments) { }
+
+   /*!
+    * \brief Accessor for the radius used to decide a curved Shape's level of detail.
+    * \return The largest of the Shape's scales.
+    */
+   virtual GLfloat getDetailRadius() { return std::max(myXScale, std::max(myYScale, myZScale)); }
+
+   /*!
+    * \brief Packs the vertices draw() fills the Shape with.
+    * \details Overridden by Shapes that draw their vertices in another order, such as ConcavePolygon. Called
+    *   with <code>attribMutex</code> held.
+    * \param out Array to fill with the packed vertices.
+    */
+   virtual void packFill(std::vector<PackedVertex>& out) { VertexFormat::pack(vertices, NULL, numberOfVertices, out); }
+   void repack();
+   ColorFloat getVertexColor(int index);
+   void setVertexColor(int index, const ColorFloat &color);
+   void storeVertexColor(int index, const ColorFloat &color);
+   void drawMesh(Shader * shader);
+
  public:
     Shape(float x, float y, float z, float yaw, float pitch, float roll);
 
     virtual void draw(Shader * shader);
 
+    virtual bool appendBatch(std::vector<PackedVertex>& out, std::vector<BatchRange>& ranges);
+
+    virtual void startAnimation(AnimatedProperty property);
+
+    virtual void applyAnimation(const float values[], unsigned mask);
+
     virtual void setColor(ColorFloat c);
     virtual void setColor(ColorFloat c[]);
     virtual void setOutlineColor(ColorFloat c);
@@ -56,21 +134,24 @@ class Shape : public Drawable {
 
     virtual bool isProcessed() { return outlineInit && init; }
 
+    virtual void selectDetail(const glm::vec3& eye, float pixelsPerUnit);
+
     /*! \brief Set whether or not the Shape will be filled.
      *  \details Sets the isFilled instance variable to the value of the parameter.
      *  \param status Boolean value to which isFilled will be set equivalent.
      *  \warning Disabling fill on some 3D Shapes, like Cone and Cylinder, can be awkward visually.
      */
-    virtual void setIsFilled(bool status) { isFilled = status; }
+    virtual void setIsFilled(bool status) {
+        attribMutex.lock();
+        isFilled = status;
+        repack();
+        attribMutex.unlock();
+        markDirty();
+    }
 
-    /*! \brief Set whether or not the Shape will be outlined.
-     *  \details Sets the isOutlined instance variable to the value of the parameter.
-     *  \param status Boolean value to which isOutlined will be set equivalent.
-     *  \warning Disabling outlines on monocolored 3D Shapes can be awkward visually.
-     */
-    virtual void setIsOutlined(bool status) { isOutlined = status; }
+    virtual void setIsOutlined(bool status);
 
-    ~Shape() { /* delete [] vertices; */ }
+    ~Shape() { if (!myVerticesInline) delete [] outlineVertices; }
 };
 
 }
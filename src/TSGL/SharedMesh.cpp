@@ -0,0 +1,191 @@
+#include "SharedMesh.h"
+
+#include <map>
+#include <tuple>
+#include <utility>
+
+namespace tsgl {
+
+namespace {
+    typedef std::tuple<int, int, int> meshKey;
+    typedef std::map<meshKey, std::weak_ptr<SharedMesh> > meshMap;
+
+    // The registry is never destroyed, so that Shapes in static objects can still release their meshes on exit
+    std::mutex& registryMutex() {
+        static std::mutex* m = new std::mutex();
+        return *m;
+    }
+
+    meshMap& registry() {
+        static meshMap* r = new meshMap();
+        return *r;
+    }
+}
+
+/*!
+ * \brief Explicit SharedMesh constructor method.
+ * \details Use acquire() rather than constructing a SharedMesh directly, so that the mesh is shared.
+ *   \param vertexCount The number of distinct fill vertices.
+ *   \param outlineVertexCount The number of outline vertices.
+ *   \param indexCount The number of corners drawn through an element buffer, or 0 if the mesh is drawn straight
+ *     from its fill vertices.
+ * \return A new SharedMesh with every fill vertex at the origin and no outline built yet.
+ */
+SharedMesh::SharedMesh(int vertexCount, int outlineVertexCount, int indexCount) {
+    myVertexCount = vertexCount;
+    myOutlineVertexCount = outlineVertexCount;
+    myOutlineBuilder = nullptr;
+    myDetailA = myDetailB = 0;
+    myPositions.assign(vertexCount * 3, 0.0f);
+    myIndices.assign(indexCount, 0);
+}
+
+/*!
+ * \brief Sets the position of a fill vertex.
+ * \details Only meant to be called while building the mesh.
+ *   \param index The index of the fill vertex.
+ *   \param x The x coordinate of the vertex.
+ *   \param y The y coordinate of the vertex.
+ *   \param z The z coordinate of the vertex.
+ *   \param shade A factor by which the vertex's color is darkened when the Shape is a single color.
+ */
+void SharedMesh::setVertex(int index, GLfloat x, GLfloat y, GLfloat z, GLfloat shade) {
+    myPositions[index*3] = x;
+    myPositions[index*3 + 1] = y;
+    myPositions[index*3 + 2] = z;
+    if (shade != 1.0f && myShades.empty())
+      myShades.assign(myVertexCount, 1.0f);
+    if (!myShades.empty())
+      myShades[index] = shade;
+}
+
+/*!
+ * \brief Sets the position of an outline vertex.
+ * \details Only meant to be called by the mesh's OutlineBuilder.
+ *   \param index The index of the outline vertex.
+ *   \param x The x coordinate of the vertex.
+ *   \param y The y coordinate of the vertex.
+ *   \param z The z coordinate of the vertex.
+ */
+void SharedMesh::setOutlineVertex(int index, GLfloat x, GLfloat y, GLfloat z) {
+    myOutlinePositions[index*3] = x;
+    myOutlinePositions[index*3 + 1] = y;
+    myOutlinePositions[index*3 + 2] = z;
+}
+
+/*!
+ * \brief Sets the function that builds the mesh's outline when it is first needed.
+ * \details Only meant to be called while building the mesh.
+ *   \param build The function that fills in the outline with setOutlineVertex().
+ *   \param detailA The first tessellation parameter to pass to <code>build</code>.
+ *   \param detailB The second tessellation parameter to pass to <code>build</code>.
+ */
+void SharedMesh::setOutlineBuilder(OutlineBuilder build, int detailA, int detailB) {
+    myOutlineBuilder = build;
+    myDetailA = detailA;
+    myDetailB = detailB;
+}
+
+/*!
+ * \brief Builds the mesh's outline, if it has not been built yet.
+ * \details Safe to call from several threads at once; the outline is only ever built once.
+ */
+void SharedMesh::buildOutline() {
+    std::call_once(myOutlineOnce, [this]() {
+      myOutlinePositions.assign(myOutlineVertexCount * 3, 0.0f);
+      if (myOutlineBuilder)
+        myOutlineBuilder(*this, myDetailA, myDetailB);
+    });
+}
+
+/*!
+ * \brief Binds the mesh's fill vertex buffer in the current GL context to GL_ARRAY_BUFFER, and its element buffer
+ *   (if it is indexed) to GL_ELEMENT_ARRAY_BUFFER.
+ * \details The buffers are uploaded the first time they are bound in a context.
+ * \note Must be called from a thread with a current GL context.
+ */
+void SharedMesh::bind() {
+    myBuffers[FILL_BUFFER].bind(GL_ARRAY_BUFFER, myPositions.data(), myPositions.size() * sizeof(GLfloat));
+    if (!myIndices.empty())
+      myBuffers[INDEX_BUFFER].bind(GL_ELEMENT_ARRAY_BUFFER, myIndices.data(), myIndices.size() * sizeof(GLuint));
+}
+
+/*!
+ * \brief Binds a buffer of the position of every corner drawn, in order, to GL_ARRAY_BUFFER.
+ * \details For Shapes with per-vertex colors, which cannot share corners. An indexed mesh builds the buffer the
+ *   first time it is needed; an unindexed mesh simply binds its fill vertex buffer.
+ * \note Must be called from a thread with a current GL context.
+ */
+void SharedMesh::bindExpanded() {
+    if (myIndices.empty()) {
+      myBuffers[FILL_BUFFER].bind(GL_ARRAY_BUFFER, myPositions.data(), myPositions.size() * sizeof(GLfloat));
+      return;
+    }
+    std::call_once(myExpandOnce, [this]() {
+      myExpandedPositions.resize(myIndices.size() * 3);
+      for (unsigned int i = 0; i < myIndices.size(); ++i)
+        for (int j = 0; j < 3; ++j)
+          myExpandedPositions[i*3 + j] = myPositions[myIndices[i]*3 + j];
+    });
+    myBuffers[EXPANDED_BUFFER].bind(GL_ARRAY_BUFFER, myExpandedPositions.data(), myExpandedPositions.size() * sizeof(GLfloat));
+}
+
+/*!
+ * \brief Binds the mesh's outline vertex buffer in the current GL context to GL_ARRAY_BUFFER.
+ * \details The outline is built if needed, and uploaded the first time it is bound in a context.
+ * \note Must be called from a thread with a current GL context.
+ */
+void SharedMesh::bindOutline() {
+    buildOutline();
+    myBuffers[OUTLINE_BUFFER].bind(GL_ARRAY_BUFFER, myOutlinePositions.data(), myOutlinePositions.size() * sizeof(GLfloat));
+}
+
+/*!
+ * \brief Accessor for the memory used by the mesh on the CPU.
+ * \return The size of the mesh's positions (including its outline and unindexed copy, if built), indices and
+ *   shades in bytes.
+ */
+size_t SharedMesh::getMemoryUsage() const {
+    return (myPositions.size() + myExpandedPositions.size() + myOutlinePositions.size() + myShades.size()) * sizeof(GLfloat)
+         + myIndices.size() * sizeof(GLuint);
+}
+
+/*!
+ * \brief Gets the shared mesh for a primitive, building it if no Shape is using one.
+ *   \param type The primitive.
+ *   \param detailA The first tessellation parameter of the primitive (e.g., a Prism's number of sides).
+ *   \param detailB The second tessellation parameter of the primitive, or 0 if it only has one.
+ *   \param build The function that creates the mesh if it does not exist yet. It is called with
+ *     <code>detailA</code> and <code>detailB</code>.
+ * \return A shared pointer to the mesh.
+ */
+std::shared_ptr<SharedMesh> SharedMesh::acquire(MeshType type, int detailA, int detailB, MeshBuilder build) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    std::weak_ptr<SharedMesh>& entry = registry()[meshKey(type, detailA, detailB)];
+    std::shared_ptr<SharedMesh> mesh = entry.lock();
+    if (!mesh) {
+      mesh.reset(build(detailA, detailB));
+      entry = mesh;
+    }
+    return mesh;
+}
+
+/*!
+ * \brief Accessor for the number of meshes currently shared.
+ * \return The number of distinct meshes in use by at least one Shape.
+ */
+unsigned int SharedMesh::getMeshCount() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    unsigned int count = 0;
+    for (meshMap::iterator it = registry().begin(); it != registry().end(); ) {
+      if (it->second.expired()) {
+        registry().erase(it++);
+      } else {
+        ++count;
+        ++it;
+      }
+    }
+    return count;
+}
+
+}
@@ -0,0 +1,138 @@
+/*
+ * SharedMesh.h provides reference-counted unit meshes shared between identical Shapes.
+ */
+
+#ifndef SHAREDMESH_H_
+#define SHAREDMESH_H_
+
+#include <GL/glew.h>     // Needed for GL function calls
+#include "GpuBuffer.h"   // For the buffer of each GL context
+#include <memory>        // For sharing meshes
+#include <mutex>         // For building parts of the mesh once
+#include <vector>        // For vertex storage
+
+namespace tsgl {
+
+/*! \enum MeshType
+ *  \brief The primitives whose unit meshes are shared through SharedMesh::acquire().
+ */
+enum MeshType {
+    MESH_SPHERE = 0,    // Sphere and Ellipsoid; keyed by vertical and horizontal sections
+    MESH_PRISM,         // Prism and Cylinder; keyed by number of sides
+    MESH_PYRAMID,       // Pyramid and Cone; keyed by number of sides
+    MESH_CIRCLE,        // Circle; keyed by number of vertices
+    MESH_CUBE           // Cube and Cuboid; one tessellation only
+};
+
+class SharedMesh;
+
+typedef SharedMesh* (*MeshBuilder)(int detailA, int detailB);  // Creates a new mesh for a tessellation
+typedef void (*OutlineBuilder)(SharedMesh& mesh, int detailA, int detailB);  // Fills in a mesh's outline
+
+/*! \class SharedMesh
+ *  \brief Vertex positions of a unit-sized primitive, shared by every Shape with the same tessellation.
+ *  \details A SharedMesh holds the positions of a Shape's fill vertices and of its outline vertices, plus an
+ *    optional brightness factor for each fill vertex (used to shade single-colored Spheres and Pyramids).
+ *  \details Meshes whose triangles share corners (Sphere, Prism, Pyramid, Cube) are indexed: each distinct corner is
+ *    stored once, and an element buffer lists the corners of each triangle. A Shape drawn in one color draws the
+ *    mesh through its element buffer. A Shape with per-vertex colors may color the same corner differently in
+ *    different triangles, so it instead draws an unindexed copy of the positions, built the first time one is needed.
+ *    Shapes apply their size through their scale, so a thousand Spheres of different radii all draw the same mesh.
+ *  \details Meshes are created by acquire(), which returns the existing mesh for a (type, detail) key if any
+ *    Shape still uses it. The mesh is freed when the last Shape using it is destroyed.
+ *  \details The outline is only built the first time a Shape using the mesh is outlined, since many Shapes
+ *    (Spheres, for instance) are not outlined by default.
+ *  \details Each GL context gets its own copy of the mesh in static GpuBuffers, uploaded the first time
+ *    the mesh is drawn in that context.
+ */
+class SharedMesh {
+ private:
+    enum BufferKind { FILL_BUFFER = 0, INDEX_BUFFER, EXPANDED_BUFFER, OUTLINE_BUFFER, BUFFER_KINDS };
+
+    std::vector<GLfloat>    myPositions;           // xyz of each fill vertex
+    std::vector<GLuint>     myIndices;             // Fill vertex of each corner drawn; empty if unindexed
+    std::vector<GLfloat>    myExpandedPositions;   // xyz of each corner drawn; empty until needed
+    std::vector<GLfloat>    myOutlinePositions;    // xyz of each outline vertex; empty until the outline is built
+    std::vector<GLfloat>    myShades;              // Brightness of each fill vertex; empty if unshaded
+    int                     myVertexCount;
+    int                     myOutlineVertexCount;
+    OutlineBuilder          myOutlineBuilder;
+    int                     myDetailA, myDetailB;  // Tessellation passed to myOutlineBuilder
+    std::once_flag          myOutlineOnce;
+    std::once_flag          myExpandOnce;
+    GpuBuffer               myBuffers[BUFFER_KINDS]; // Buffers of each kind in each GL context
+ public:
+    SharedMesh(int vertexCount, int outlineVertexCount, int indexCount = 0);
+
+    void setVertex(int index, GLfloat x, GLfloat y, GLfloat z, GLfloat shade = 1.0f);
+
+    /*!
+     * \brief Sets which fill vertex a corner of an indexed mesh's primitives uses.
+     * \details Only meant to be called while building the mesh.
+     *   \param index The position of the corner in the order the mesh is drawn.
+     *   \param vertex The fill vertex.
+     */
+    void setIndex(int index, int vertex) { myIndices[index] = vertex; }
+
+    void setOutlineVertex(int index, GLfloat x, GLfloat y, GLfloat z);
+
+    void setOutlineBuilder(OutlineBuilder build, int detailA, int detailB);
+
+    void buildOutline();
+
+    void bind();
+
+    void bindExpanded();
+
+    void bindOutline();
+
+    /*!
+     * \brief Accessor for the number of distinct fill vertices.
+     */
+    int getVertexCount() const { return myVertexCount; }
+
+    /*!
+     * \brief Accessor for the number of corners drawn: the number of indices if the mesh is indexed, or else
+     *   the number of fill vertices.
+     */
+    int getDrawCount() const { return myIndices.empty() ? myVertexCount : (int)myIndices.size(); }
+
+    /*!
+     * \brief Accessor for whether the mesh is drawn through an element buffer.
+     */
+    bool isIndexed() const { return !myIndices.empty(); }
+
+    /*!
+     * \brief Accessor for the number of outline vertices.
+     */
+    int getOutlineVertexCount() const { return myOutlineVertexCount; }
+
+    /*!
+     * \brief Accessor for whether any fill vertex is shaded.
+     */
+    bool isShaded() const { return !myShades.empty(); }
+
+    /*!
+     * \brief Accessor for the brightness of a fill vertex.
+     *   \param index The index of the fill vertex.
+     * \return A factor by which the vertex's red, green and blue are multiplied (1 if unshaded).
+     */
+    GLfloat getShade(int index) const { return myShades.empty() ? 1.0f : myShades[index]; }
+
+    /*!
+     * \brief Accessor for the brightness of a corner, in the order the mesh is drawn.
+     *   \param index The position of the corner, from 0 to getDrawCount() - 1.
+     * \return The shade of the fill vertex the corner uses.
+     */
+    GLfloat getDrawnShade(int index) const { return getShade(myIndices.empty() ? index : myIndices[index]); }
+
+    size_t getMemoryUsage() const;
+
+    static std::shared_ptr<SharedMesh> acquire(MeshType type, int detailA, int detailB, MeshBuilder build);
+
+    static unsigned int getMeshCount();
+};
+
+}
+
+#endif /* SHAREDMESH_H_ */
@@ -162,20 +162,20 @@ void Spectrogram::draw(float ratio) {
             bg->drawConvexPolygon(centerX,centerY,0, NUM_COLORS+1,maxx,maxy,0,0,0,black);
             bg->drawConvexPolygon(centerX,centerY,0, NUM_COLORS+1,xx,yy,0,0,0,col);
             break;
-        case HORIZONTAL:
-            can->pauseDrawing();
+        case HORIZONTAL: {
+            FrameUpdate update(*can);
             for (int k = 0; k < MAX_COLOR; ++k)
                 bg->drawLine(-can->getWindowWidth()/2,k - can->getWindowHeight()/2,0,(ratio*myWidth*count[k])/localmax - can->getWindowWidth()/2,k - can->getWindowHeight()/2,0, 0,0,0, ColorHSV((6.0f*k)/MAX_COLOR,1.0f,1.0f));
-            can->resumeDrawing();
             break;
-        case VERTICAL:
-            can->pauseDrawing();
+        }
+        case VERTICAL: {
+            FrameUpdate update(*can);
             //  can->clear();
             for (int k = 0; k < MAX_COLOR; ++k)
                 bg->drawLine(k-can->getWindowWidth()/2,myHeight - can->getWindowHeight()/2,0,k - can->getWindowWidth()/2,myHeight-(ratio*myHeight*count[k])/localmax - can->getWindowHeight()/2,0, 0,0,0, ColorHSV((6.0f*k)/MAX_COLOR,1.0f,1.0f));
-            can->resumeDrawing();
             break;
         }
+        }
     }
 }
 
@@ -17,7 +17,6 @@ namespace tsgl {
   * \return A new Sphere with a buffer for storing the specified numbered of vertices.
   */
 Sphere::Sphere(float x, float y, float z, GLfloat radius, float yaw, float pitch, float roll, ColorFloat c)  : Shape(x, y, z, yaw, pitch, roll)  {
-    // FIXME alpha param works kinda weirdly
     if (radius <= 0) {
         TsglDebug("Cannot have a Sphere with radius less than or equal to 0.");
     }
@@ -26,46 +25,13 @@ Sphere::Sphere(float x, float y, float z, GLfloat radius, float yaw, float pitch
     myXScale = radius;
     myYScale = radius;
     myZScale = radius;
-    verticalSections = 36;
-    horizontalSections = 20;
+    myFixedSegments = 36;
     geometryType = GL_TRIANGLE_STRIP;
-    numberOfVertices = verticalSections*horizontalSections*2 + 1;
-    vertices = new GLfloat[numberOfVertices * 7];
     outlineGeometryType = GL_LINES;
-    numberOfOutlineVertices = verticalSections*horizontalSections*4 + 1;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
     isOutlined = false;
-    attribMutex.unlock();  
-	for(float b=0;b<horizontalSections;b++)
-	{
-		for(float a=0;a<verticalSections;a++)
-		{
-			addVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), ColorFloat(c.R * (1 - 1 * sin(a/verticalSections * PI) / 2), c.G * (1 - 1 * sin(a/verticalSections * PI) / 2), c.B * (1 - 1 * sin(a/verticalSections * PI) / 2), 1));
-			addVertex(sin((a*PI)/(verticalSections/2))*sin(((b+1)*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos(((b+1)*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), ColorFloat(c.R * (1 - 1 * sin(a/verticalSections * PI) / 2), c.G * (1 - 1 * sin(a/verticalSections * PI) / 2), c.B * (1 - 1 * sin(a/verticalSections * PI) / 2), 1));
-		}
-	}
-    addVertex(0, 1, 0, c);
-
-    // horizontal outline
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin(((b+1)*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos(((b+1)*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-		}
-	}
-
-    // vertical outline
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-			addOutlineVertex(sin(((a+1)*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos(((a+1)*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin(((a+1)*PI)/(verticalSections/2)), GRAY);
-		}
-	}
-    addOutlineVertex(0, 1, 0, GRAY);
+    attribMutex.unlock();
+    enableDetail(radius);
+    setColor(c);
 }
 
  /*!
@@ -91,46 +57,105 @@ Sphere::Sphere(float x, float y, float z, GLfloat radius, float yaw, float pitch
     myXScale = radius;
     myYScale = radius;
     myZScale = radius;
-    verticalSections = 36;
-    horizontalSections = 20;
+    myFixedSegments = 36;
     geometryType = GL_TRIANGLE_STRIP;
-    numberOfVertices = verticalSections*horizontalSections*2 + 1;
-    vertices = new GLfloat[numberOfVertices * 7];
     outlineGeometryType = GL_LINES;
-    numberOfOutlineVertices = verticalSections*horizontalSections*4 + 1;
-    outlineVertices = new GLfloat[numberOfOutlineVertices * 7];
     isOutlined = false;
+    tessellate(myFixedSegments);
     attribMutex.unlock();
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			addVertex((sin((a*PI)/(verticalSections/2)))*(sin((b*PI)/horizontalSections)), (cos((a*PI)/(verticalSections/2))), (cos((b*PI)/horizontalSections))*(sin((a*PI)/(verticalSections/2))), c[b]);
-			addVertex((sin((a*PI)/(verticalSections/2)))*(sin(((b+1)*PI)/horizontalSections)), (cos((a*PI)/(verticalSections/2))), (cos(((b+1)*PI)/horizontalSections))*(sin((a*PI)/(verticalSections/2))), c[b]);
-		}
-	}
-    addVertex(0, 1, 0, c[horizontalSections]);
+    setColor(c);
+}
+
+namespace {
+    // Points on the unit sphere, looked up from TrigTables. Vertical angle a walks around a full circle in
+    // verticalSections / 2 steps per half turn; horizontal angle b walks half a circle in horizontalSections steps.
+    struct SpherePoints {
+        const GLfloat * vertical;
+        const GLfloat * horizontal;
+        int wrap;
+
+        SpherePoints(int verticalSections, int horizontalSections) {
+            wrap = verticalSections / 2 * 2;
+            vertical = TrigTable::unitCircle(wrap);
+            horizontal = TrigTable::unitCircle(horizontalSections * 2);
+        }
+
+        GLfloat y(int a) const { return vertical[(a % wrap)*2]; }
+        GLfloat x(int a, int b) const { return vertical[(a % wrap)*2 + 1] * horizontal[b*2 + 1]; }
+        GLfloat z(int a, int b) const { return vertical[(a % wrap)*2 + 1] * horizontal[b*2]; }
+    };
+}
+
+ /*!
+  * \brief Builds the unit sphere mesh shared by every Sphere and Ellipsoid with the same number of sections.
+  * \details Fill vertices are shaded darker towards the equator, so that single-colored Spheres look round.
+  *   Each point of the grid of sections is stored once, and the strip around each horizontal section indexes it.
+  *   \param verticalSections The number of sections from pole to pole.
+  *   \param horizontalSections The number of sections around the Sphere.
+  * \return A new SharedMesh of radius 1.
+  */
+SharedMesh * Sphere::buildMesh(int verticalSections, int horizontalSections) {
+    int gridVertices = verticalSections * (horizontalSections + 1);
+    SharedMesh * mesh = new SharedMesh(gridVertices + 1, verticalSections*horizontalSections*4 + 1,
+                                       verticalSections*horizontalSections*2 + 1);
+    SpherePoints p(verticalSections, horizontalSections);
+    const GLfloat * shades = TrigTable::unitCircle(verticalSections * 2);
+    for (int b = 0; b <= horizontalSections; b++) {
+        for (int a = 0; a < verticalSections; a++) {
+            float shade = 1 - shades[a*2 + 1] / 2;
+            mesh->setVertex(b*verticalSections + a, p.x(a,b), p.y(a), p.z(a,b), shade);
+        }
+    }
+    mesh->setVertex(gridVertices, 0, 1, 0);
 
+    int i = 0;
+    for (int b = 0; b < horizontalSections; b++) {
+        for (int a = 0; a < verticalSections; a++) {
+            mesh->setIndex(i++, b*verticalSections + a);
+            mesh->setIndex(i++, (b+1)*verticalSections + a);
+        }
+    }
+    mesh->setIndex(i, gridVertices);
+    mesh->setOutlineBuilder(buildOutline, verticalSections, horizontalSections);
+    return mesh;
+}
+
+ /*!
+  * \brief Fills in the outline of a unit sphere mesh, the first time a Sphere or Ellipsoid using it is outlined.
+  *   \param mesh The mesh made by buildMesh().
+  *   \param verticalSections The number of sections from pole to pole.
+  *   \param horizontalSections The number of sections around the Sphere.
+  */
+void Sphere::buildOutline(SharedMesh& mesh, int verticalSections, int horizontalSections) {
+    SpherePoints p(verticalSections, horizontalSections);
+    int o = 0;
     // horizontal outline
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin(((b+1)*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos(((b+1)*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-		}
-	}
+    for (int b = 0; b < horizontalSections; b++) {
+        for (int a = 0; a < verticalSections; a++) {
+            mesh.setOutlineVertex(o++, p.x(a,b), p.y(a), p.z(a,b));
+            mesh.setOutlineVertex(o++, p.x(a,b+1), p.y(a), p.z(a,b+1));
+        }
+    }
 
     // vertical outline
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			addOutlineVertex(sin((a*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos((a*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin((a*PI)/(verticalSections/2)), GRAY);
-			addOutlineVertex(sin(((a+1)*PI)/(verticalSections/2))*sin((b*PI)/horizontalSections), cos(((a+1)*PI)/(verticalSections/2)), cos((b*PI)/horizontalSections)*sin(((a+1)*PI)/(verticalSections/2)), GRAY);
-		}
-	}
-    addOutlineVertex(0, 1, 0, GRAY);
+    for (int b = 0; b < horizontalSections; b++) {
+        for (int a = 0; a < verticalSections; a++) {
+            mesh.setOutlineVertex(o++, p.x(a,b), p.y(a), p.z(a,b));
+            mesh.setOutlineVertex(o++, p.x(a+1,b), p.y(a+1), p.z(a+1,b));
+        }
+    }
+    mesh.setOutlineVertex(o, 0, 1, 0);
+}
+
+ /*!
+  * \brief Switches the Sphere to the sphere mesh with the given number of segments around.
+  * \details Called with <code>attribMutex</code> held.
+  *   \param segments The number of vertical sections; the number of horizontal sections follows from it.
+  */
+void Sphere::tessellate(int segments) {
+    verticalSections = segments;
+    horizontalSections = segments / 2 + 2;
+    setMesh(SharedMesh::acquire(MESH_SPHERE, verticalSections, horizontalSections, buildMesh));
 }
 
 /**
@@ -148,6 +173,7 @@ void Sphere::setRadius(float radius) {
     myYScale = radius;
     myZScale = radius;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -165,34 +191,7 @@ void Sphere::changeRadiusBy(float delta) {
     myYScale += delta;
     myZScale += delta;
     attribMutex.unlock();
-}
-
-/**
- * \brief Sets the Sphere to a new color.
- * \param c The new ColorFloat.
- */
-void Sphere::setColor(ColorFloat c) {
-    attribMutex.lock();
-    myAlpha = c.A;
-	for(int b=0;b<horizontalSections;b++)
-	{
-		for(int a=0;a<verticalSections;a++)
-		{
-			vertices[(b*verticalSections + a)*2*7 + 3] = c.R * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 4] = c.G * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 5] = c.B * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 6] = c.A;
-			vertices[(b*verticalSections + a)*2*7 + 10] = c.R * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 11] = c.G * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 12] = c.B * (1 - 1 * sin(((float)a)/verticalSections * PI) / 2);
-            vertices[(b*verticalSections + a)*2*7 + 13] = c.A;
-		}
-	}
-    vertices[horizontalSections*verticalSections*2*7+3] = c.R;
-    vertices[horizontalSections*verticalSections*2*7+4] = c.G;
-    vertices[horizontalSections*verticalSections*2*7+5] = c.B;
-    vertices[horizontalSections*verticalSections*2*7+6] = c.A;
-    attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -201,30 +200,24 @@ void Sphere::setColor(ColorFloat c) {
  * \details The array should have 20 ColorFloat minimum, one for each horizontal section. 
  */
 void Sphere::setColor(ColorFloat c[]) {
+    disableDetail();
     attribMutex.lock();
     myAlpha = 0.0;
 	for(int b=0;b<horizontalSections;b++)
 	{
 		for(int a=0;a<verticalSections;a++)
 		{
-			vertices[(b*verticalSections + a)*2*7 + 3] = c[b].R;
-            vertices[(b*verticalSections + a)*2*7 + 4] = c[b].G;
-            vertices[(b*verticalSections + a)*2*7 + 5] = c[b].B;
-            vertices[(b*verticalSections + a)*2*7 + 6] = c[b].A;
-			vertices[(b*verticalSections + a)*2*7 + 10] = c[b].R;
-            vertices[(b*verticalSections + a)*2*7 + 11] = c[b].G;
-            vertices[(b*verticalSections + a)*2*7 + 12] = c[b].B;
-            vertices[(b*verticalSections + a)*2*7 + 13] = c[b].A;
+			setVertexColor((b*verticalSections + a)*2, c[b]);
+			setVertexColor((b*verticalSections + a)*2 + 1, c[b]);
             myAlpha += c[b].A * 2;
 		}
 	}
-    vertices[horizontalSections*verticalSections*2*7+3] = c[horizontalSections].R;
-    vertices[horizontalSections*verticalSections*2*7+4] = c[horizontalSections].G;
-    vertices[horizontalSections*verticalSections*2*7+5] = c[horizontalSections].B;
-    vertices[horizontalSections*verticalSections*2*7+6] = c[horizontalSections].A;
+    setVertexColor(horizontalSections*verticalSections*2, c[horizontalSections]);
     myAlpha += c[horizontalSections].A;
     myAlpha /= numberOfVertices;
+    repack();
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -236,12 +229,7 @@ void Sphere::setColor(ColorFloat c[]) {
 void Sphere::getColors(std::vector<ColorFloat> &colorVec) {
     attribMutex.lock();
     for(int b=0;b<horizontalSections;b++) {
-        colorVec.push_back(ColorFloat(
-            vertices[(b*verticalSections)*2*7 + 3],
-            vertices[(b*verticalSections)*2*7 + 4],
-            vertices[(b*verticalSections)*2*7 + 5],
-            vertices[(b*verticalSections)*2*7 + 6])
-            );
+        colorVec.push_back(getVertexColor(b*verticalSections*2));
     }
     attribMutex.unlock();
 }
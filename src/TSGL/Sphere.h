@@ -18,6 +18,8 @@ class Sphere : public Shape {
 protected:
     GLfloat myRadius;
     int horizontalSections, verticalSections;
+
+    virtual void tessellate(int segments);
 public:
     Sphere(float x, float y, float z, GLfloat radius, float yaw, float pitch, float roll, ColorFloat c);
 
@@ -29,11 +31,15 @@ public:
 
     virtual GLfloat getRadius() { return myRadius; }
 
-    virtual void setColor(ColorFloat c);
+    virtual void setColor(ColorFloat c) { Shape::setColor(c); }
 
     virtual void setColor(ColorFloat c[]);
 
     virtual void getColors(std::vector<ColorFloat> &colorVec);
+
+    static SharedMesh * buildMesh(int verticalSections, int horizontalSections);
+
+    static void buildOutline(SharedMesh& mesh, int verticalSections, int horizontalSections);
 };
 
 }
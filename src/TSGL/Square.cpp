@@ -14,20 +14,13 @@ namespace tsgl {
  *   \param roll The Square's roll in 3D space.
  *   \param color The color of the Square.
  */
-Square::Square(float x, float y, float z, GLfloat sideLength, float yaw, float pitch, float roll, ColorFloat color) : ConvexPolygon(x,y,z,4,yaw,pitch,roll) {
+Square::Square(float x, float y, float z, GLfloat sideLength, float yaw, float pitch, float roll, ColorFloat color) : ConvexPolygon(x,y,z,4,yaw,pitch,roll,myVertexStorage,myOutlineStorage) {
     attribMutex.lock();
     myXScale = myYScale = mySideLength = sideLength;
     myZScale = 1;
     attribMutex.unlock();
-    addVertex(-0.5, 0.5, 0, color);
-    addVertex(-0.5, -0.5, 0, color);
-    addVertex(0.5, -0.5, 0, color);
-    addVertex(0.5, 0.5, 0, color);
-
-    addOutlineVertex(-0.5, 0.5, 0, GRAY);
-    addOutlineVertex(-0.5, -0.5, 0, GRAY);
-    addOutlineVertex(0.5, -0.5, 0, GRAY);
-    addOutlineVertex(0.5, 0.5, 0, GRAY);
+    addVertices(UNIT_SQUARE, 4, color);
+    addOutlineVertices(UNIT_SQUARE, 4, GRAY);
 }
 
 /*!
@@ -42,20 +35,13 @@ Square::Square(float x, float y, float z, GLfloat sideLength, float yaw, float p
  *   \param roll The Square's roll in 3D space.
  *   \param color An array of colors for the Square's vertices.
  */
-Square::Square(float x, float y, float z, GLfloat sideLength, float yaw, float pitch, float roll, ColorFloat color[]) : ConvexPolygon(x,y,z,4,yaw,pitch,roll) {
+Square::Square(float x, float y, float z, GLfloat sideLength, float yaw, float pitch, float roll, ColorFloat color[]) : ConvexPolygon(x,y,z,4,yaw,pitch,roll,myVertexStorage,myOutlineStorage) {
     attribMutex.lock();
     myXScale = myYScale = mySideLength = sideLength;
     myZScale = 1;
     attribMutex.unlock();
-    addVertex(-0.5, 0.5, 0, color[0]);
-    addVertex(-0.5, -0.5, 0, color[1]);
-    addVertex(0.5, -0.5, 0, color[2]);
-    addVertex(0.5, 0.5, 0, color[3]);
-    
-    addOutlineVertex(-0.5, 0.5, 0, GRAY);
-    addOutlineVertex(-0.5, -0.5, 0, GRAY);
-    addOutlineVertex(0.5, -0.5, 0, GRAY);
-    addOutlineVertex(0.5, 0.5, 0, GRAY);
+    addVertices(UNIT_SQUARE, 4, color);
+    addOutlineVertices(UNIT_SQUARE, 4, GRAY);
 }
 
 /**
@@ -71,6 +57,7 @@ void Square::setSideLength(GLfloat sideLength) {
     mySideLength = sideLength;
     myXScale = myYScale = sideLength;
     attribMutex.unlock();
+    markDirty();
 }
 
 /**
@@ -87,5 +74,6 @@ void Square::changeSideLengthBy(GLfloat delta) {
     myXScale += delta;
     myYScale += delta;
     attribMutex.unlock();
+    markDirty();
 }
 }
\ No newline at end of file
@@ -16,6 +16,8 @@ namespace tsgl {
 class Square : public ConvexPolygon {
 protected:
     GLfloat mySideLength;
+    GLfloat myVertexStorage[4 * 7];         // Inline storage for the fill vertices
+    GLfloat myOutlineStorage[4 * 7];        // Inline storage for the outline vertices
 public:
     Square(float x, float y, float z, GLfloat sideLength, float yaw, float pitch, float roll, ColorFloat color);
 
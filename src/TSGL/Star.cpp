@@ -31,18 +31,21 @@ Star::Star(float x, float y, float z, GLfloat radius, int points, float yaw, flo
     myZScale = 1;
     myPoints = points;
     attribMutex.unlock();
-    float delta = 2.0f / points * PI;
+    // Inner points are every other entry of a table of points*2 segments; tips are the entries between them,
+    // or (ninja) the inner points' angles at full radius.
+    const GLfloat * t = TrigTable::unitCircle(points * 2);
+    std::vector<GLfloat> positions(points * 6);
     for(int i = 0; i < points; ++i) {
-        addVertex(0.5*cos(i*delta), 0.5*sin(i*delta), 0, color);
-        addOutlineVertex(0.5*cos(i*delta), 0.5*sin(i*delta), 0, GRAY);
-        if( ninja ) {
-            addVertex(cos(i*delta), sin(i*delta), 0, color);
-            addOutlineVertex(cos(i*delta), sin(i*delta), 0, GRAY);
-        } else {
-            addVertex(cos((i+0.5)*delta), sin((i+0.5)*delta), 0, color);
-            addOutlineVertex(cos((i+0.5)*delta), sin((i+0.5)*delta), 0, GRAY);
-        }
+        int tip = ninja ? i*2 : i*2 + 1;
+        positions[i*6] = 0.5*t[i*4];
+        positions[i*6 + 1] = 0.5*t[i*4 + 1];
+        positions[i*6 + 2] = 0;
+        positions[i*6 + 3] = t[tip*2];
+        positions[i*6 + 4] = t[tip*2 + 1];
+        positions[i*6 + 5] = 0;
     }
+    addVertices(positions.data(), points * 2, color);
+    addOutlineVertices(positions.data(), points * 2, GRAY);
 }
 
  /*!
@@ -74,18 +77,23 @@ Star::Star(float x, float y, float z, GLfloat radius, int points, float yaw, flo
     myZScale = 1;
     myPoints = points;
     attribMutex.unlock();
-    float delta = 2.0f / points * PI;
+    // Inner points are every other entry of a table of points*2 segments; tips are the entries between them,
+    // or (ninja) the inner points' angles at full radius.
+    const GLfloat * t = TrigTable::unitCircle(points * 2);
+    std::vector<GLfloat> positions(points * 6);
+    std::vector<ColorFloat> colors(points * 2);
     for(int i = 0; i < points; ++i) {
-        addVertex(0.5*cos(i*delta), 0.5*sin(i*delta), 0, color[i]);
-        addOutlineVertex(0.5*cos(i*delta), 0.5*sin(i*delta), 0, GRAY);
-        if( ninja ) {
-            addVertex(cos(i*delta), sin(i*delta), 0, color[i]);
-            addOutlineVertex(cos(i*delta), sin(i*delta), 0, GRAY);
-        } else {
-            addVertex(cos(((float)i+0.5)*delta), sin(((float)i+0.5)*delta), 0, color[i]);
-            addOutlineVertex(cos(((float)i+0.5)*delta), sin(((float)i+0.5)*delta), 0, GRAY);
-        }
+        int tip = ninja ? i*2 : i*2 + 1;
+        positions[i*6] = 0.5*t[i*4];
+        positions[i*6 + 1] = 0.5*t[i*4 + 1];
+        positions[i*6 + 2] = 0;
+        positions[i*6 + 3] = t[tip*2];
+        positions[i*6 + 4] = t[tip*2 + 1];
+        positions[i*6 + 5] = 0;
+        colors[i*2] = colors[i*2 + 1] = color[i];
     }
+    addVertices(positions.data(), points * 2, colors.data());
+    addOutlineVertices(positions.data(), points * 2, GRAY);
 }
 
 void Star::setRadius(GLfloat radius) {
@@ -98,6 +106,7 @@ void Star::setRadius(GLfloat radius) {
     myYScale = radius;
     myRadius = radius;
     attribMutex.unlock();
+    markDirty();
 }
 
 void Star::changeRadiusBy(GLfloat delta) {
@@ -110,5 +119,6 @@ void Star::changeRadiusBy(GLfloat delta) {
     myYScale += delta;
     myRadius += delta;
     attribMutex.unlock();
+    markDirty();
 }
 }
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "TaskPool.h"
+
+#include "Error.h"
+
+#ifdef __linux__
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+namespace tsgl {
+
+namespace {
+    // The pool and queue of the worker running on this thread, if any
+    thread_local TaskPool * currentPool = nullptr;
+    thread_local unsigned currentQueue = 0;
+}
+
+ /*!
+  * \brief Constructs a TaskPool and starts its workers.
+  * \param threads The number of worker threads; 0, the default, for one fewer than the number of cores, and
+  *   at least one.
+  * \return A new TaskPool, ready to take tasks.
+  */
+TaskPool::TaskPool(unsigned threads) {
+    unsigned cores = std::thread::hardware_concurrency();
+    if (threads == 0)
+        threads = (cores > 1) ? cores - 1 : 1;
+    for (unsigned i = 0; i < threads; i++)
+        myQueues.emplace_back(new Queue());
+    for (unsigned i = 0; i < threads; i++) {
+        myThreads.emplace_back(&TaskPool::workerLoop, this, i);
+    #ifdef __linux__
+        // Keep the workers off the last core, so that one core is always free for the rendering thread
+        if (cores > 1) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            for (unsigned c = 0; c < cores - 1; c++)
+                CPU_SET(c, &cpus);
+            if (pthread_setaffinity_np(myThreads.back().native_handle(), sizeof(cpus), &cpus) != 0)
+                TsglDebug("Could not keep a TaskPool worker off the last core.");
+        }
+    #endif
+    }
+}
+
+ /*!
+  * \brief Destroys a TaskPool.
+  * \details Waits for the workers to finish the tasks already queued, then stops them.
+  */
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(mySleepMutex);
+        myStopping.store(true);
+    }
+    myWorkCondition.notify_all();
+    for (unsigned i = 0; i < myThreads.size(); i++)
+        myThreads[i].join();
+}
+
+/*!
+ * \brief Accessor for the TaskPool shared by the whole program.
+ * \details The pool is made with the default number of threads the first time it is needed.
+ */
+TaskPool& TaskPool::global() {
+    static TaskPool pool;
+    return pool;
+}
+
+/*!
+ * \brief Queues a task.
+ * \details A task queued from one of the pool's workers goes on that worker's own queue; others are spread
+ *   out over the queues in turn.
+ * \param group The TaskGroup to count the task in until it finishes.
+ * \param task The function to run on one of the workers.
+ */
+void TaskPool::submit(TaskGroup& group, std::function<void()> task) {
+    unsigned index = (currentPool == this) ? currentQueue : myNextQueue++ % myQueues.size();
+    group.myPending++;
+    myQueued++;                                           // Before the push, so a thief's decrement never underflows it
+    {
+        std::lock_guard<std::mutex> lock(myQueues[index]->mutex);
+        myQueues[index]->tasks.push_back(Task{std::move(task), &group});
+    }
+    {
+        std::lock_guard<std::mutex> lock(mySleepMutex);   // So that no sleeper misses the notification
+    }
+    myWorkCondition.notify_one();
+    if (myWaiting.load() > 0)
+        myDoneCondition.notify_all();
+}
+
+// Takes a task, from the back of this worker's own queue or the front of another's, and runs it
+bool TaskPool::runOne() {
+    if (myQueued.load() == 0)
+        return false;
+    unsigned n = myQueues.size();
+    unsigned first = (currentPool == this) ? currentQueue : 0;
+    Task task;
+    bool found = false;
+    for (unsigned i = 0; i < n && !found; i++) {
+        Queue& q = *myQueues[(first + i) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty())
+            continue;
+        if (i == 0 && currentPool == this) {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+        } else {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+        }
+        found = true;
+    }
+    if (!found)
+        return false;
+    myQueued--;
+    task.function();
+    if (--task.group->myPending == 0) {
+        {
+            std::lock_guard<std::mutex> lock(mySleepMutex);
+        }
+        myDoneCondition.notify_all();
+    }
+    return true;
+}
+
+// Runs tasks until the pool stops, sleeping while there are none
+void TaskPool::workerLoop(unsigned index) {
+    currentPool = this;
+    currentQueue = index;
+    while (true) {
+        if (runOne())
+            continue;
+        std::unique_lock<std::mutex> lock(mySleepMutex);
+        myWorkCondition.wait(lock, [this]() { return myQueued.load() > 0 || myStopping.load(); });
+        if (myStopping.load() && myQueued.load() == 0)
+            return;
+    }
+}
+
+/*!
+ * \brief Waits for every task in a TaskGroup to finish.
+ * \details The calling thread runs queued tasks while it waits, and sleeps when there are none.
+ * \param group The TaskGroup to wait for.
+ */
+void TaskPool::wait(TaskGroup& group) {
+    while (!group.isDone()) {
+        if (runOne())
+            continue;
+        std::unique_lock<std::mutex> lock(mySleepMutex);
+        myWaiting++;
+        myDoneCondition.wait(lock, [this, &group]() { return group.isDone() || myQueued.load() > 0; });
+        myWaiting--;
+    }
+}
+
+// Runs body on [begin, end), queuing the upper half of the range until what is left is no larger than grain
+void TaskPool::splitRange(TaskGroup& group, int begin, int end, int grain, const std::function<void(int, int)>& body) {
+    while (end - begin > grain) {
+        int middle = begin + (end - begin) / 2;
+        submit(group, [this, &group, middle, end, grain, &body]() { splitRange(group, middle, end, grain, body); });
+        end = middle;
+    }
+    body(begin, end);
+}
+
+/*!
+ * \brief Runs a loop over a range of indices on the pool's workers and the calling thread.
+ * \details Returns once the whole range is done.
+ * \param begin The first index.
+ * \param end One past the last index.
+ * \param body Function called with the first index and one past the last index of each piece of the range.
+ * \param grain The largest piece of the range to give to one call of body; 0, the default, for about eight
+ *   pieces per thread.
+ */
+void TaskPool::parallelFor(int begin, int end, const std::function<void(int, int)>& body, int grain) {
+    if (end <= begin)
+        return;
+    if (grain < 1) {
+        grain = (end - begin) / (8 * (getThreadCount() + 1));
+        if (grain < 1) grain = 1;
+    }
+    TaskGroup group;
+    splitRange(group, begin, end, grain, body);
+    wait(group);
+}
+
+}
@@ -0,0 +1,98 @@
+/*
+ * TaskPool.h provides a work-stealing pool of threads for splitting up simulation work.
+ */
+
+#ifndef TASKPOOL_H_
+#define TASKPOOL_H_
+
+#include <atomic>              // For the task counters
+#include <condition_variable>  // For putting idle threads to sleep
+#include <deque>               // For the task queues
+#include <functional>          // For holding tasks
+#include <memory>              // For owning the queues
+#include <mutex>               // For locking the queues
+#include <thread>              // For the worker threads
+#include <vector>              // For the workers
+
+namespace tsgl {
+
+/*! \class TaskGroup
+ *  \brief Counts the tasks given to a TaskPool that have not finished yet, so they can be waited for together.
+ */
+class TaskGroup {
+ private:
+    friend class TaskPool;
+    std::atomic<int> myPending{0};
+ public:
+    /*!
+     * \brief Accessor for whether every task in the TaskGroup has finished.
+     */
+    bool isDone() const { return myPending.load() == 0; }
+};
+
+/*! \class TaskPool
+ *  \brief A fixed set of worker threads that run tasks, with a parallel for loop built on top.
+ *  \details Each worker has its own queue. A worker runs the newest task on its own queue first, and once that
+ *    is empty steals the oldest task from another worker's queue, so work spreads out on its own without a
+ *    single shared queue for every thread to fight over. Idle workers sleep on a condition variable.
+ *  \details parallelFor() splits its range in halves until the pieces are no larger than its grain, pushing one
+ *    half and working on the other, so that idle workers steal large pieces first. A thread waiting for tasks
+ *    with wait() or parallelFor() runs queued tasks itself meanwhile, so tasks may start and wait for other
+ *    tasks without deadlocking.
+ *  \details By default the pool has one thread fewer than the machine has cores, which leaves a core for the
+ *    Canvas' rendering thread; on Linux, the workers are also kept off the last core, so that one core is always
+ *    free. The rendering thread itself is not pinned, and runs wherever the OS schedules it. How many threads do
+ *    the work then follows the number of cores, not the number of objects simulated.
+ *  \details global() is a pool shared by the whole program, which Canvas uses for its frame steps
+ *    (see Canvas::setFrameStep()).
+ *  \warning Tasks must not throw.
+ */
+class TaskPool {
+ private:
+    struct Task {
+        std::function<void()> function;
+        TaskGroup * group;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> myQueues;  // One per worker
+    std::vector<std::thread> myThreads;
+    std::atomic<unsigned> myQueued{0};             // Tasks in every queue, or about to be pushed onto one
+    std::atomic<unsigned> myNextQueue{0};          // Queue for the next task from outside the pool
+    std::atomic<unsigned> myWaiting{0};            // Threads blocked in wait()
+    std::atomic<bool> myStopping{false};
+    std::mutex mySleepMutex;
+    std::condition_variable myWorkCondition;       // Signaled when a task is queued or the pool stops
+    std::condition_variable myDoneCondition;       // Signaled when a TaskGroup finishes or a task is queued
+
+    bool runOne();
+    void workerLoop(unsigned index);
+    void splitRange(TaskGroup& group, int begin, int end, int grain, const std::function<void(int, int)>& body);
+ public:
+    explicit TaskPool(unsigned threads = 0);
+
+    ~TaskPool();
+
+    static TaskPool& global();
+
+    /*!
+     * \brief Accessor for the number of worker threads.
+     */
+    unsigned getThreadCount() const { return myThreads.size(); }
+
+    void submit(TaskGroup& group, std::function<void()> task);
+
+    void wait(TaskGroup& group);
+
+    void parallelFor(int begin, int end, const std::function<void(int, int)>& body, int grain = 0);
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+};
+
+}
+
+#endif /* TASKPOOL_H_ */
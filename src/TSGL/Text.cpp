@@ -65,13 +65,7 @@ Text::Text(float x, float y, float z, std::wstring text, std::string fontFilenam
  *  \param shader Pointer to appropriate instance of Shader being used to render the Text.
  */
 void Text::draw(Shader * shader) {
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(myRotationPointX, myRotationPointY, myRotationPointZ));
-    model = glm::rotate(model, glm::radians(myCurrentYaw), glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::rotate(model, glm::radians(myCurrentPitch), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(myCurrentRoll), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::translate(model, glm::vec3(myCenterX - myRotationPointX, myCenterY - myRotationPointY, myCenterZ - myRotationPointZ));
-    model = glm::scale(model, glm::vec3(mySize / 100, mySize / 100, myZScale));
+    glm::mat4 model = glm::scale(modelMatrix(), glm::vec3(mySize / 100, mySize / 100, 1));
 
     unsigned int modelLoc = glGetUniformLocation(shader->ID, "model");
     glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
@@ -152,6 +146,7 @@ void Text::setText(std::wstring text) {
     populateCharacters();
     init = true;
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
@@ -164,6 +159,7 @@ void Text::setSize(float size) {
     attribMutex.lock();
     mySize = size;
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
@@ -195,6 +191,7 @@ void Text::setFont(std::string filename) {
     populateCharacters();
     init = true;
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
@@ -207,6 +204,7 @@ void Text::setColor(const ColorFloat& color) {
     myColor = color;
     myAlpha = color.A;
     attribMutex.unlock();
+    markDirty();
 }
 
 /*!
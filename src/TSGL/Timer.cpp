@@ -9,6 +9,9 @@ namespace tsgl {
  * \return A new Timer with the specified period.
  */
 Timer::Timer(double period) {
+    spin_threshold_ = duration_d(0.002);
+    throttled_ = true;
+    intervals.reserve(STATS_WINDOW);
     reset(period);
 }
 
@@ -29,6 +32,54 @@ unsigned int Timer::getReps() const {
     return std::chrono::duration_cast<duration_d>(highResClock::now() - start_time).count() / period_.count();
 }
 
+// Summarize the most recent intervals between ticks
+/*!
+ * \brief Gets statistics about the intervals between the Timer's most recent ticks.
+ * \details Only calls to sleep() with <code>update</code> set to true are taken into account.
+ * \return A FrameTimeStats describing the last (up to) STATS_WINDOW intervals between returns from sleep().
+ *   If no interval has been recorded yet, every field is 0.
+ */
+FrameTimeStats Timer::getFrameTimeStats() const {
+    FrameTimeStats stats = {0, 0.0, 0.0, 0.0, 0.0, 0.0, 0};
+    mutexLock statsLock(stats_);
+    std::vector<double> sorted(intervals);
+    stats.missed = missed_deadlines;
+    statsLock.unlock();
+
+    if (sorted.empty())
+      return stats;
+    std::sort(sorted.begin(), sorted.end());
+    unsigned int n = sorted.size();
+    double total = 0.0;
+    for (unsigned int i = 0; i < n; ++i)
+      total += sorted[i];
+    stats.samples = n;
+    stats.mean = total / n;
+    stats.p50 = sorted[(n - 1) * 50 / 100];
+    stats.p95 = sorted[(n - 1) * 95 / 100];
+    stats.p99 = sorted[(n - 1) * 99 / 100];
+    stats.max = sorted[n - 1];
+    return stats;
+}
+
+// Get the length of a period
+/*!
+ * \brief Gets the period of the Timer.
+ * \return The time in seconds between two consecutive ticks of the Timer.
+ */
+double Timer::getPeriod() const {
+    return period_.count();
+}
+
+// Get the busy-wait threshold
+/*!
+ * \brief Gets the spin threshold of the Timer.
+ * \return The time in seconds before each deadline during which sleep(true) busy-waits instead of sleeping.
+ */
+double Timer::getSpinThreshold() const {
+    return spin_threshold_.count();
+}
+
 // Get the time since start
 /*!
  * \brief Gets the elapsed time since starting the timer
@@ -50,6 +101,15 @@ double Timer::getTimeBetweenSleeps() const {
     return time_between_sleeps;
 }
 
+// Check if sleep() waits for the period to pass
+/*!
+ * \brief Accessor for the Timer's throttling mode.
+ * \return True if sleep() waits for the end of the period, false if it returns immediately.
+ */
+bool Timer::isThrottled() const {
+    return throttled_;
+}
+
 // Check if the timer has elapsed past the point when it last past the period
 /*!
  * \brief Check if the Timer's period has elapsed.
@@ -73,9 +133,57 @@ bool Timer::pastPeriod() {
  *     the current period.
  */
 void Timer::reset(double period) {
-    start_time = last_time = highResClock::now();
+    start_time = last_time = last_wake = highResClock::now();
     if (period > 0) period_ = duration_d(period);
     last_rep = 0;
+    time_between_sleeps = -1;
+
+    mutexLock statsLock(stats_);
+    intervals.clear();
+    next_interval = 0;
+    missed_deadlines = 0;
+}
+
+// Starts a new period at the current time
+/*!
+ * \brief Restarts the Timer's current period at the present time.
+ * \details This function realigns the Timer's ticks so that the next call to sleep() returns one full
+ *   <code>period</code> from now. Unlike reset(), the start time and the number of repetitions are kept.
+ * \details The time elapsed since the last tick is not recorded in the Timer's statistics.
+ * \note Canvas calls this after being woken up by a change to its scene, so that the frame is drawn right away
+ *   and the following one is paced from there.
+ */
+void Timer::restartPeriod() {
+    mutexLock sleepLock(sleep_);
+    last_time = last_wake = highResClock::now();
+}
+
+// Change the busy-wait threshold
+/*!
+ * \brief Mutator for the spin threshold of the Timer.
+ * \details sleep(true), which ticks the Timer (as the Canvas' rendering thread does), hands the thread over
+ *   to the OS until <code>seconds</code> seconds before the deadline, and then busy-waits until the deadline.
+ *   Larger values hit deadlines more precisely, at the cost of keeping a core busy for longer. sleep(false),
+ *   which Canvas::sleep() uses for every other thread, never busy-waits.
+ *   \param seconds The new spin threshold. Setting this to 0 disables busy-waiting altogether.
+ *     Negative values are treated as 0.
+ */
+void Timer::setSpinThreshold(double seconds) {
+    mutexLock sleepLock(sleep_);
+    spin_threshold_ = duration_d((seconds > 0) ? seconds : 0);
+}
+
+// Turn waiting for the period on or off
+/*!
+ * \brief Mutator for the Timer's throttling mode.
+ * \details An unthrottled Timer never waits in sleep(), but still records the time between its calls.
+ *   This is mostly useful for benchmarking.
+ *   \param throttled Whether sleep() should wait for the end of the period.
+ */
+void Timer::setThrottled(bool throttled) {
+    mutexLock sleepLock(sleep_);
+    throttled_ = throttled;
+    last_time = highResClock::now();
 }
 
 // Sleep the thread until the period has passed
@@ -84,28 +192,59 @@ void Timer::reset(double period) {
  * \details This function tells the currently executing thread to sleep until the rest of the Timer
  *   instance's remaining period expires.
  * \details If the Timer's period has elapsed since last call, the thread will continue execution
- *   normally until the next call to sleep().
- *   \param update Whether to update the timer's last_rep status or not.
+ *   normally until the next call to sleep(), and the skipped ticks are counted as missed deadlines.
+ * \details When <code>update</code> is true, the last getSpinThreshold() seconds before the deadline are
+ *   busy-waited; otherwise the thread sleeps the whole way. An unthrottled Timer returns immediately.
+ *   \param update Whether to update the timer's last_rep status and frame time statistics or not.
  * \note This function does not guarantee the thread will resume immediately after the time expires.
  *   Depending on your OS, the thread may sleep for longer.
  * \see getTimeBetweenSleeps(), to get the actual elapsed time between sleeps.
  */
 void Timer::sleep(bool update) {
     mutexLock sleepLock(sleep_);
+    timepoint_d now = highResClock::now();
     timepoint_d sleep_time = last_time;
-    while (sleep_time < highResClock::now()) {
-      sleep_time = sleep_time + period_;
+    unsigned long ticks = 0;
+    if (throttled_) {
+      while (sleep_time < now) {
+        sleep_time = sleep_time + period_;
+        ++ticks;
+      }
+    } else {
+      sleep_time = now;
     }
-    sleepLock.unlock();
-
+    duration_d spin = update ? spin_threshold_ : duration_d(0);   // Only the ticking thread needs the precision
     if (update)
       last_time = sleep_time;
+    sleepLock.unlock();
+
+    // Sleep through most of the period, then spin so the OS waking us up late doesn't make us miss the deadline
+    duration_d remaining = sleep_time - highResClock::now() - spin;
+    if (remaining.count() > 0)
+      std::this_thread::sleep_for(std::chrono::duration_cast<std::chrono::nanoseconds>(remaining));
+    while (update && highResClock::now() < sleep_time)
+      std::this_thread::yield();
+
+    if (update) {
+      if (ticks > 1) {
+        mutexLock statsLock(stats_);
+        missed_deadlines += ticks - 1;
+      }
+      recordInterval(highResClock::now());
+    }
+}
 
-    long double nano = std::chrono::duration_cast<duration_d>(sleep_time - highResClock::now()).count();
-    std::this_thread::sleep_for(std::chrono::nanoseconds((long long) (nano * 1000000000)));
+// Record the time since the last tick
+void Timer::recordInterval(timepoint_d now) {
+    time_between_sleeps = std::chrono::duration_cast<duration_d>(now - last_wake).count();
+    last_wake = now;
 
-    time_between_sleeps = std::chrono::duration_cast<duration_d>(highResClock::now() - sleep_time).count()
-        + period_.count();
+    mutexLock statsLock(stats_);
+    if (intervals.size() < STATS_WINDOW)
+      intervals.push_back(time_between_sleeps);
+    else
+      intervals[next_interval] = time_between_sleeps;
+    next_interval = (next_interval + 1) % STATS_WINDOW;
 }
 
 // Sleep the thread for a specified duration
@@ -5,9 +5,11 @@
 #ifndef TIMER_H_
 #define TIMER_H_
 
+#include <algorithm>     // For computing percentiles
 #include <chrono>        // For timing
 #include <mutex>         // Needed for locking for thread-safety
 #include <thread>        // For sleeping
+#include <vector>        // For the rolling window of frame intervals
 #include <iostream>
 
 typedef std::chrono::high_resolution_clock highResClock;
@@ -16,10 +18,28 @@ typedef std::chrono::time_point<highResClock, duration_d> timepoint_d;
 
 namespace tsgl {
 
+/*! \struct FrameTimeStats
+ *  \brief Summary of the intervals between the most recent ticks of a Timer.
+ *  \details All times are in seconds. Percentiles are computed over the last Timer::STATS_WINDOW intervals,
+ *    while <code>missed</code> counts every deadline missed since the Timer was last reset.
+ */
+struct FrameTimeStats {
+    unsigned int  samples;   // Number of intervals in the window
+    double        mean;      // Mean interval
+    double        p50;       // Median interval
+    double        p95;       // 95th percentile interval
+    double        p99;       // 99th percentile interval
+    double        max;       // Longest interval in the window
+    unsigned long missed;    // Number of ticks skipped because sleep() was called after its deadline
+};
+
 /*! \class Timer
  *  \brief A class for various timing operations.
  *  \details Timer provides a simple timer for timing, sleeping threads, and keeping track of the
  *    current rendering frame.
+ *  \details To hit its deadlines precisely, sleep(true) lets the OS put the thread to sleep for most of the period
+ *    and busy-waits for the last <code>spin threshold</code> seconds; sleep(false) only sleeps. The intervals between ticks are kept in
+ *    a rolling window, which can be summarized with getFrameTimeStats().
  */
 class Timer {
  private:
@@ -27,24 +47,49 @@ class Timer {
 
     unsigned int last_rep;
     duration_d period_;
-    timepoint_d start_time, last_time;
+    duration_d spin_threshold_;
+    bool throttled_;
+    timepoint_d start_time, last_time, last_wake;
     std::mutex sleep_;
     double time_between_sleeps;
+
+    mutable std::mutex stats_;
+    std::vector<double> intervals;
+    unsigned int next_interval;
+    unsigned long missed_deadlines;
+
+    void recordInterval(timepoint_d now);
  public:
+    static const unsigned int STATS_WINDOW = 256;      // Number of intervals kept for getFrameTimeStats()
+
     Timer(double period);
 
     virtual ~Timer();
 
     unsigned int getReps() const;
 
+    FrameTimeStats getFrameTimeStats() const;
+
+    double getPeriod() const;
+
+    double getSpinThreshold() const;
+
     double getTime() const;
 
     double getTimeBetweenSleeps() const;
 
+    bool isThrottled() const;
+
     bool pastPeriod();
 
     void reset(double period = 0);
 
+    void restartPeriod();
+
+    void setSpinThreshold(double seconds);
+
+    void setThrottled(bool throttled);
+
     void sleep(bool update = true);
 
     static void threadSleepFor(double duration);    // Sleep the thread for a specified duration
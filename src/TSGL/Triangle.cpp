@@ -20,16 +20,15 @@ namespace tsgl {
  *      \param color The color of the Triangle.
  * \return A new Triangle with the specified vertices and color.
  */
-Triangle::Triangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3, float yaw, float pitch, float roll, ColorFloat color) : ConvexPolygon((x1 + x2 + x3) / 3, (y1 + y2 + y3) / 3, (z1 + z2 + z3) / 3, 3,yaw,pitch,roll) {
+Triangle::Triangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3, float yaw, float pitch, float roll, ColorFloat color) : ConvexPolygon((x1 + x2 + x3) / 3, (y1 + y2 + y3) / 3, (z1 + z2 + z3) / 3, 3,yaw,pitch,roll,myVertexStorage,myOutlineStorage) {
     float xAverage = (x1 + x2 + x3) / 3;
     float yAverage = (y1 + y2 + y3) / 3;
     float zAverage = (z1 + z2 + z3) / 3;
-    addVertex(x1 - xAverage, y1 - yAverage, z1 - zAverage, color);
-    addVertex(x2 - xAverage, y2 - yAverage, z2 - zAverage, color);
-    addVertex(x3 - xAverage, y3 - yAverage, z3 - zAverage, color);
-    addOutlineVertex(x1 - xAverage, y1 - yAverage, z1 - zAverage, GRAY);
-    addOutlineVertex(x2 - xAverage, y2 - yAverage, z2 - zAverage, GRAY);
-    addOutlineVertex(x3 - xAverage, y3 - yAverage, z3 - zAverage, GRAY);
+    GLfloat positions[9] = { x1 - xAverage, y1 - yAverage, z1 - zAverage,
+                             x2 - xAverage, y2 - yAverage, z2 - zAverage,
+                             x3 - xAverage, y3 - yAverage, z3 - zAverage };
+    addVertices(positions, 3, color);
+    addOutlineVertices(positions, 3, GRAY);
     geometryType = GL_TRIANGLES;
 }
 
@@ -51,16 +50,15 @@ Triangle::Triangle(float x1, float y1, float z1, float x2, float y2, float z2, f
  *      \param color An array of colors for the Triangle's vertices.
  * \return A new Triangle with the specified vertices and color.
  */
-Triangle::Triangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3, float yaw, float pitch, float roll,  ColorFloat color[]) : ConvexPolygon((x1 + x2 + x3) / 3, (y1 + y2 + y3) / 3, (z1 + z2 + z3) / 3, 3,yaw,pitch,roll) {
+Triangle::Triangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3, float yaw, float pitch, float roll,  ColorFloat color[]) : ConvexPolygon((x1 + x2 + x3) / 3, (y1 + y2 + y3) / 3, (z1 + z2 + z3) / 3, 3,yaw,pitch,roll,myVertexStorage,myOutlineStorage) {
     float xAverage = (x1 + x2 + x3) / 3;
     float yAverage = (y1 + y2 + y3) / 3;
     float zAverage = (z1 + z2 + z3) / 3;
-    addVertex(x1 - xAverage, y1 - yAverage, z1 - zAverage, color[0]);
-    addVertex(x2 - xAverage, y2 - yAverage, z2 - zAverage, color[1]);
-    addVertex(x3 - xAverage, y3 - yAverage, z3 - zAverage, color[2]);
-    addOutlineVertex(x1 - xAverage, y1 - yAverage, z1 - zAverage, GRAY);
-    addOutlineVertex(x2 - xAverage, y2 - yAverage, z2 - zAverage, GRAY);
-    addOutlineVertex(x3 - xAverage, y3 - yAverage, z3 - zAverage, GRAY);
+    GLfloat positions[9] = { x1 - xAverage, y1 - yAverage, z1 - zAverage,
+                             x2 - xAverage, y2 - yAverage, z2 - zAverage,
+                             x3 - xAverage, y3 - yAverage, z3 - zAverage };
+    addVertices(positions, 3, color);
+    addOutlineVertices(positions, 3, GRAY);
     geometryType = GL_TRIANGLES;
 }
 }
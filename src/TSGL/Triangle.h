@@ -15,7 +15,8 @@ namespace tsgl {
  */
 class Triangle : public ConvexPolygon {
  private:
- 
+    GLfloat myVertexStorage[3 * 7];         // Inline storage for the fill vertices
+    GLfloat myOutlineStorage[3 * 7];        // Inline storage for the outline vertices
  public:
     Triangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3, float yaw, float pitch, float roll, ColorFloat color);
 
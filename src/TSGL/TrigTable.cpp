@@ -0,0 +1,50 @@
+#include "TrigTable.h"
+
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace tsgl {
+
+namespace {
+    const double FULL_TURN = 6.28318530717958647692;
+
+    typedef std::map<int, std::vector<GLfloat> > tableMap;
+
+    // The tables are never destroyed, so that Shapes built by static objects can still use them on exit
+    std::mutex& tableMutex() {
+        static std::mutex* m = new std::mutex();
+        return *m;
+    }
+
+    tableMap& tables() {
+        static tableMap* t = new tableMap();
+        return *t;
+    }
+}
+
+/*!
+ * \brief Accessor for the points that divide the unit circle into equal segments.
+ *   \param segments The number of segments.
+ * \return An array of <code>segments + 1</code> (cosine, sine) pairs, for the angles
+ *   <code>2 * PI * i / segments</code> with <code>i</code> from 0 to <code>segments</code>. The last pair
+ *   repeats the first, so that a closed loop can be walked without wrapping the index.
+ *   The array stays valid for the rest of the program.
+ */
+const GLfloat* TrigTable::unitCircle(int segments) {
+    std::lock_guard<std::mutex> lock(tableMutex());
+    std::vector<GLfloat>& table = tables()[segments];
+    if (table.empty()) {
+      table.resize((segments + 1) * 2);
+      for (int i = 0; i < segments; ++i) {
+        table[i*2] = cos(FULL_TURN * i / segments);
+        table[i*2 + 1] = sin(FULL_TURN * i / segments);
+      }
+      table[segments*2] = table[0];
+      table[segments*2 + 1] = table[1];
+    }
+    return table.data();
+}
+
+}
@@ -0,0 +1,25 @@
+/*
+ * TrigTable.h provides cached sines and cosines of evenly spaced angles.
+ */
+
+#ifndef TRIGTABLE_H_
+#define TRIGTABLE_H_
+
+#include <GL/glew.h>     // Needed for GLfloat
+
+namespace tsgl {
+
+/*! \class TrigTable
+ *  \brief Cosines and sines of the angles that divide a circle into equal segments.
+ *  \details Shapes built from points around a circle (Circles, Spheres, Prisms, RegularPolygons, ...) look up
+ *    their points here rather than calling sin() and cos() for every vertex. Each table is computed once, the
+ *    first time any Shape asks for that number of segments, and kept for the rest of the program.
+ */
+class TrigTable {
+ public:
+    static const GLfloat* unitCircle(int segments);
+};
+
+}
+
+#endif /* TRIGTABLE_H_ */
@@ -32,6 +32,7 @@ const float FRAME = 1.0f/FPS;      // Number of seconds between frames
 const unsigned int TEXT_SHADER_TYPE = 0;
 const unsigned int SHAPE_SHADER_TYPE = 1;
 const unsigned int TEXTURE_SHADER_TYPE = 2;
+const unsigned int INSTANCE_SHADER_TYPE = 3;
 
 /*!
  * \var typedef long double Decimal
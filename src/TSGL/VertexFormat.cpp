@@ -0,0 +1,38 @@
+#include "VertexFormat.h"
+
+namespace tsgl {
+
+/*!
+ * \brief Points the shape shader's attributes at PackedVertex data in the bound GL_ARRAY_BUFFER.
+ *   \param posAttrib Location of the shader's position attribute.
+ *   \param colAttrib Location of the shader's color attribute.
+ */
+void VertexFormat::setLayout(GLint posAttrib, GLint colAttrib) {
+    glVertexAttribPointer(posAttrib, 3, GL_FLOAT, GL_FALSE, STRIDE, (void*)0);
+    glVertexAttribPointer(colAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, STRIDE, (void*)(3 * sizeof(GLfloat)));
+}
+
+/*!
+ * \brief Packs vertices, or the vertices at the given indices in order, into PackedVertex.
+ * \details Called whenever a Shape's vertices change, so that drawing it only binds the packed copy.
+ *   \param vertices Array of vertices of 7 floats each (x, y, z, r, g, b, a).
+ *   \param indices Array of <code>count</code> indices into <code>vertices</code>, or NULL to pack the first
+ *     <code>count</code> vertices in order.
+ *   \param count The number of vertices to pack.
+ *   \param out Array resized to <code>count</code> and filled with the packed vertices.
+ */
+void VertexFormat::pack(const GLfloat vertices[], const GLuint indices[], int count, std::vector<PackedVertex>& out) {
+    out.resize(count);
+    for (int i = 0; i < count; ++i) {
+      const GLfloat * v = vertices + (indices ? indices[i] : i)*7;
+      out[i].x = v[0];
+      out[i].y = v[1];
+      out[i].z = v[2];
+      out[i].color[0] = packChannel(v[3]);
+      out[i].color[1] = packChannel(v[4]);
+      out[i].color[2] = packChannel(v[5]);
+      out[i].color[3] = packChannel(v[6]);
+    }
+}
+
+}
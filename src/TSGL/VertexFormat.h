@@ -0,0 +1,69 @@
+/*
+ * VertexFormat.h provides the compact vertex layout uploaded to the GPU for Shapes.
+ */
+
+#ifndef VERTEXFORMAT_H_
+#define VERTEXFORMAT_H_
+
+#include <GL/glew.h>     // Needed for GL function calls
+#include "Color.h"       // Needed for color type
+#include <vector>        // For the packed copies Shapes keep
+
+namespace tsgl {
+
+/*! \struct PackedVertex
+ *  \brief A vertex as the shape shader reads it: a float position and an RGBA8 color, 16 bytes in all.
+ */
+struct PackedVertex {
+    GLfloat x, y, z;
+    GLubyte color[4];    // Red, green, blue and alpha, 0 to 255
+};
+
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex must be 16 bytes");
+
+/*! \class VertexFormat
+ *  \brief Converts Shapes' vertices to PackedVertex, and describes the layout to the shape shader.
+ *  \details Shapes keep their vertices as 7 floats (x, y, z, r, g, b, a) so that subclasses can edit them in place,
+ *    but pack() them into PackedVertex whenever they change, with the color normalized back to 0..1 by the GPU.
+ *    This cuts the bytes kept on the GPU per vertex from 28 to 16.
+ *  \details Anything that packs vertices for the shape shader must use pack(), and anything that sets up the
+ *    shape shader's attributes (Canvas, Background, ...) must use setLayout().
+ */
+class VertexFormat {
+ public:
+    static const GLsizei STRIDE = sizeof(PackedVertex);
+
+    /*!
+     * \brief Converts a color channel from 0..1 to 0..255, clamping values out of range.
+     */
+    static GLubyte packChannel(GLfloat c) {
+        return (GLubyte)(c <= 0.0f ? 0 : c >= 1.0f ? 255 : c * 255.0f + 0.5f);
+    }
+
+    /*!
+     * \brief Converts a color to RGBA8.
+     *   \param c The color to convert.
+     *   \param out Array of 4 bytes to write the red, green, blue and alpha channels to.
+     */
+    static void packColor(const ColorFloat& c, GLubyte out[4]) {
+        out[0] = packChannel(c.R);
+        out[1] = packChannel(c.G);
+        out[2] = packChannel(c.B);
+        out[3] = packChannel(c.A);
+    }
+
+    /*!
+     * \brief Converts an RGBA8 color back to a ColorFloat.
+     */
+    static ColorFloat unpackColor(const GLubyte c[4]) {
+        return ColorFloat(c[0] / 255.0f, c[1] / 255.0f, c[2] / 255.0f, c[3] / 255.0f);
+    }
+
+    static void setLayout(GLint posAttrib, GLint colAttrib);
+
+    static void pack(const GLfloat vertices[], const GLuint indices[], int count, std::vector<PackedVertex>& out);
+};
+
+}
+
+#endif /* VERTEXFORMAT_H_ */
@@ -0,0 +1,53 @@
+#include "VertexMailbox.h"
+
+#include <algorithm>
+
+namespace tsgl {
+
+/*!
+ * \brief Posts a range of vertices that changed, along with the length of the whole array.
+ * \details If the render thread has not received the last range yet, the two are merged; only the new range and
+ *   the gap between the two are copied.
+ *   \param source The writer's array, after the change.
+ *   \param first The index of the first changed vertex.
+ *   \param count The number of changed vertices.
+ * \note Calls must be serialized, usually by holding the lock that protects <code>source</code>.
+ */
+void VertexMailbox::post(const std::vector<PackedVertex>& source, size_t first, size_t count) {
+    Update * u = myMailbox.take();
+    if (!u) {
+      u = new Update;
+      u->first = first;
+      u->vertices.assign(source.begin() + first, source.begin() + first + count);
+    } else {
+      size_t oldEnd = u->first + u->vertices.size();
+      size_t begin = std::min(u->first, first), end = std::max(oldEnd, first + count);
+      if (begin < u->first)
+        u->vertices.insert(u->vertices.begin(), source.begin() + begin, source.begin() + u->first);
+      if (end > oldEnd)
+        u->vertices.insert(u->vertices.end(), source.begin() + oldEnd, source.begin() + end);
+      u->first = begin;
+      std::copy(source.begin() + first, source.begin() + first + count, u->vertices.begin() + (first - begin));
+    }
+    u->size = source.size();
+    myMailbox.post(u);
+}
+
+/*!
+ * \brief Applies the ranges posted since the last call to the render thread's copy of the array.
+ *   \param copy The render thread's copy, resized to the length of the writer's array.
+ *   \param buffer The GpuBuffer drawn from <code>copy</code>, in which the changed bytes are invalidated.
+ * \return True if anything was posted since the last call.
+ */
+bool VertexMailbox::receive(std::vector<PackedVertex>& copy, GpuBuffer& buffer) {
+    Update * u = myMailbox.take();
+    if (!u)
+      return false;
+    copy.resize(u->size);
+    std::copy(u->vertices.begin(), u->vertices.end(), copy.begin() + u->first);
+    buffer.invalidate(u->first * sizeof(PackedVertex), u->vertices.size() * sizeof(PackedVertex));
+    delete u;
+    return true;
+}
+
+}
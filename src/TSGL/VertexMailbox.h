@@ -0,0 +1,42 @@
+/*
+ * VertexMailbox.h provides a Mailbox for the ranges of a PackedVertex array that writers changed.
+ */
+
+#ifndef VERTEXMAILBOX_H_
+#define VERTEXMAILBOX_H_
+
+#include "GpuBuffer.h"     // For marking the changed ranges to upload
+#include "Mailbox.h"       // For handing the changes to the render thread
+#include "VertexFormat.h"  // For PackedVertex
+#include <cstddef>         // For size_t
+#include <vector>          // For the arrays
+
+namespace tsgl {
+
+/*! \class VertexMailbox
+ *  \brief Keeps the render thread's copy of a large PackedVertex array up to date, one changed range at a time.
+ *  \details Drawables such as LineSet and Mesh keep their vertices in an array that their mutators edit under
+ *    <code>attribMutex</code>. After each edit, the mutator post()s the range it changed. The render thread calls
+ *    receive() with its own copy of the array before drawing from it, without locking: the copy is brought up to
+ *    date, and the range that changed is marked for upload in the GpuBuffer drawn from it.
+ *  \details Ranges posted between two frames are merged into the smallest range covering them all, so each
+ *    receive() copies every changed vertex once.
+ */
+class VertexMailbox {
+ private:
+    struct Update {
+        size_t size;                            // Length of the whole array
+        size_t first;                           // Index of the first changed vertex
+        std::vector<PackedVertex> vertices;     // The changed vertices
+    };
+
+    Mailbox<Update> myMailbox;
+ public:
+    void post(const std::vector<PackedVertex>& source, size_t first, size_t count);
+
+    bool receive(std::vector<PackedVertex>& copy, GpuBuffer& buffer);
+};
+
+}
+
+#endif /* VERTEXMAILBOX_H_ */
@@ -0,0 +1,50 @@
+/*
+ * benchCapture.cpp
+ *
+ * Usage: ./benchCapture [--frames N] [--warmup N] [--width W] [--height H] [--out file.json]
+ */
+
+#include "benchmark.h"
+
+using namespace tsglbench;
+
+/*!
+ * \brief Measures how many frames per second the Canvas can capture to PNG files.
+ * \details
+ * - Draw a rotating square, first without capturing, then while recording every frame to ./capture/.
+ * - Record the time per frame in both cases.
+ * .
+ * \param can Reference to the Canvas being benchmarked.
+ */
+void benchCapture(Canvas& can, int argc, char* argv[]) {
+    Options opt(argc, argv);
+    Report report("capture", opt);
+    mkdir("capture", 0755);
+
+    Square * square = new Square(0, 0, 0, can.getWindowHeight() / 2, 0,0,0, Colors::highContrastColor(1));
+    can.add(square);
+
+    for (int record = 0; record < 2 && can.isOpen(); ++record) {
+      std::vector<double> samples = measureFrames(can, opt, [&](unsigned frame) {
+        if (record && frame == 0)
+          can.recordForNumFrames(opt.warmup + opt.frames + 1, "capture/frame");
+        square->setYaw(frame);
+      });
+      can.stopRecording();
+      Stats stats = summarize(samples);
+      std::vector<std::pair<std::string, double> > extra;
+      extra.push_back(std::make_pair("frames_per_second", (stats.median > 0) ? 1 / stats.median : 0));
+      report.add(record ? "capture" : "no capture", stats, extra);
+    }
+    can.remove(square);
+    delete square;
+    report.write();
+    can.close();
+}
+
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    Canvas c(-1, -1, opt.width, opt.height, "Capture Benchmark");
+    c.setThrottled(false);
+    c.run(benchCapture, argc, argv);
+}
@@ -0,0 +1,59 @@
+/*
+ * benchImage.cpp
+ *
+ * Usage: ./benchImage [--frames N] [--warmup N] [--width W] [--height H] [--out file.json] [--image file]
+ */
+
+#include "benchmark.h"
+
+using namespace tsglbench;
+
+/*!
+ * \brief Measures the cost of drawing (and uploading) an increasing number of Images per frame.
+ * \details
+ * - For 1, 4, 16, and 64 Images of the same file:
+ *   - Add that many Images to the Canvas, and move each of them slightly every frame.
+ *   - Record the time per frame (updates, texture uploads, and rendering).
+ *   .
+ * .
+ * \param can Reference to the Canvas being benchmarked.
+ */
+void benchImage(Canvas& can, int argc, char* argv[]) {
+    Options opt(argc, argv);
+    Report report("image", opt);
+    std::string file = "../../../assets/pics/Messier51.jpg";
+    for (int i = 1; i + 1 < argc; i += 2)
+      if (!strcmp(argv[i], "--image")) file = argv[i+1];
+    const int width = can.getWindowWidth(), height = can.getWindowHeight();
+    const unsigned counts[] = { 1, 4, 16, 64 };
+
+    for (unsigned c = 0; c < sizeof(counts) / sizeof(counts[0]) && can.isOpen(); ++c) {
+      std::vector<Image*> images;
+      for (unsigned i = 0; i < counts[c]; ++i) {
+        images.push_back(new Image(0, 0, 0, file, width/4, height/4, 0,0,0));
+        can.add(images.back());
+      }
+      std::vector<double> samples = measureFrames(can, opt, [&](unsigned frame) {
+        for (unsigned i = 0; i < images.size(); ++i)
+          images[i]->setCenterX((int)((frame + i * 7) % width) - width/2);
+      });
+      can.clearObjectBuffer();
+      for (unsigned i = 0; i < images.size(); ++i)
+        delete images[i];
+
+      Stats stats = summarize(samples);
+      std::vector<std::pair<std::string, double> > extra;
+      extra.push_back(std::make_pair("images", (double) counts[c]));
+      extra.push_back(std::make_pair("images_per_second", (stats.median > 0) ? counts[c] / stats.median : 0));
+      report.add("images=" + std::to_string(counts[c]), stats, extra);
+    }
+    report.write();
+    can.close();
+}
+
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    Canvas c(-1, -1, opt.width, opt.height, "Image Benchmark");
+    c.setThrottled(false);
+    c.run(benchImage, argc, argv);
+}
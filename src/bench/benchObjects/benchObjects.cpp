@@ -0,0 +1,83 @@
+/*
+ * benchObjects.cpp
+ *
+ * Usage: ./benchObjects [--frames N] [--warmup N] [--width W] [--height H] [--out file.json]
+ */
+
+#include "benchmark.h"
+
+using namespace tsglbench;
+
+const double FRAME_BUDGET = 1.0 / 60;   // Seconds per frame at 60 fps
+const unsigned MAX_OBJECTS = 1 << 17;   // Stop growing the scene past this many objects
+
+Drawable * makeShape(const std::string& type, float x, float y, float size, ColorFloat color) {
+    if (type == "rectangle") return new Rectangle(x, y, 0, size, size, 0,0,0, color);
+    if (type == "circle")    return new Circle(x, y, 0, size/2, 0,0,0, color);
+    if (type == "triangle")  return new Triangle(x-size/2, y-size/2, 0, x+size/2, y-size/2, 0, x, y+size/2, 0, 0,0,0, color);
+    if (type == "star")      return new Star(x, y, 0, size/2, 5, 0,0,0, color);
+    if (type == "cube")      return new Cube(x, y, 0, size, 0,0,0, color);
+    return new Sphere(x, y, 0, size/2, 0,0,0, color);
+}
+
+/*!
+ * \brief Measures how many objects of each shape type the Canvas can draw at 60 fps.
+ * \details
+ * - For each shape type, starting with 16 objects and doubling each time:
+ *   - Add that many randomly placed shapes to the Canvas and rotate all of them every frame.
+ *   - Record the time per frame (updates plus rendering).
+ *   - Stop once the median frame takes longer than 1/60th of a second.
+ *   .
+ * - The JSON report includes every measured scene size, and the largest one that fit in the frame budget.
+ * .
+ * \param can Reference to the Canvas being benchmarked.
+ */
+void benchObjects(Canvas& can, int argc, char* argv[]) {
+    Options opt(argc, argv);
+    Report report("objects", opt);
+    const int width = can.getWindowWidth(), height = can.getWindowHeight();
+    const char* types[] = { "rectangle", "circle", "triangle", "star", "cube", "sphere" };
+    srand(0);
+
+    for (unsigned t = 0; t < sizeof(types) / sizeof(types[0]) && can.isOpen(); ++t) {
+      std::string type = types[t];
+      unsigned best = 0;
+      Stats bestStats = summarize(std::vector<double>());
+      for (unsigned n = 16; n <= MAX_OBJECTS && can.isOpen(); n *= 2) {
+        std::vector<Drawable*> shapes;
+        for (unsigned i = 0; i < n; ++i) {
+          shapes.push_back(makeShape(type, rand() % width - width/2, rand() % height - height/2, 10,
+                                     Colors::highContrastColor(i)));
+          can.add(shapes.back());
+        }
+        std::vector<double> samples = measureFrames(can, opt, [&](unsigned frame) {
+          for (unsigned i = 0; i < shapes.size(); ++i)
+            shapes[i]->setYaw(frame);
+        });
+        can.clearObjectBuffer();
+        for (unsigned i = 0; i < shapes.size(); ++i)
+          delete shapes[i];
+
+        Stats stats = summarize(samples);
+        std::vector<std::pair<std::string, double> > extra;
+        extra.push_back(std::make_pair("objects", (double) n));
+        report.add(type + " x" + std::to_string(n), stats, extra);
+        if (stats.median > FRAME_BUDGET)
+          break;
+        best = n;
+        bestStats = stats;
+      }
+      std::vector<std::pair<std::string, double> > extra;
+      extra.push_back(std::make_pair("max_objects_at_60fps", (double) best));
+      report.add(type + " at 60fps", bestStats, extra);
+    }
+    report.write();
+    can.close();
+}
+
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    Canvas c(-1, -1, opt.width, opt.height, "Objects per Frame Benchmark");
+    c.setThrottled(false);
+    c.run(benchObjects, argc, argv);
+}
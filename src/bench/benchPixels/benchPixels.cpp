@@ -0,0 +1,62 @@
+/*
+ * benchPixels.cpp
+ *
+ * Usage: ./benchPixels [--frames N] [--warmup N] [--width W] [--height H] [--out file.json]
+ */
+
+#include "benchmark.h"
+
+using namespace tsglbench;
+
+/*!
+ * \brief Measures how fast the Background's pixel buffer can be filled, for an increasing number of threads.
+ * \details
+ * - For 1, 2, 4, ... threads, up to the number of processors:
+ *   - Each frame, every thread overwrites its own vertical band of the Canvas with drawPixel().
+ *   - The time per frame (pixel writes plus rendering) is recorded.
+ *   .
+ * - The JSON report includes the resulting pixel throughput.
+ * .
+ * \param can Reference to the Canvas being benchmarked.
+ */
+void benchPixels(Canvas& can, int argc, char* argv[]) {
+    Options opt(argc, argv);
+    Report report("pixels", opt);
+    Background * background = can.getBackground();
+    const int width = can.getWindowWidth(), height = can.getWindowHeight();
+
+    std::vector<int> threadCounts;
+    for (int t = 1; t < omp_get_num_procs(); t *= 2)
+      threadCounts.push_back(t);
+    threadCounts.push_back(omp_get_num_procs());
+
+    for (unsigned c = 0; c < threadCounts.size() && can.isOpen(); ++c) {
+      int threads = threadCounts[c];
+      std::vector<double> samples = measureFrames(can, opt, [&](unsigned frame) {
+        #pragma omp parallel num_threads(threads)
+        {
+          int tid = omp_get_thread_num(), nthreads = omp_get_num_threads();
+          int bstart = tid * width / nthreads - width/2;
+          int bend = (tid + 1) * width / nthreads - width/2;
+          ColorInt color(frame % 256, (tid * 64) % 256, 128);
+          for (int i = bstart; i < bend; i++)
+            for (int j = -height/2; j < height/2; j++)
+              background->drawPixel(i, j, color);
+        }
+      });
+      Stats stats = summarize(samples);
+      std::vector<std::pair<std::string, double> > extra;
+      extra.push_back(std::make_pair("threads", (double) threads));
+      extra.push_back(std::make_pair("pixels_per_second", (stats.median > 0) ? width * height / stats.median : 0));
+      report.add("threads=" + std::to_string(threads), stats, extra);
+    }
+    report.write();
+    can.close();
+}
+
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    Canvas c(-1, -1, opt.width, opt.height, "Pixel Throughput Benchmark");
+    c.setThrottled(false);
+    c.run(benchPixels, argc, argv);
+}
@@ -0,0 +1,63 @@
+/*
+ * benchProcedural.cpp
+ *
+ * Usage: ./benchProcedural [--frames N] [--warmup N] [--width W] [--height H] [--out file.json]
+ */
+
+#include "benchmark.h"
+
+using namespace tsglbench;
+
+const unsigned PRIMITIVES_PER_FRAME = 500;
+
+/*!
+ * \brief Measures how many procedural primitives per second the Background can draw.
+ * \details
+ * - For each kind of primitive (circles, rectangles, triangles, and lines):
+ *   - Each frame, draw PRIMITIVES_PER_FRAME of them onto the Background at random positions.
+ *   - Record the time per frame (procedural calls plus rendering).
+ *   .
+ * - The JSON report includes the resulting primitives per second.
+ * .
+ * \param can Reference to the Canvas being benchmarked.
+ */
+void benchProcedural(Canvas& can, int argc, char* argv[]) {
+    Options opt(argc, argv);
+    Report report("procedural", opt);
+    Background * bg = can.getBackground();
+    const int width = can.getWindowWidth(), height = can.getWindowHeight();
+    const char* kinds[] = { "circle", "rectangle", "triangle", "line" };
+    srand(0);
+
+    for (unsigned k = 0; k < sizeof(kinds) / sizeof(kinds[0]) && can.isOpen(); ++k) {
+      std::string kind = kinds[k];
+      std::vector<double> samples = measureFrames(can, opt, [&](unsigned frame) {
+        for (unsigned i = 0; i < PRIMITIVES_PER_FRAME; ++i) {
+          float x = rand() % width - width/2, y = rand() % height - height/2;
+          ColorFloat color = Colors::highContrastColor(i + frame);
+          if (kind == "circle")
+            bg->drawCircle(x, y, 0, 8, 0,0,0, color);
+          else if (kind == "rectangle")
+            bg->drawRectangle(x, y, 0, 16, 12, 0,0,0, color);
+          else if (kind == "triangle")
+            bg->drawTriangle(x-8, y-8, 0, x+8, y-8, 0, x, y+8, 0, 0,0,0, color);
+          else
+            bg->drawLine(x, y, 0, 20, frame, 0,0, color);
+        }
+      });
+      Stats stats = summarize(samples);
+      std::vector<std::pair<std::string, double> > extra;
+      extra.push_back(std::make_pair("per_frame", (double) PRIMITIVES_PER_FRAME));
+      extra.push_back(std::make_pair("primitives_per_second", (stats.median > 0) ? PRIMITIVES_PER_FRAME / stats.median : 0));
+      report.add(kind, stats, extra);
+    }
+    report.write();
+    can.close();
+}
+
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    Canvas c(-1, -1, opt.width, opt.height, "Procedural Background Benchmark");
+    c.setThrottled(false);
+    c.run(benchProcedural, argc, argv);
+}
@@ -0,0 +1,60 @@
+/*
+ * benchText.cpp
+ *
+ * Usage: ./benchText [--frames N] [--warmup N] [--width W] [--height H] [--out file.json] [--font file.ttf]
+ */
+
+#include "benchmark.h"
+
+using namespace tsglbench;
+
+/*!
+ * \brief Measures the cost of drawing an increasing number of Text strings per frame.
+ * \details
+ * - For 1, 10, 100, and 1000 strings:
+ *   - Create that many Text objects, and change every string each frame.
+ *   - Record the time per frame (text updates plus rendering).
+ *   .
+ * .
+ * \param can Reference to the Canvas being benchmarked.
+ */
+void benchText(Canvas& can, int argc, char* argv[]) {
+    Options opt(argc, argv);
+    Report report("text", opt);
+    std::string font = FONT;
+    for (int i = 1; i + 1 < argc; i += 2)
+      if (!strcmp(argv[i], "--font")) font = argv[i+1];
+    const int width = can.getWindowWidth(), height = can.getWindowHeight();
+    const unsigned counts[] = { 1, 10, 100, 1000 };
+    srand(0);
+
+    for (unsigned c = 0; c < sizeof(counts) / sizeof(counts[0]) && can.isOpen(); ++c) {
+      std::vector<Text*> strings;
+      for (unsigned i = 0; i < counts[c]; ++i) {
+        strings.push_back(new Text(rand() % width - width/2, rand() % height - height/2, 0, L"TSGL 0000",
+                                   font, 16, 0,0,0, Colors::highContrastColor(i)));
+        can.add(strings.back());
+      }
+      std::vector<double> samples = measureFrames(can, opt, [&](unsigned frame) {
+        std::wstring text = L"TSGL " + std::to_wstring(frame % 10000);
+        for (unsigned i = 0; i < strings.size(); ++i)
+          strings[i]->setText(text);
+      });
+      can.clearObjectBuffer();
+      for (unsigned i = 0; i < strings.size(); ++i)
+        delete strings[i];
+
+      std::vector<std::pair<std::string, double> > extra;
+      extra.push_back(std::make_pair("strings", (double) counts[c]));
+      report.add("strings=" + std::to_string(counts[c]), summarize(samples), extra);
+    }
+    report.write();
+    can.close();
+}
+
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    Canvas c(-1, -1, opt.width, opt.height, "Text Benchmark");
+    c.setThrottled(false);
+    c.run(benchText, argc, argv);
+}
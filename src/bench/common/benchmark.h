@@ -0,0 +1,193 @@
+/*
+ * benchmark.h provides the command line handling, frame timing, statistics, and JSON output
+ * shared by the TSGL benchmarks.
+ */
+
+#ifndef TSGL_BENCHMARK_H_
+#define TSGL_BENCHMARK_H_
+
+#include <tsgl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tsglbench {
+
+using namespace tsgl;
+
+typedef std::chrono::steady_clock benchClock;
+
+/*!
+ * \brief Settings shared by every benchmark.
+ * \details Parsed from <code>--frames N --warmup N --width W --height H --out file.json</code>.
+ */
+struct Options {
+    unsigned    frames;     // Frames measured per case
+    unsigned    warmup;     // Frames run (and discarded) before each case
+    int         width;
+    int         height;
+    std::string out;        // File to write the JSON report to ("" for stdout)
+
+    Options(int argc, char* argv[]) : frames(240), warmup(30), width(800), height(600) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            if (!strcmp(argv[i], "--frames"))      frames = atoi(argv[i+1]);
+            else if (!strcmp(argv[i], "--warmup")) warmup = atoi(argv[i+1]);
+            else if (!strcmp(argv[i], "--width"))  width = atoi(argv[i+1]);
+            else if (!strcmp(argv[i], "--height")) height = atoi(argv[i+1]);
+            else if (!strcmp(argv[i], "--out"))    out = argv[i+1];
+        }
+        if (frames == 0) frames = 1;
+    }
+};
+
+/*!
+ * \brief Summary statistics of a set of samples.
+ */
+struct Stats {
+    unsigned samples;
+    double   median, p95, mean, stddev, min, max;
+};
+
+inline Stats summarize(std::vector<double> samples) {
+    Stats s = {0, 0, 0, 0, 0, 0, 0};
+    if (samples.empty())
+      return s;
+    std::sort(samples.begin(), samples.end());
+    unsigned n = samples.size();
+    double total = 0;
+    for (unsigned i = 0; i < n; ++i)
+      total += samples[i];
+    s.samples = n;
+    s.mean = total / n;
+    s.median = (n % 2) ? samples[n/2] : (samples[n/2 - 1] + samples[n/2]) / 2;
+    s.p95 = samples[(n - 1) * 95 / 100];
+    s.min = samples[0];
+    s.max = samples[n - 1];
+    double var = 0;
+    for (unsigned i = 0; i < n; ++i)
+      var += (samples[i] - s.mean) * (samples[i] - s.mean);
+    s.stddev = (n > 1) ? std::sqrt(var / (n - 1)) : 0;
+    return s;
+}
+
+/*!
+ * \brief Blocks until the Canvas has drawn a new frame.
+ * \details The Canvas is marked dirty first, so that the frame is rendered even if the benchmark
+ *   did not modify anything the Canvas can see. The frame waited for starts after this call, so it
+ *   shows everything the benchmark changed; idle cycles of the rendering thread are not counted.
+ */
+inline void waitForFrame(Canvas& can) {
+    while (can.isOpen() && !can.waitForRedraw(0.1))
+      ;
+}
+
+/*!
+ * \brief Escapes a string for use inside quotes in the JSON report.
+ */
+inline std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (unsigned i = 0; i < text.size(); ++i) {
+      char c = text[i];
+      if (c == '"' || c == '\\') {
+        escaped += '\\';
+        escaped += c;
+      } else if ((unsigned char) c < 0x20) {
+        char code[8];
+        snprintf(code, sizeof(code), "\\u%04x", c);
+        escaped += code;
+      } else {
+        escaped += c;
+      }
+    }
+    return escaped;
+}
+
+/*!
+ * \brief Runs a benchmark case for a fixed number of frames.
+ * \details Calls <code>step(frame)</code> once per frame, waits for the Canvas to draw, and records the
+ *   wall-clock time of each frame (work plus rendering) in seconds.
+ */
+template <typename Step>
+std::vector<double> measureFrames(Canvas& can, const Options& opt, Step step) {
+    for (unsigned i = 0; i < opt.warmup && can.isOpen(); ++i) {
+      step(i);
+      waitForFrame(can);
+    }
+    std::vector<double> samples;
+    samples.reserve(opt.frames);
+    benchClock::time_point last = benchClock::now();
+    for (unsigned i = 0; i < opt.frames && can.isOpen(); ++i) {
+      step(opt.warmup + i);
+      waitForFrame(can);
+      benchClock::time_point now = benchClock::now();
+      samples.push_back(std::chrono::duration<double>(now - last).count());
+      last = now;
+    }
+    return samples;
+}
+
+/*!
+ * \brief Collects the results of a benchmark and writes them out as JSON.
+ */
+class Report {
+ private:
+    std::string name;
+    const Options& opt;
+    std::vector<std::string> results;
+ public:
+    Report(const std::string& benchmark, const Options& options) : name(benchmark), opt(options) {}
+
+    /*!
+     * \brief Adds a case to the report.
+     *   \param label Name of the case.
+     *   \param stats Frame time statistics, in seconds (reported in milliseconds).
+     *   \param extra Additional numeric fields, such as the parameters of the case or a throughput.
+     */
+    void add(const std::string& label, const Stats& stats,
+             const std::vector<std::pair<std::string, double> >& extra = std::vector<std::pair<std::string, double> >()) {
+        std::ostringstream o;
+        o.precision(6);
+        o << "    {\"case\": \"" << jsonEscape(label) << "\", \"samples\": " << stats.samples
+          << ", \"median_ms\": " << stats.median * 1000 << ", \"p95_ms\": " << stats.p95 * 1000
+          << ", \"stddev_ms\": " << stats.stddev * 1000 << ", \"mean_ms\": " << stats.mean * 1000
+          << ", \"min_ms\": " << stats.min * 1000 << ", \"max_ms\": " << stats.max * 1000;
+        for (unsigned i = 0; i < extra.size(); ++i)
+          o << ", \"" << jsonEscape(extra[i].first) << "\": " << extra[i].second;
+        o << "}";
+        results.push_back(o.str());
+        std::cerr << name << ": " << label << " median " << stats.median * 1000 << " ms" << std::endl;
+    }
+
+    void write() const {
+        std::ostringstream o;
+        o << "{\n  \"benchmark\": \"" << jsonEscape(name) << "\",\n  \"frames\": " << opt.frames
+          << ",\n  \"warmup\": " << opt.warmup << ",\n  \"width\": " << opt.width
+          << ",\n  \"height\": " << opt.height << ",\n  \"threads\": " << omp_get_num_procs()
+          << ",\n  \"results\": [\n";
+        for (unsigned i = 0; i < results.size(); ++i)
+          o << results[i] << ((i + 1 < results.size()) ? ",\n" : "\n");
+        o << "  ]\n}\n";
+        if (opt.out.empty()) {
+          std::cout << o.str();
+        } else {
+          std::ofstream file(opt.out.c_str());
+          file << o.str();
+        }
+    }
+};
+
+}
+
+#endif /* TSGL_BENCHMARK_H_ */
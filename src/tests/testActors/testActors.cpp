@@ -0,0 +1,61 @@
+/*
+ * testActors.cpp
+ *
+ * Usage: ./testActors <numActors>
+ */
+
+#include <tsgl.h>
+#include <iostream>
+#include <random>
+
+using namespace tsgl;
+
+#ifdef TSGL_HAS_ACTORS
+
+// A dot that glides to random spots, resting for a while at each
+Actor wanderer(Circle * dot, unsigned seed) {
+    std::minstd_rand random(seed);
+    std::uniform_real_distribution<float> x(-500, 500), y(-300, 300), rest(0.2f, 2.0f);
+    while (true) {
+        float fromX = dot->getCenterX(), fromY = dot->getCenterY();
+        float toX = x(random), toY = y(random);
+        for (int step = 1; step <= 60; step++) {
+            float u = step / 60.0f;
+            dot->setCenter(fromX + (toX - fromX) * u, fromY + (toY - fromY) * u, 0);
+            co_await nextFrame();
+        }
+        co_await delay(rest(random));
+    }
+}
+
+void actorFunction(Canvas& can, int numActors) {
+    std::vector<Circle*> dots(numActors);
+    ActorScheduler scheduler;
+    for (int i = 0; i < numActors; i++) {
+        dots[i] = new Circle(0, 0, 0, 2, 0, 0, 0, ColorHSV(6.0f * i / numActors, 1, 1));
+        can.add(dots[i]);
+        scheduler.spawn(wanderer(dots[i], i + 1));
+    }
+    scheduler.attach(can);
+
+    while (can.isOpen())
+        can.sleep();
+
+    scheduler.detach();
+    for (int i = 0; i < numActors; i++)
+        delete dots[i];
+}
+
+int main(int argc, char* argv[]) {
+    int numActors = (argc > 1) ? atoi(argv[1]) : 20000;
+    Canvas c(-1, -1, 1024, 620, "Coroutine Actors", BLACK);
+    c.run(actorFunction, numActors);
+}
+
+#else
+
+int main(int argc, char* argv[]) {
+    std::cout << "testActors needs a compiler with C++20 coroutines" << std::endl;
+}
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ * testAnimation.cpp
+ *
+ * Usage: ./testAnimation
+ */
+
+#include <tsgl.h>
+
+using namespace tsgl;
+
+// Circles sliding back and forth with each easing curve, and a Square that spins and fades, all animated by the
+// render thread while this thread only waits
+void animationFunction(Canvas& can) {
+    const int CURVES = 6;
+    Keyframe curves[CURVES][3] = {
+        { Keyframe(0, -400), Keyframe(2, 400, EASE_LINEAR), Keyframe(4, -400, EASE_LINEAR) },
+        { Keyframe(0, -400), Keyframe(2, 400, EASE_IN), Keyframe(4, -400, EASE_IN) },
+        { Keyframe(0, -400), Keyframe(2, 400, EASE_OUT), Keyframe(4, -400, EASE_OUT) },
+        { Keyframe(0, -400), Keyframe(2, 400, EASE_IN_OUT), Keyframe(4, -400, EASE_IN_OUT) },
+        { Keyframe(0, -400), Keyframe(2, 400, 0.68, -0.55, 0.27, 1.55), Keyframe(4, -400, 0.68, -0.55, 0.27, 1.55) },
+        { Keyframe(0, -400), Keyframe(2, 400, EASE_STEP), Keyframe(4, -400, EASE_STEP) }
+    };
+    Circle * circles[CURVES];
+    for (int i = 0; i < CURVES; i++) {
+        circles[i] = new Circle(-400, 250 - 60 * i, 0, 20, 0, 0, 0, Colors::highContrastColor(i));
+        can.animate(can.add(circles[i]), ANIMATE_X, curves[i], 3, true);
+    }
+
+    Square * square = new Square(0, -200, 0, 100, 0, 0, 0, WHITE);
+    Keyframe spin[] = { Keyframe(0, 0), Keyframe(3, 360) };
+    Keyframe fade[] = { Keyframe(0, 1), Keyframe(1.5, 0.2, EASE_IN_OUT), Keyframe(3, 1, EASE_IN_OUT) };
+    Keyframe drop[] = { Keyframe(0, 0), Keyframe(1, -100, EASE_IN) };
+    Handle h = can.add(square);
+    can.animate(h, ANIMATE_YAW, spin, 2, true);
+    can.animate(h, ANIMATE_ALPHA, fade, 3, true);
+    can.animate(h, ANIMATE_Z, drop, 2);
+
+    can.wait();
+
+    can.clearObjectBuffer(true);
+}
+
+int main(int argc, char* argv[]) {
+    Canvas c(-1, -1, 1024, 620, "Keyframe animation", BLACK);
+    c.run(animationFunction);
+}
@@ -0,0 +1,48 @@
+/*
+ * testBulkUpdate.cpp
+ *
+ * Usage: ./testBulkUpdate <numAgents>
+ */
+
+#include <tsgl.h>
+#include <cmath>
+#include <vector>
+
+using namespace tsgl;
+
+// Agents circling the origin, all moved and turned with one Canvas::setPoses() call per frame
+void bulkUpdateFunction(Canvas& can, int n) {
+    std::vector<Drawable*> agents(n);
+    std::vector<Pose> poses(n);
+    std::vector<float> radii(n), angles(n);
+    for (int i = 0; i < n; i++) {
+        radii[i] = 20 + rand() % 280;
+        angles[i] = 2 * PI * rand() / RAND_MAX;
+        agents[i] = new Triangle(6, 0, 0, -4, 3, 0, -4, -3, 0, 0, 0, 0, Colors::randomColor(1));
+        can.add(agents[i]);
+    }
+
+    while (can.isOpen()) {
+        can.sleep();
+        #pragma omp parallel for
+        for (int i = 0; i < n; i++) {
+            angles[i] += 20 / radii[i] * FRAME;
+            poses[i].x = radii[i] * cos(angles[i]);
+            poses[i].y = radii[i] * sin(angles[i]);
+            poses[i].z = 0;
+            poses[i].yaw = angles[i] / PI * 180 + 90;
+            poses[i].pitch = poses[i].roll = 0;
+        }
+        can.setPoses(agents.data(), poses.data(), n);
+    }
+
+    for (int i = 0; i < n; i++)
+        delete agents[i];
+}
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : 50000;
+    if (n <= 0) n = 50000;
+    Canvas c(-1, -1, 1024, 620, "Bulk pose updates", BLACK);
+    c.run(bulkUpdateFunction, n);
+}
@@ -0,0 +1,68 @@
+/*
+ * testDrawableStore.cpp
+ *
+ * Usage: ./testDrawableStore <numInstances>
+ */
+
+#include <tsgl.h>
+#include <cmath>
+#include <vector>
+
+using namespace tsgl;
+
+// A swarm of triangles and squares bouncing around the window, moved in parallel straight in the store's arrays.
+// Every frame a few instances are despawned and respawned to exercise the handles.
+void drawableStoreFunction(Canvas& can, int n) {
+    const GLfloat triangle[] = { -4, -3, 0,   4, -3, 0,   0, 5, 0 };
+    const GLfloat square[] = { -3, -3, 0,   3, -3, 0,   3, 3, 0,   -3, -3, 0,   3, 3, 0,   -3, 3, 0 };
+    DrawableStore * store = new DrawableStore(0, 0, 0, 0, 0, 0);
+    int meshes[2] = { store->addMesh(3, triangle), store->addMesh(6, square) };
+
+    std::vector<Handle> handles(n);
+    for (int i = 0; i < n; i++) {
+        handles[i] = store->add(meshes[i % 2], rand() % 1000 - 500, rand() % 600 - 300, 0, Colors::randomColor(1));
+    }
+    // Velocities follow the instances around the arrays by handle
+    std::vector<GLfloat> vx(n), vy(n);
+    for (int i = 0; i < n; i++) {
+        vx[i] = (rand() % 200 - 100) / 50.0f;
+        vy[i] = (rand() % 200 - 100) / 50.0f;
+    }
+    can.add(store);
+
+    std::vector<unsigned> slots;
+    while (can.isOpen()) {
+        can.sleep();
+        store->beginUpdate();
+        unsigned size = store->getSize();
+        slots.resize(size);
+        for (unsigned i = 0; i < size; i++)
+            slots[i] = store->handleAt(i).slot;   // Handles are issued from slots 0 to n - 1
+        GLfloat * xs = store->getXs(), * ys = store->getYs(), * yaws = store->getYaws();
+        #pragma omp parallel for simd
+        for (unsigned i = 0; i < size; i++) {
+            unsigned s = slots[i];
+            xs[i] += vx[s];
+            ys[i] += vy[s];
+            if (xs[i] < -500 || xs[i] > 500) vx[s] = -vx[s];
+            if (ys[i] < -300 || ys[i] > 300) vy[s] = -vy[s];
+            yaws[i] += 2;
+        }
+        store->endUpdate(DrawableStore::X | DrawableStore::Y | DrawableStore::YAW);
+
+        for (int k = 0; k < 20; k++) {
+            int i = rand() % n;
+            store->remove(handles[i]);
+            handles[i] = store->add(meshes[rand() % 2], rand() % 1000 - 500, rand() % 600 - 300, 0, Colors::randomColor(1));
+        }
+    }
+
+    delete store;
+}
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : 200000;
+    if (n <= 0) n = 200000;
+    Canvas c(-1, -1, 1024, 620, "DrawableStore swarm", BLACK);
+    c.run(drawableStoreFunction, n);
+}
@@ -0,0 +1,51 @@
+/*
+ * testEmplace.cpp
+ *
+ * Usage: ./testEmplace <sparksPerFrame>
+ */
+
+#include <tsgl.h>
+#include <cmath>
+#include <deque>
+
+using namespace tsgl;
+
+struct Spark {
+    Handle handle;
+    float vx, vy;
+    int age;
+};
+
+// Sparks spawned at the center and despawned after a second, made in the Canvas's pooled storage with emplace()
+void emplaceFunction(Canvas& can, int perFrame) {
+    const int LIFETIME = 60;
+    std::deque<Spark> sparks;
+    while (can.isOpen()) {
+        can.sleep();
+        for (int i = 0; i < perFrame; i++) {
+            float angle = 2 * PI * rand() / RAND_MAX, speed = 1 + 4.0f * rand() / RAND_MAX;
+            Spark s;
+            s.handle = can.emplace<Circle>(0, 0, 0, 2, 0, 0, 0, Colors::randomColor(1));
+            s.vx = speed * cos(angle);
+            s.vy = speed * sin(angle);
+            s.age = 0;
+            sparks.push_back(s);
+        }
+        while (!sparks.empty() && sparks.front().age >= LIFETIME) {
+            can.remove(sparks.front().handle);
+            sparks.pop_front();
+        }
+        for (unsigned i = 0; i < sparks.size(); i++) {
+            Circle * c = can.get<Circle>(sparks[i].handle);
+            c->changeCenterBy(sparks[i].vx, sparks[i].vy, 0);
+            sparks[i].age++;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : 200;
+    if (n <= 0) n = 200;
+    Canvas c(-1, -1, 1024, 620, "Spawning with emplace()", BLACK);
+    c.run(emplaceFunction, n);
+}
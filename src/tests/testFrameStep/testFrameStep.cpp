@@ -0,0 +1,43 @@
+/*
+ * testFrameStep.cpp
+ *
+ * Usage: ./testFrameStep <numDots>
+ */
+
+#include <tsgl.h>
+#include <vector>
+
+using namespace tsgl;
+
+// Dots orbiting the center, moved on the TaskPool while the previous frame is shown
+void frameStepFunction(Canvas& can, int numDots) {
+    std::vector<Circle*> dots(numDots);
+    for (int i = 0; i < numDots; i++) {
+        dots[i] = new Circle(0, 0, 0, 3, 0, 0, 0, ColorHSV(6.0f * i / numDots, 1, 1));
+        can.add(dots[i]);
+    }
+
+    can.setFrameStep([&dots, numDots](int frame) {
+        float t = frame * FRAME;
+        TaskPool::global().parallelFor(0, numDots, [&dots, numDots, t](int first, int last) {
+            for (int i = first; i < last; i++) {
+                float radius = 20 + 280.0f * i / numDots;
+                float angle = t * 300 / radius + i * 0.5f;
+                dots[i]->setCenter(radius * cos(angle), radius * sin(angle), 0);
+            }
+        });
+    });
+
+    while (can.isOpen())
+        can.sleep();
+
+    can.setFrameStep(nullptr);
+    for (int i = 0; i < numDots; i++)
+        delete dots[i];
+}
+
+int main(int argc, char* argv[]) {
+    int numDots = (argc > 1) ? atoi(argv[1]) : 5000;
+    Canvas c(-1, -1, 1024, 620, "Frame Steps on the Task Pool", BLACK);
+    c.run(frameStepFunction, numDots);
+}
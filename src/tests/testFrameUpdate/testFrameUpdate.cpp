@@ -0,0 +1,44 @@
+/*
+ * testFrameUpdate.cpp
+ *
+ * Usage: ./testFrameUpdate <numThreads>
+ */
+
+#include <omp.h>
+#include <tsgl.h>
+
+using namespace tsgl;
+
+// Threads each move their share of a row of bars into a sine wave; every frame shows a whole wave
+void frameUpdateFunction(Canvas& can, int threads) {
+    const int BARS = 120;
+    const float WIDTH = 1000.0f / BARS;
+    Rectangle * bars[BARS];
+    for (int i = 0; i < BARS; i++) {
+        bars[i] = new Rectangle(-500 + WIDTH * (i + 0.5f), 0, 0, WIDTH - 1, 1, 0, 0, 0, ColorHSV(6.0f * i / BARS, 1, 1));
+        can.add(bars[i]);
+    }
+
+    float t = 0;
+    while (can.isOpen()) {
+        can.sleep();
+        t += FRAME;
+        FrameUpdate update(can);                     // The workers' transactions join this one
+        #pragma omp parallel num_threads(threads)
+        {
+            FrameUpdate share(can);
+            int id = omp_get_thread_num(), n = omp_get_num_threads();
+            for (int i = id; i < BARS; i += n)
+                bars[i]->setHeight(1 + 250 * (1 + sin(t * 3 + i * 0.1f)));
+        }
+    }
+
+    for (int i = 0; i < BARS; i++)
+        delete bars[i];
+}
+
+int main(int argc, char* argv[]) {
+    int threads = (argc > 1) ? atoi(argv[1]) : omp_get_num_procs();
+    Canvas c(-1, -1, 1024, 620, "Frame Update Transactions", BLACK);
+    c.run(frameUpdateFunction, threads);
+}
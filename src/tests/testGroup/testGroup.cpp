@@ -0,0 +1,53 @@
+/*
+ * testGroup.cpp
+ *
+ * Usage: ./testGroup
+ */
+
+#include <tsgl.h>
+
+using namespace tsgl;
+
+// A windmill built from a Group of Shapes, with its sails in a nested Group
+void groupFunction(Canvas& can) {
+    Group * mill = new Group(0, -50, 0, 0, 0, 0);
+    Group * sails = new Group(0, 100, 1, 0, 0, 0);
+    Rectangle * tower = new Rectangle(0, 0, 0, 60, 200, 0, 0, 0, ColorFloat(0.6, 0.4, 0.2, 1));
+    Triangle * roof = new Triangle(-40, 100, 0, 40, 100, 0, 0, 150, 0, 0, 0, 0, RED);
+    Circle * hub = new Circle(0, 0, 1, 10, 0, 0, 0, GRAY);
+    Rectangle * blades[4];
+    for (int i = 0; i < 4; i++) {
+        blades[i] = new Rectangle(0, 60, 0, 20, 100, 0, 0, 0, WHITE);
+        blades[i]->setRotationPoint(0, 0, 0);
+        blades[i]->setYaw(90 * i);
+        sails->add(blades[i]);
+    }
+    sails->add(hub);
+    mill->add(tower);
+    mill->add(roof);
+    mill->add(sails);
+    can.add(mill);
+
+    float t = 0;
+    while (can.isOpen()) {
+        can.sleep();
+        t += FRAME;
+        sails->changeYawBy(2);
+        mill->setCenterX(200 * sin(t / 2));
+        mill->setPitch(30 * sin(t));
+    }
+
+    can.remove(mill);
+    delete mill;
+    delete sails;
+    delete tower;
+    delete roof;
+    delete hub;
+    for (int i = 0; i < 4; i++)
+        delete blades[i];
+}
+
+int main(int argc, char* argv[]) {
+    Canvas c(-1, -1, 1024, 620, "Groups", BLACK);
+    c.run(groupFunction);
+}
@@ -0,0 +1,72 @@
+/*
+ * testGroupBatch.cpp
+ *
+ * Usage: ./testGroupBatch
+ */
+
+#include <tsgl.h>
+#include <atomic>
+
+using namespace tsgl;
+
+// A Square that counts how often a Group transforms it into its batch
+class CountingSquare : public Square {
+ public:
+    std::atomic<int> appends{0};
+
+    CountingSquare(float x, float y, float side, ColorFloat color) : Square(x, y, 0, side, 0, 0, 0, color) { }
+
+    virtual bool appendBatch(std::vector<PackedVertex>& out, std::vector<BatchRange>& ranges) {
+        appends++;
+        return Square::appendBatch(out, ranges);
+    }
+};
+
+// Moves the Group for a number of frames, so that it is redrawn without its children changing
+void moveGroup(Canvas& can, Group * group, int frames) {
+    for (int i = 0; i < frames && can.isOpen(); i++) {
+        group->changeXBy(1);
+        can.sleep();
+    }
+}
+
+// An unchanged child must not be transformed again when the Group moves
+bool testUnchangedChild(Canvas& can, Group * group, CountingSquare * still) {
+    int before = still->appends.load();
+    moveGroup(can, group, 30);
+    return still->appends.load() == before;
+}
+
+// A changed child must be transformed again, once per change
+bool testChangedChild(Canvas& can, Group * group, CountingSquare * moving, CountingSquare * still) {
+    int movingBefore = moving->appends.load(), stillBefore = still->appends.load();
+    moving->changeYBy(50);
+    moveGroup(can, group, 30);
+    return moving->appends.load() == movingBefore + 1 && still->appends.load() == stillBefore;
+}
+
+void groupBatchFunction(Canvas& can) {
+    Group * group = new Group(0, 0, 0, 0, 0, 0);
+    CountingSquare * still = new CountingSquare(-100, 0, 80, RED);
+    CountingSquare * moving = new CountingSquare(100, 0, 80, BLUE);
+    group->add(still);
+    group->add(moving);
+    can.add(group);
+    moveGroup(can, group, 10);                       // Let the batch be built
+
+    tsglAssert(testUnchangedChild(can, group, still), "Unit test for unchanged Group children failed!");
+    tsglAssert(testChangedChild(can, group, moving, still), "Unit test for changed Group children failed!");
+    std::cout << "Group batch tests done; still appended " << still->appends.load()
+              << " time(s), moving " << moving->appends.load() << " time(s)" << std::endl;
+
+    can.close();
+    can.remove(group);
+    delete group;
+    delete still;
+    delete moving;
+}
+
+int main(int argc, char* argv[]) {
+    Canvas c(-1, -1, 620, 620, "Group Batch Cache", BLACK);
+    c.run(groupBatchFunction);
+}
@@ -0,0 +1,47 @@
+/*
+ * testLineSet.cpp
+ *
+ * Usage: ./testLineSet <numEdges>
+ */
+
+#include <tsgl.h>
+#include <cmath>
+#include <vector>
+
+using namespace tsgl;
+
+// A random graph of nodes on a circle; each frame a few edges are rewired and highlighted
+void lineSetFunction(Canvas& can, int edges) {
+    const int nodes = 2000;
+    std::vector<GLfloat> nodeX(nodes), nodeY(nodes);
+    for (int i = 0; i < nodes; i++) {
+        nodeX[i] = 280 * cos(2 * PI * i / nodes);
+        nodeY[i] = 280 * sin(2 * PI * i / nodes);
+    }
+    std::vector<GLfloat> endpoints(edges * 6);
+    for (int e = 0; e < edges; e++) {
+        int a = rand() % nodes, b = rand() % nodes;
+        GLfloat segment[6] = { nodeX[a], nodeY[a], 0, nodeX[b], nodeY[b], 0 };
+        std::copy(segment, segment + 6, &endpoints[e * 6]);
+    }
+    LineSet * graph = new LineSet(0, 0, 0, edges, endpoints.data(), 0, 0, 0, ColorFloat(0.3, 0.6, 1, 0.05));
+    can.add(graph);
+
+    while (can.isOpen()) {
+        can.sleep();
+        for (int k = 0; k < 50; k++) {
+            int e = rand() % edges, a = rand() % nodes, b = rand() % nodes;
+            graph->setSegment(e, nodeX[a], nodeY[a], 0, nodeX[b], nodeY[b], 0);
+            graph->setSegmentColor(e, ColorFloat(1, 0.5, 0, 0.6));
+        }
+    }
+
+    delete graph;
+}
+
+int main(int argc, char* argv[]) {
+    int edges = (argc > 1) ? atoi(argv[1]) : 100000;
+    if (edges <= 0) edges = 100000;
+    Canvas c(-1, -1, 1024, 620, "LineSet graph", BLACK);
+    c.run(lineSetFunction, edges);
+}
@@ -0,0 +1,58 @@
+/*
+ * testMesh.cpp
+ *
+ * Usage: ./testMesh <gridSize>
+ */
+
+#include <tsgl.h>
+#include <cmath>
+#include <vector>
+
+using namespace tsgl;
+
+// A square grid of terrain, a wave rolling across it one row at a time
+void meshFunction(Canvas& can, int n) {
+    const float size = 600, step = size / (n - 1);
+    std::vector<GLfloat> positions(n * n * 3);
+    std::vector<ColorFloat> colors(n * n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            int v = i * n + j;
+            positions[v*3] = j * step - size / 2;
+            positions[v*3 + 1] = i * step - size / 2;
+            positions[v*3 + 2] = 0;
+            colors[v] = ColorFloat((float)j / n, 0.5, (float)i / n, 1);
+        }
+    }
+    std::vector<GLuint> indices;
+    for (int i = 0; i + 1 < n; i++) {
+        for (int j = 0; j + 1 < n; j++) {
+            GLuint a = i * n + j, b = a + 1, c = a + n, d = c + 1;
+            indices.push_back(a); indices.push_back(b); indices.push_back(d);
+            indices.push_back(a); indices.push_back(d); indices.push_back(c);
+        }
+    }
+    Mesh * terrain = new Mesh(0, 0, 0, n * n, positions.data(), indices.size(), indices.data(), 0, -60, 0, colors.data());
+    can.add(terrain);
+
+    int frame = 0;
+    while (can.isOpen()) {
+        can.sleep();
+        // Only one row of vertices changes per frame, so only that row is uploaded
+        int row = frame % n;
+        for (int j = 0; j < n; j++)
+            positions[(row * n + j)*3 + 2] = 40 * sin(frame * 0.05f + j * 0.2f);
+        terrain->updateVertices(row * n, n, &positions[row * n * 3]);
+        terrain->changeYawBy(0.2);
+        frame++;
+    }
+
+    delete terrain;
+}
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : 200;
+    if (n < 2) n = 200;
+    Canvas c(-1, -1, 1024, 620, "Mesh with partial updates", BLACK);
+    c.run(meshFunction, n);
+}
@@ -0,0 +1,59 @@
+/*
+ * testParticles.cpp
+ *
+ * Usage: ./testParticles <fountainRate>
+ */
+
+#include <tsgl.h>
+
+using namespace tsgl;
+
+// A fountain emitting continuously, and fireworks bursting at random, all simulated by the render thread
+void particleFunction(Canvas& can, int rate) {
+    ParticleSystem * particles = new ParticleSystem(0, 0, 0, 500000, 0, 0, 0);
+    const float times[] = { 0, 0.3, 1 };
+    const ColorFloat colors[] = { ColorFloat(1, 1, 0.8, 1), ColorFloat(1, 0.5, 0, 0.9), ColorFloat(0.5, 0, 0, 0) };
+    particles->setColorRamp(times, colors, 3);
+    particles->setGravity(0, -150, 0);
+    particles->setDrag(0.5);
+
+    ParticleEmitter fountain;
+    fountain.y = -300;
+    fountain.rate = rate;
+    fountain.direction = 90;
+    fountain.spread = 10;
+    fountain.minSpeed = 350;
+    fountain.maxSpeed = 450;
+    fountain.minLife = 2;
+    fountain.maxLife = 3;
+    particles->addEmitter(fountain);
+
+    ParticleEmitter burst;
+    burst.minSpeed = 0;
+    burst.maxSpeed = 200;
+    burst.size = 3;
+    int fireworks = particles->addEmitter(burst);
+
+    particles->update(2);
+    can.add(particles);
+
+    while (can.isOpen()) {
+        can.sleep();
+        if (can.getFrameNumber() % 30 == 0) {
+            burst.x = saferand(-400, 400);
+            burst.y = saferand(0, 250);
+            particles->setEmitter(fireworks, burst);
+            particles->emit(fireworks, 5000);
+        }
+    }
+
+    can.remove(particles);
+    delete particles;
+}
+
+int main(int argc, char* argv[]) {
+    int rate = (argc > 1) ? atoi(argv[1]) : 50000;
+    if (rate <= 0) rate = 50000;
+    Canvas c(-1, -1, 1024, 620, "Particles", BLACK);
+    c.run(particleFunction, rate);
+}
@@ -0,0 +1,47 @@
+/*
+ * testPointCloud.cpp
+ *
+ * Usage: ./testPointCloud <numPoints>
+ */
+
+#include <tsgl.h>
+#include <cmath>
+#include <vector>
+
+using namespace tsgl;
+
+// A swirling disc of points, moved in parallel every frame in arrays the PointCloud reads directly
+void pointCloudFunction(Canvas& can, int n) {
+    std::vector<GLfloat> xs(n), ys(n), angles(n), radii(n), sizes(n);
+    std::vector<ColorFloat> colors(n);
+    for (int i = 0; i < n; i++) {
+        radii[i] = 300 * sqrt((float)rand() / RAND_MAX);
+        angles[i] = 2 * PI * rand() / RAND_MAX;
+        sizes[i] = 1 + 3 * (float)rand() / RAND_MAX;
+        colors[i] = ColorFloat(radii[i] / 300, 0.5, 1 - radii[i] / 300, 1);
+    }
+    PointCloud * cloud = new PointCloud(0, 0, 0, n, xs.data(), ys.data(), NULL, 0, 0, 0, WHITE);
+    cloud->setColors(colors.data());
+    cloud->setSizes(sizes.data());
+    can.add(cloud);
+
+    while (can.isOpen()) {
+        can.sleep();
+        #pragma omp parallel for
+        for (int i = 0; i < n; i++) {
+            angles[i] += 0.5f / (radii[i] + 10);
+            xs[i] = radii[i] * cos(angles[i]);
+            ys[i] = radii[i] * sin(angles[i]);
+        }
+        cloud->update();
+    }
+
+    delete cloud;
+}
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+    if (n <= 0) n = 1000000;
+    Canvas c(-1, -1, 1024, 620, "PointCloud", BLACK);
+    c.run(pointCloudFunction, n);
+}
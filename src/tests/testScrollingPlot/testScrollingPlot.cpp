@@ -0,0 +1,46 @@
+/*
+ * testScrollingPlot.cpp
+ *
+ * Usage: ./testScrollingPlot <numThreads>
+ */
+
+#include <tsgl.h>
+#include <cmath>
+#include <omp.h>
+
+using namespace tsgl;
+
+// Each thread streams a noisy sine wave into its own plot, far faster than the plots have columns
+void scrollingPlotFunction(Canvas& can, int threads) {
+    const int window = 200000, chunk = 1000;
+    float height = 560.0f / threads;
+    ScrollingPlot ** plots = new ScrollingPlot*[threads];
+    for (int t = 0; t < threads; t++) {
+        plots[t] = new ScrollingPlot(0, 280 - height * (t + 0.5f), 0, 960, height - 10, window, -1.5, 1.5, 0, 0, 0, Colors::highContrastColor(t));
+        can.add(plots[t]);
+    }
+
+    #pragma omp parallel num_threads(threads)
+    {
+        int t = omp_get_thread_num();
+        float samples[chunk];
+        long long n = 0;
+        while (can.isOpen()) {
+            for (int i = 0; i < chunk; i++, n++)
+                samples[i] = sin(n * 0.0005 * (t + 1)) + ((rand() % 1000) / 1000.0f - 0.5f) * 0.3f;
+            plots[t]->append(samples, chunk);
+            can.sleepFor(0.001);
+        }
+    }
+
+    for (int t = 0; t < threads; t++)
+        delete plots[t];
+    delete [] plots;
+}
+
+int main(int argc, char* argv[]) {
+    int threads = (argc > 1) ? atoi(argv[1]) : 4;
+    if (threads <= 0) threads = 4;
+    Canvas c(-1, -1, 1024, 620, "Scrolling plots", BLACK);
+    c.run(scrollingPlotFunction, threads);
+}
@@ -0,0 +1,50 @@
+/*
+ * testStoreMeshes.cpp
+ *
+ * Usage: ./testStoreMeshes
+ */
+
+#include <tsgl.h>
+
+using namespace tsgl;
+
+// Adds a mesh with a row of instances to a DrawableStore that is already being drawn
+int addRow(DrawableStore * store, int numVertices, const GLfloat positions[], float y, ColorFloat color) {
+    int mesh = store->addMesh(numVertices, positions);
+    for (int i = 0; i < 10; i++)
+        store->add(mesh, -450 + 100 * i, y, 0, color);
+    return mesh;
+}
+
+// Adds meshes one by one after the store is first drawn. The mesh buffer on the GPU grows geometrically, so the
+// last mesh fits in the room left by the previous growth; every row must still show its own shape.
+void storeMeshesFunction(Canvas& can) {
+    const GLfloat triangle[] = { -30, -25, 0,   30, -25, 0,   0, 35, 0 };
+    const GLfloat square[] = { -25, -25, 0,   25, -25, 0,   25, 25, 0,   -25, -25, 0,   25, 25, 0,   -25, 25, 0 };
+    const GLfloat arrow[] = { -30, 0, 0,   30, 15, 0,   30, -15, 0 };
+    const GLfloat spike[] = { -5, -35, 0,   5, -35, 0,   0, 35, 0 };
+    DrawableStore * store = new DrawableStore(0, 0, 0, 0, 0, 0);
+    addRow(store, 3, triangle, 225, RED);
+    can.add(store);
+
+    const GLfloat * shapes[] = { square, arrow, spike };
+    const int counts[] = { 6, 3, 3 };
+    const ColorFloat colors[] = { GREEN, BLUE, YELLOW };
+    for (int row = 0; row < 3 && can.isOpen(); row++) {
+        for (int f = 0; f < 30 && can.isOpen(); f++)
+            can.sleep();
+        addRow(store, counts[row], shapes[row], 75 - 150 * row, colors[row]);
+    }
+    std::cout << "Rows, top to bottom: red triangles, green squares, blue arrows, yellow spikes" << std::endl;
+
+    while (can.isOpen())
+        can.sleep();
+
+    can.remove(store);
+    delete store;
+}
+
+int main(int argc, char* argv[]) {
+    Canvas c(-1, -1, 1024, 620, "DrawableStore meshes added while drawing", BLACK);
+    c.run(storeMeshesFunction);
+}
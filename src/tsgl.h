@@ -9,6 +9,7 @@
 	#define _CRT_SECURE_NO_DEPRECATE //To avoid issues with fopen, http://stackoverflow.com/questions/14386/fopen-deprecated-warning
 #endif
 
+#include <TSGL/Actor.h>
 #include <TSGL/Canvas.h>
 #include <TSGL/CartesianCanvas.h>
 #include <TSGL/Color.h>